@@ -30,6 +30,7 @@ enum class CommandType {
   PRINT_MEMORY,
   GET_MEMORY_POINT,
   DUMP_CACHE,
+  DUMP_PROFILE,
   ADD_BREAKPOINT,
   REMOVE_BREAKPOINT,
   VM_STDIN,
@@ -7,6 +7,10 @@
 #define CONFIG_H
 
 #include "globals.h"
+#include "vm/cache/cache.h"
+#include "vm/branch_predictor.h"
+#include "vm/fu_latency.h"
+#include "vm/pipeline_trace.h"
 #include <string>
 #include <iostream>
 #include <stdexcept>
@@ -14,6 +18,7 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <optional>
 
 /**
  * @namespace vm_config
@@ -29,7 +34,7 @@ struct VmConfig {
   VmTypes vm_type = VmTypes::SINGLE_STAGE;
   uint64_t run_step_delay = 300;
   uint64_t memory_size = 0xffffffffffffffff; // 64-bit address space
-  uint64_t memory_block_size = 1024; // 1 KB blocks
+  uint64_t memory_block_size = 4096; // guest page size, 4 KB or 64 KB
   uint64_t data_section_start = 0x10000000; // Default start address for data section
   uint64_t text_section_start = 0x0; // Default start address for text section
   uint64_t bss_section_start = 0x11000000; // Default start address for BSS section
@@ -51,6 +56,26 @@ struct VmConfig {
 
   bool branch_prediction_enabled = false;
   bool branch_prediction_static = false;
+  branch_predictor::BranchPredictorConfig branch_predictor_config; // what dynamic prediction uses, [BranchPrediction]
+  fu_latency::LatencyConfig latency_config; // functional unit latencies and intervals, [Latency]
+  pipeline_trace::TraceConfig trace_config; // per instruction stage trace, [Trace]
+
+  // out of order window of the dual/triple issue models, applied when the model is loaded
+  size_t reservation_station_size = 4; // entries per reservation station
+  size_t rob_size = 0; // 0 keeps the model's default: 16 for dual issue, 32 for triple issue
+  size_t cdb_width = 0; // results the common data bus carries per cycle, 0 for unlimited
+  size_t load_queue_size = 0; // 0 keeps the model's default: 8 for dual issue, 12 for triple issue
+  size_t store_queue_size = 0; // same
+  // shape of the out of order core, unset keeps the model's preset (dual: 2 wide, 1 ALU + 1 LSU; triple: 3 wide,
+  // 1 ALU + 1 FPU + 1 LSU)
+  size_t issue_width = 0; // fetch, decode and issue width, 0 for the preset
+  size_t commit_width = 0; // retired per cycle, 0 for the issue width
+  std::optional<size_t> alu_units;
+  std::optional<size_t> fpu_units; // 0 runs floating point on the ALUs
+  std::optional<size_t> lsu_units;
+
+  cache::CacheConfig icache_config{.cache_type = cache::CacheType::Instruction};
+  cache::CacheConfig dcache_config{.cache_type = cache::CacheType::Data};
 
   void setVmType(const VmTypes &type) {
     vm_type = type;
@@ -73,6 +98,9 @@ struct VmConfig {
     return memory_size;
   }
   void setMemoryBlockSize(uint64_t size) {
+    if (size != 4096 && size != 65536) {
+      throw std::invalid_argument("Memory block size must be 4096 or 65536: " + std::to_string(size));
+    }
     memory_block_size = size;
   }
   uint64_t getMemoryBlockSize() const {
@@ -157,6 +185,15 @@ struct VmConfig {
     return {branch_prediction_enabled, branch_prediction_static};
   }
 
+  // the [BranchPrediction] config, with the static rule as direction predictor when static prediction is selected
+  branch_predictor::BranchPredictorConfig getBranchPredictorConfig() const {
+    branch_predictor::BranchPredictorConfig predictor_config = branch_predictor_config;
+    if (branch_prediction_static) {
+      predictor_config.type = branch_predictor::PredictorType::Static;
+    }
+    return predictor_config;
+  }
+
   void setMaxUndoStackSize(size_t size){
     max_undo_stack_size = size;
   }
@@ -165,6 +202,206 @@ struct VmConfig {
     return max_undo_stack_size;
   }
 
+  void setReservationStationSize(size_t size) {
+    if (size == 0) {
+      throw std::invalid_argument("Reservation station size must be at least 1: " + std::to_string(size));
+    }
+    reservation_station_size = size;
+  }
+
+  size_t getReservationStationSize() const {
+    return reservation_station_size;
+  }
+
+  // the ROB keeps one slot free to tell full from empty, so it needs two to hold anything
+  void setRobSize(size_t size) {
+    if (size == 1) {
+      throw std::invalid_argument("ROB size must be 0 (model default) or at least 2: " + std::to_string(size));
+    }
+    rob_size = size;
+  }
+
+  size_t getRobSize(size_t model_default) const {
+    return rob_size == 0 ? model_default : rob_size;
+  }
+
+  void setLoadQueueSize(size_t size) {
+    load_queue_size = size;
+  }
+
+  size_t getLoadQueueSize(size_t model_default) const {
+    return load_queue_size == 0 ? model_default : load_queue_size;
+  }
+
+  void setStoreQueueSize(size_t size) {
+    store_queue_size = size;
+  }
+
+  size_t getStoreQueueSize(size_t model_default) const {
+    return store_queue_size == 0 ? model_default : store_queue_size;
+  }
+
+  void setCdbWidth(size_t width) {
+    cdb_width = width;
+  }
+
+  size_t getCdbWidth() const {
+    return cdb_width;
+  }
+
+  void setIssueWidth(size_t width) {
+    issue_width = width;
+  }
+
+  size_t getIssueWidth(size_t model_default) const {
+    return issue_width == 0 ? model_default : issue_width;
+  }
+
+  void setCommitWidth(size_t width) {
+    commit_width = width;
+  }
+
+  size_t getCommitWidth(size_t issue_default) const {
+    return commit_width == 0 ? issue_default : commit_width;
+  }
+
+  // the core needs an ALU and an LSU, an FPU is optional
+  void setAluUnits(size_t units) {
+    if (units == 0) {
+      throw std::invalid_argument("The core needs at least 1 ALU: " + std::to_string(units));
+    }
+    alu_units = units;
+  }
+
+  size_t getAluUnits(size_t model_default) const {
+    return alu_units.value_or(model_default);
+  }
+
+  void setFpuUnits(size_t units) {
+    fpu_units = units;
+  }
+
+  size_t getFpuUnits(size_t model_default) const {
+    return fpu_units.value_or(model_default);
+  }
+
+  void setLsuUnits(size_t units) {
+    if (units == 0) {
+      throw std::invalid_argument("The core needs at least 1 LSU: " + std::to_string(units));
+    }
+    lsu_units = units;
+  }
+
+  size_t getLsuUnits(size_t model_default) const {
+    return lsu_units.value_or(model_default);
+  }
+
+  /**
+   * @brief Applies a [Cache] key. Keys prefixed with icache_/dcache_ change one cache, cache_ changes both.
+   */
+  void modifyCacheConfig(const std::string &key, const std::string &value) {
+    std::vector<cache::CacheConfig*> targets;
+    std::string field;
+    if (key.rfind("icache_", 0) == 0) {
+      targets = {&icache_config};
+      field = key.substr(7);
+    } else if (key.rfind("dcache_", 0) == 0) {
+      targets = {&dcache_config};
+      field = key.substr(7);
+    } else if (key.rfind("cache_", 0) == 0) {
+      targets = {&icache_config, &dcache_config};
+      field = key.substr(6);
+    } else {
+      throw std::invalid_argument("Unknown key: " + key);
+    }
+
+    auto parse_bool = [&](const std::string &v) {
+      if (v == "true") return true;
+      if (v == "false") return false;
+      throw std::invalid_argument("Unknown value: " + v);
+    };
+
+    for (cache::CacheConfig *target : targets) {
+      cache::CacheConfig &c = *target;
+      if (field == "enabled") {
+        c.enabled = parse_bool(value);
+      } else if (field == "size") {
+        c.size = std::stoul(value);
+      } else if (field == "block_size") {
+        c.block_size = std::stoul(value);
+      } else if (field == "associativity") {
+        c.associativity = std::stoul(value);
+      } else if (field == "hit_latency") {
+        c.hit_latency = static_cast<unsigned int>(std::stoul(value));
+      } else if (field == "miss_latency") {
+        c.miss_latency = static_cast<unsigned int>(std::stoul(value));
+      } else if (field == "replacement_policy") {
+        if (value == "LRU") {
+          c.replacement_policy = cache::ReplacementPolicy::LRU;
+        } else if (value == "FIFO") {
+          c.replacement_policy = cache::ReplacementPolicy::FIFO;
+        } else if (value == "Random" || value == "RANDOM") {
+          c.replacement_policy = cache::ReplacementPolicy::Random;
+        } else {
+          throw std::invalid_argument("Unknown value: " + value);
+        }
+      } else if (field == "write_hit_policy") {
+        if (value == "write_back") {
+          c.write_hit_policy = cache::WriteHitPolicy::WriteBack;
+        } else if (value == "write_through") {
+          c.write_hit_policy = cache::WriteHitPolicy::WriteThrough;
+        } else {
+          throw std::invalid_argument("Unknown value: " + value);
+        }
+      } else if (field == "write_miss_policy") {
+        if (value == "write_allocate") {
+          c.write_miss_policy = cache::WriteMissPolicy::WriteAllocate;
+        } else if (value == "no_write_allocate") {
+          c.write_miss_policy = cache::WriteMissPolicy::NoWriteAllocate;
+        } else {
+          throw std::invalid_argument("Unknown value: " + value);
+        }
+      } else if (field == "read_miss_policy") {
+        // reads always allocate
+        if (value != "read_allocate") {
+          throw std::invalid_argument("Unknown value: " + value);
+        }
+      } else {
+        throw std::invalid_argument("Unknown key: " + key);
+      }
+    }
+  }
+
+  /**
+   * @brief Applies a [BranchPrediction] key. Table sizes of 0 keep the current size.
+   */
+  void modifyBranchPredictionConfig(const std::string &key, const std::string &value) {
+    branch_predictor::BranchPredictorConfig &c = branch_predictor_config;
+    if (key == "branch_prediction_type") {
+      if (value == "bimodal") {
+        c.type = branch_predictor::PredictorType::Bimodal;
+      } else if (value == "gshare") {
+        c.type = branch_predictor::PredictorType::Gshare;
+      } else if (value == "tournament") {
+        c.type = branch_predictor::PredictorType::Tournament;
+      } else {
+        throw std::invalid_argument("Unknown value: " + value);
+      }
+    } else if (key == "branch_prediction_table_size") {
+      if (size_t size = std::stoul(value)) c.btb_size = size;
+    } else if (key == "branch_prediction_table_associativity") {
+      if (size_t associativity = std::stoul(value)) c.btb_associativity = associativity;
+    } else if (key == "branch_prediction_counter_table_size") {
+      if (size_t size = std::stoul(value)) c.counter_table_size = size;
+    } else if (key == "branch_prediction_history_bits") {
+      c.history_bits = static_cast<unsigned int>(std::stoul(value));
+    } else if (key == "branch_prediction_ras_size") {
+      c.ras_size = std::stoul(value);
+    } else {
+      throw std::invalid_argument("Unknown key: " + key);
+    }
+  }
+
   void modifyConfig(const std::string &section, const std::string &key, const std::string &value) {
     if (section == "Execution") {
       if (key == "processor_type") {
@@ -227,6 +464,36 @@ struct VmConfig {
         this->branch_prediction_enabled = false;
         this->branch_prediction_static = false;
       }
+      else if(key == "reservation_station_size"){
+        setReservationStationSize(std::stoul(value));
+      }
+      else if(key == "rob_size"){
+        setRobSize(std::stoul(value));
+      }
+      else if(key == "load_queue_size"){
+        setLoadQueueSize(std::stoul(value));
+      }
+      else if(key == "store_queue_size"){
+        setStoreQueueSize(std::stoul(value));
+      }
+      else if(key == "cdb_width"){
+        setCdbWidth(std::stoul(value));
+      }
+      else if(key == "issue_width"){
+        setIssueWidth(std::stoul(value));
+      }
+      else if(key == "commit_width"){
+        setCommitWidth(std::stoul(value));
+      }
+      else if(key == "alu_units"){
+        setAluUnits(std::stoul(value));
+      }
+      else if(key == "fpu_units"){
+        setFpuUnits(std::stoul(value));
+      }
+      else if(key == "lsu_units"){
+        setLsuUnits(std::stoul(value));
+      }
       else {
         throw std::invalid_argument("Unknown key: " + key);
       }
@@ -277,6 +544,18 @@ struct VmConfig {
         }
       }
     }
+    else if (section == "Cache") {
+      modifyCacheConfig(key, value);
+    }
+    else if (section == "BranchPrediction") {
+      modifyBranchPredictionConfig(key, value);
+    }
+    else if (section == "Latency") {
+      latency_config.Modify(key, value);
+    }
+    else if (section == "Trace") {
+      trace_config.Modify(key, value);
+    }
     else {
       throw std::invalid_argument("Unknown section: " + section);
     }
@@ -287,6 +566,14 @@ struct VmConfig {
 
 extern VmConfig config;
 
+/**
+ * @brief Reads an ini file and applies every key through config.modifyConfig().
+ *
+ * Missing files are ignored. Keys that modifyConfig() rejects are reported on std::cerr and skipped.
+ * @param path Path to the ini file.
+ */
+void LoadConfigFile(const std::filesystem::path &path);
+
 
 } // namespace vm_config
 
@@ -20,6 +20,8 @@ extern std::filesystem::path errors_dump_file_path;
 extern std::filesystem::path registers_dump_file_path;
 extern std::filesystem::path memory_dump_file_path;
 extern std::filesystem::path cache_dump_file_path;
+extern std::filesystem::path profile_dump_file_path;
+extern std::filesystem::path trace_file_path;
 extern std::filesystem::path vm_state_dump_file_path;
 //extern std::string output_file;
 extern std::filesystem::path vm_cout_file_path;
@@ -14,6 +14,7 @@
 
 #include "globals.h"
 #include "vm/vm_main.h"
+#include "vm/sim_worker.h"
 
 extern ImFont* STANDARD_EXTRA_SMALL_FONT;
 extern ImFont* STANDARD_SMALL_FONT;
@@ -32,6 +33,9 @@ extern bool in_memory;
 extern bool show_gpr;
 extern bool show_fpr;
 
-extern VM vm;
+// The VM lives on the worker thread. Windows read it through vm_snapshot, which gui_main() points at the front
+// snapshot (and keeps locked) while a frame is being built, and change it by posting commands to vm_worker.
+extern sim_worker::SimWorker vm_worker;
+extern sim_worker::SimSnapshot* vm_snapshot;
 
 void LoadFonts(ImGuiIO& io);
\ No newline at end of file
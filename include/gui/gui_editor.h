@@ -80,6 +80,8 @@ public:
 		ImU32 DebugTextColor = ImGui::ColorConvertFloat4ToU32({0.0f, 0.0f, 0.0f, 1.0f});
 	};
 	DebugLines mDebugLines;
+	std::vector<float> mHeatMap; ///< see SetHeatMap()
+	float mHeatMapMax = 0.0f;
 
 	// Represents a character coordinate from the user's point of view,
 	// i. e. consider an uniform grid (assuming fixed-width font) on the
@@ -237,6 +239,8 @@ public:
 	void SetDebugMode(bool aValue);
 	void SetDebugModeTypeSingleCycle(bool singleCycle);
 	void SetDebugLines(size_t aIfLine, size_t aIdLine, size_t aExLine, size_t aMemLine, size_t aWbLine);
+	// share of the cycles of each line (0-based), drawn as a heat-map gutter in debug mode. Empty for none
+	void SetHeatMap(std::vector<float> aCycleShares);
 
 	bool IsColorizerEnabled() const { return mColorizerEnabled; }
 	void SetColorizerEnable(bool aValue);
@@ -11,6 +11,7 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 #include <algorithm>
 #include <vector>
+#include <optional>
 
 #include "../../include/gui/gui_processor_window.h"
 #include "../../include/gui/gui_editor.h"
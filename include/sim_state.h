@@ -1,7 +1,6 @@
 #pragma once
 
 struct SimState{
-    bool MEMORY_DIRTY = false;
     bool DATA_FORWARD = false;
     bool HAZARD_DETECTED = false;
     bool LIT_UP = false;
@@ -13,7 +12,7 @@ struct SimState{
         EXEC_MEM_RS2
     };
     DataForwardPaths DF_PATH;
-    bool DF_ALL;
+    bool DF_ALL = false;
 
     enum class HazardPaths{
         MEM_WB,
@@ -22,5 +21,3 @@ struct SimState{
     HazardPaths HZ_PATH;
 };
 
-
-extern SimState SimState_;
\ No newline at end of file
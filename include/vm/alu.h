@@ -24,7 +24,7 @@
 
 namespace alu {
 
-enum class AluOp {
+enum class AluOp : uint8_t {
     kNone, ///< No operation.
     kAdd, ///< Addition operation.
     kAddw, ///< Addition word operation.
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace branch_predictor {
+
+/**
+ * @brief Direction predictor used for conditional branches.
+ */
+enum class PredictorType {
+    Static,     ///< backward taken, forward not taken
+    Bimodal,    ///< 2 bit counters indexed by pc
+    Gshare,     ///< 2 bit counters indexed by pc xor the global history
+    Tournament, ///< bimodal and gshare, a table of 2 bit counters chooses between them per pc
+};
+
+/**
+ * @brief The part of the predictor a prediction came from, mispredicts are accounted to it.
+ */
+enum class PredictorComponent : uint8_t {
+    None,    ///< prediction off, or not a control transfer
+    Static,
+    Bimodal,
+    Gshare,
+    Btb,     ///< jal/jalr targets, and taken directions the BTB had no target for
+    Ras,
+};
+
+struct BranchPredictorConfig {
+    PredictorType type = PredictorType::Bimodal;
+    size_t btb_size = 256;            ///< entries, power of two
+    size_t btb_associativity = 1;     ///< power of two, at most btb_size
+    size_t counter_table_size = 1024; ///< entries of each 2 bit counter table, power of two
+    unsigned int history_bits = 10;   ///< global history length (gshare), at most 32
+    size_t ras_size = 8;              ///< return address stack entries, 0 disables it
+};
+
+/**
+ * @brief branch_mispredicts split by the component that made the wrong call.
+ */
+struct MispredictBreakdown {
+    size_t unpredicted = 0;
+    size_t static_rule = 0;
+    size_t bimodal = 0;
+    size_t gshare = 0;
+    size_t btb = 0;
+    size_t ras = 0;
+
+    void Count(PredictorComponent component);
+};
+
+/**
+ * @brief What Predict() decided for one instruction. Carried in its instruction context until it resolves, since
+ * training and recovery need the state the prediction was made with.
+ */
+struct BranchPrediction {
+    bool taken = false;
+    uint64_t target = 0; ///< next pc, pc + 4 when not taken
+    PredictorComponent component = PredictorComponent::None;
+
+    uint32_t history = 0;       ///< global history the counters were read with
+    bool bimodal_taken = false; ///< what each side said, trains the tournament chooser
+    bool gshare_taken = false;
+
+    uint32_t ras_top = 0; ///< return address stack before this instruction pushed or popped
+    uint32_t ras_depth = 0;
+};
+
+/**
+ * @brief Branch predictor shared by the pipelined, dual issue and triple issue cores.
+ *
+ * Predict() is called at fetch with the instruction word, enough to tell branches, jal and jalr apart and to find
+ * calls and returns (rd/rs1 being x1 or x5) for the return address stack. Update() trains the tables with the
+ * resolved outcome of every control transfer, Recover() rolls the return address stack back after a mispredict
+ * flushed the younger instructions.
+ *
+ * Counters and the global history are only written by Update(), so they see resolved outcomes only. The return
+ * address stack is updated speculatively at fetch, each prediction checkpoints its top so it can be restored.
+ */
+class BranchPredictor {
+public:
+    BranchPredictor();
+
+    /**
+     * @brief Rebuilds the tables for config, all entries start invalid / weakly not taken.
+     * @throws std::invalid_argument If a table size is not a power of two or the history is too long.
+     */
+    void Configure(const BranchPredictorConfig& config);
+
+    const BranchPredictorConfig& GetConfig() const { return config_; }
+
+    BranchPrediction Predict(uint64_t pc, uint32_t instruction);
+
+    void Update(uint64_t pc, uint32_t instruction, bool taken, uint64_t target, const BranchPrediction& prediction);
+
+    /**
+     * @brief Undoes the return address stack changes of everything fetched after the instruction prediction belongs
+     * to, keeping its own push/pop.
+     */
+    void Recover(uint64_t pc, uint32_t instruction, const BranchPrediction& prediction);
+
+    /**
+     * @brief Undoes the return address stack changes of the instruction itself as well, for an instruction that
+     * will be fetched (and predicted) again.
+     */
+    void Restore(const BranchPrediction& prediction);
+
+    void Reset();
+
+private:
+    struct BTBEntry {
+        bool valid = false;
+        uint64_t tag = 0; ///< full pc
+        uint64_t target_address = 0;
+        uint64_t last_used = 0;
+    };
+
+    BranchPredictorConfig config_;
+
+    std::vector<BTBEntry> btb_; ///< btb_size/btb_associativity sets, one after the other
+    size_t btb_sets_ = 0;
+    uint64_t btb_access_counter_ = 0;
+
+    std::vector<uint8_t> bimodal_;
+    std::vector<uint8_t> gshare_;
+    std::vector<uint8_t> chooser_; ///< >= 2 picks gshare
+    uint32_t history_ = 0;
+    uint32_t history_mask_ = 0;
+
+    std::vector<uint64_t> ras_;
+    uint32_t ras_top_ = 0; ///< next slot to push to
+    uint32_t ras_depth_ = 0;
+
+    size_t CounterIndex(uint64_t pc) const;
+    size_t GshareIndex(uint64_t pc, uint32_t history) const;
+
+    BTBEntry* LookupBtb(uint64_t pc);
+    void InsertBtb(uint64_t pc, uint64_t target);
+
+    bool PredictDirection(uint64_t pc, uint64_t target, BranchPrediction& prediction);
+
+    /**
+     * @brief Pushes/pops the return address stack for a jal/jalr. Returns true and sets return_address when it
+     * popped an entry.
+     */
+    bool ApplyRas(uint64_t pc, uint32_t instruction, uint64_t& return_address);
+};
+
+} // namespace branch_predictor
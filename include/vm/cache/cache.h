@@ -8,6 +8,9 @@
 
 #include <cstdint>
 #include <vector>
+#include <random>
+#include <ostream>
+#include <string>
 
 namespace cache {
 
@@ -39,29 +42,47 @@ enum class WriteMissPolicy {
 };
 
 struct CacheConfig {
-  unsigned long lines = 0;  ///< Number of lines in the cache
-  unsigned long associativity = 0; ///< Associativity of the cache
-  unsigned long words_per_line = 0; ///< Number of words per line in the cache
+  bool enabled = false; ///< A disabled cache does not count accesses and adds no latency
+  unsigned long size = 16384;  ///< Size of the cache in bytes
+  unsigned long block_size = 64; ///< Size of a line in bytes
+  unsigned long associativity = 4; ///< Associativity of the cache
   ReplacementPolicy replacement_policy = ReplacementPolicy::LRU; ///< Replacement policy for the cache
   CacheType cache_type = CacheType::Data; ///< Type of cache (instruction or data)
   WriteHitPolicy write_hit_policy = WriteHitPolicy::WriteBack; ///< Write hit policy
-  WriteMissPolicy write_miss_policy = WriteMissPolicy::NoWriteAllocate; ///< Write miss policy
-  unsigned long size = 0;   ///< Size of the cache in bytes
+  WriteMissPolicy write_miss_policy = WriteMissPolicy::WriteAllocate; ///< Write miss policy
+  unsigned int hit_latency = 1;   ///< Cycles taken by a hit
+  unsigned int miss_latency = 20; ///< Cycles taken by a miss (line fill from memory)
+
+  /**
+   * @brief Number of sets the geometry gives.
+   */
+  unsigned long Sets() const {
+    return size/(block_size*associativity);
+  }
 };
 
+/**
+ * @brief A cache line only tracks its tag and state, the data itself always lives in Memory.
+ */
 struct CacheLine {
   CacheLineState state = CacheLineState::Invalid; ///< State of the cache line
-  unsigned long tag = 0;    ///< Tag for the cache line
-  std::vector<uint8_t> data; ///< Data stored in the cache line
-  
+  uint64_t tag = 0;    ///< Tag for the cache line
+  uint64_t last_used = 0; ///< Access counter value of the last touch (LRU)
+  uint64_t filled_at = 0; ///< Access counter value when the line was filled (FIFO)
 };
 
 struct CacheStats {
-  unsigned long accesses; ///< Total number of accesses to the cache
-  unsigned long hits;     ///< Total number of hits in the cache
-  unsigned long misses;   ///< Total number of misses in the cache
-
-
+  uint64_t accesses = 0; ///< Total number of accesses to the cache
+  uint64_t hits = 0;     ///< Total number of hits in the cache
+  uint64_t misses = 0;   ///< Total number of misses in the cache
+  uint64_t reads = 0;    ///< Read accesses
+  uint64_t writes = 0;   ///< Write accesses
+  uint64_t evictions = 0; ///< Valid lines replaced on a fill
+  uint64_t writebacks = 0; ///< Dirty lines written back to memory on eviction
+
+  double HitRate() const {
+    return accesses ? static_cast<double>(hits)/static_cast<double>(accesses) : 0.0;
+  }
 };
 
 struct CacheSet {
@@ -72,19 +93,75 @@ struct CacheSet {
     : associativity(assoc), lines(assoc) {}
 };
 
+/**
+ * @brief Set associative cache timing model.
+ *
+ * Access() looks the address up, updates the replacement state and the stats, and returns the latency of the access.
+ */
 class Cache {
-  bool enabled; ///< Flag to indicate if the cache is enabled
-  CacheType type; ///< Type of cache (instruction or data)
-  CacheConfig config; ///< Configuration of the cache
-  CacheStats stats; ///< Statistics for the cache
-
-
+ public:
+  Cache() = default;
+
+  /**
+   * @brief Rebuilds the cache for the given configuration, all lines start invalid.
+   * @throws std::invalid_argument If the geometry is not made of powers of two or does not fit.
+   */
+  void Configure(const CacheConfig &config);
+
+  /**
+   * @brief Invalidates every line and clears the stats.
+   */
+  void Reset();
+
+  bool Enabled() const {
+    return config_.enabled;
+  }
+
+  /**
+   * @brief Performs an access.
+   * @param address Address being accessed.
+   * @param is_write True for a store.
+   * @return Latency of the access in cycles, 0 if the cache is disabled.
+   */
+  unsigned int Access(uint64_t address, bool is_write);
+
+  const CacheStats &GetStats() const {
+    return stats_;
+  }
+
+  const CacheConfig &GetConfig() const {
+    return config_;
+  }
+
+  /**
+   * @brief Prints the configuration, stats and valid lines in a human readable form.
+   */
+  void PrintStatus(std::ostream &os) const;
+
+  /**
+   * @brief Writes the configuration and stats as a JSON object.
+   * @param indent Indentation of the object's members.
+   */
+  void DumpJson(std::ostream &os, const std::string &indent) const;
+
+ private:
+  CacheConfig config_; ///< Configuration of the cache
+  CacheStats stats_; ///< Statistics for the cache
+  std::vector<CacheSet> sets_;
+  unsigned int offset_bits_ = 0;
+  unsigned int index_bits_ = 0;
+  uint64_t access_counter_ = 0; ///< Logical clock for LRU/FIFO
+  std::mt19937 rng_{0}; ///< Fixed seed so Random replacement is reproducible
+
+  CacheLine &ChooseVictim(CacheSet &set);
 };
 
-
+const char *ToString(ReplacementPolicy policy);
+const char *ToString(WriteHitPolicy policy);
+const char *ToString(WriteMissPolicy policy);
 
 } // namespace cache
 
 
 
-#endif // CACHE_H
\ No newline at end of file
+#endif // CACHE_H
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "vm/registers.h"
+#include "vm/memory_controller.h"
+#include "vm/alu.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace fast_forward {
+
+struct FastForwardState;
+struct FastForwardOp;
+
+/**
+ * @brief Executes one op. Returns the next op of the block, or nullptr once control leaves the block, in which
+ * case FastForwardState::pc and FastForwardState::exit_op have been set.
+ */
+using OpHandler = const FastForwardOp* (*)(const FastForwardOp* op, FastForwardState& state);
+
+/**
+ * @brief One predecoded instruction of a basic block. Everything that can be worked out from the instruction word
+ * and its pc (immediates, branch targets, lui/auipc results) is computed when the block is built.
+ */
+struct FastForwardOp {
+    OpHandler handler = nullptr;
+    uint64_t pc = 0;
+    uint64_t imm = 0; ///< sign extended immediate, branch/jump target or constant result
+
+    alu::AluOp alu_op = alu::AluOp::kNone;
+    uint8_t opcode = 0;
+    uint8_t funct3 = 0;
+    uint8_t funct7 = 0;
+    uint8_t rd = 0; ///< writes to x0 are redirected to a scratch register
+    uint8_t rs1 = 0;
+    uint8_t rs2 = 0;
+    uint8_t rs3 = 0;
+    uint8_t mem_access_bytes = 0;
+
+    bool imm_to_alu = false;
+    bool mem_read = false;
+    bool mem_write = false;
+    bool mem_to_reg = false;
+    bool mem_write_data_from_gpr = false;
+    bool sign_extend = false;
+    bool reg_write = false;
+    bool reg_write_to_fpr = false;
+    bool rs1_from_fprf = false;
+    bool is_float = false;
+    bool is_double = false;
+    bool ends_block = false; ///< branches, jumps and ecall
+
+    uint16_t csr_rd = 0;
+    uint32_t retired = 0; ///< instructions of the block retired if the block is left right after this op
+};
+
+/**
+ * @brief Architectural state the handlers work on. The gprs and fprs are copied out of the RegisterFile for the
+ * duration of a run, csrs stay in the RegisterFile.
+ */
+struct FastForwardState {
+    static constexpr size_t kScratchGpr = 32;
+
+    std::array<uint64_t, 33> gpr = {}; ///< gpr[kScratchGpr] absorbs writes to x0
+    std::array<uint64_t, 32> fpr = {};
+    uint64_t pc = 0;
+
+    register_file::RegisterFile* register_file = nullptr;
+    memory_controller::MemoryController* memory_controller = nullptr;
+    uint64_t text_size = 0;
+    std::ostream* log = nullptr;
+
+    const FastForwardOp* exit_op = nullptr;
+};
+
+/**
+ * @brief Functional RV64 interpreter used to fast forward the core models.
+ *
+ * Runs straight off a RegisterFile and MemoryController (bypassing the caches), one basic block at a time: a block
+ * is decoded once, with the single cycle decode unit so the semantics are the same as the detailed models, into an
+ * array of ops that each point at their handler. No instruction contexts are built and nothing is logged while
+ * running. Blocks are dropped whenever the text section is written.
+ */
+class FastForwardEngine {
+public:
+    /**
+     * @brief Runs until pc leaves the text section, num_instrs instructions have retired or stop_requested is set.
+     * @param pc The pc to start from, updated to the pc of the next instruction.
+     * @param retired_at If given (sized to the text section in words), counts the retirements of each instruction.
+     * @return The number of instructions retired.
+     */
+    uint64_t Run(uint64_t& pc, uint64_t num_instrs, uint64_t text_size, register_file::RegisterFile& register_file,
+                 memory_controller::MemoryController& memory_controller, const std::atomic<bool>& stop_requested,
+                 std::vector<uint64_t>* retired_at = nullptr);
+
+    /**
+     * @brief Drops every block.
+     */
+    void Reset();
+
+    /**
+     * @brief Where ecall messages go, globals::vm_cout_file unless the owning core was given its own log.
+     */
+    void SetLog(std::ostream& log) { log_ = &log; }
+
+private:
+    static constexpr size_t kMaxBlockLength = 64;
+
+    std::ostream* log_ = &globals::vm_cout_file;
+
+    struct Block {
+        std::vector<FastForwardOp> ops;
+        uint32_t length = 0; ///< instructions in the block (the trailing fall through op is not one)
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<uint32_t> block_at_; ///< index into blocks_ + 1 for each text word, 0 if no block starts there
+    uint64_t generation_ = 0; ///< predecode table generation the blocks were built against
+
+    const Block& GetBlock(FastForwardState& state);
+    FastForwardOp BuildOp(uint64_t pc, FastForwardState& state);
+};
+
+} // namespace fast_forward
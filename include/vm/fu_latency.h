@@ -0,0 +1,73 @@
+#pragma once
+
+#include "vm/alu.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fu_latency {
+
+/**
+ * @brief The groups of AluOps that share a latency and initiation interval, one pair of [Latency] keys each.
+ */
+enum class OpClass : uint8_t {
+    IntAlu, ///< add, logic, shifts, compares, lui/auipc (and the address of a load/store)
+    IntMul,
+    IntDiv, ///< div and rem
+    FpAdd,  ///< fadd/fsub
+    FpMul,
+    FpFma,  ///< fmadd/fmsub/fnmadd/fnmsub
+    FpDiv,
+    FpSqrt,
+    FpMisc, ///< sign injection, min/max, compares, fclass, conversions and moves
+    Count,
+};
+
+/**
+ * @brief How long an op keeps a functional unit.
+ */
+struct OpTiming {
+    unsigned int latency = 1;  ///< cycles until the result can be used
+    unsigned int interval = 1; ///< cycles until the unit takes the next op, 1 for a pipelined unit, latency for a
+                               ///< blocking (iterative) one
+};
+
+/**
+ * @brief The [Latency] section. Everything defaults to 1/1, the single cycle units the models had before.
+ */
+struct LatencyConfig {
+    std::array<OpTiming, static_cast<size_t>(OpClass::Count)> timings{};
+
+    /**
+     * @brief Applies a <class>_latency or <class>_interval key, e.g. int_div_latency=20.
+     */
+    void Modify(const std::string& key, const std::string& value);
+};
+
+OpClass ClassOf(alu::AluOp op);
+
+/**
+ * @brief Latency and initiation interval per AluOp, built from a LatencyConfig on load so the stages look an op up
+ * with one index.
+ */
+class LatencyTable {
+public:
+    LatencyTable();
+
+    void Configure(const LatencyConfig& config);
+
+    const OpTiming& operator[](alu::AluOp op) const { return table_[static_cast<size_t>(op)]; }
+
+    /**
+     * @brief The longest latency of any op, the most ops a pipelined unit can have in flight.
+     */
+    unsigned int MaxLatency() const;
+
+private:
+    static constexpr size_t kNumOps = static_cast<size_t>(alu::AluOp::FMV_X_D) + 1;
+
+    std::array<OpTiming, kNumOps> table_;
+};
+
+} // namespace fu_latency
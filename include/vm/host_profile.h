@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace host_profile {
+
+/**
+ * @brief What the host time of a simulated cycle is spent on: Cycle is the whole step, the others the stage calls of
+ * the executors. A model times the stages it has.
+ */
+enum class Timer : uint8_t {
+    Cycle,
+    Fetch,
+    Decode,
+    Issue,     ///< into the reservation stations
+    Select,    ///< the functional units picking from them
+    Execute,
+    Memory,
+    WriteBack,
+    Commit,    ///< ReorderBuffer::Commit
+    Broadcast, ///< the CDB: ReorderBuffer::Pull and ReservationStation::ListenToBroadCast
+    Count,
+};
+
+constexpr size_t kNumTimers = static_cast<size_t>(Timer::Count);
+
+// the stage timers are only built with -DVM_HOST_PROFILE=ON, the host time of Run() is always measured
+#ifdef VM_HOST_PROFILE
+constexpr bool kStageTimers = true;
+#else
+constexpr bool kStageTimers = false;
+#endif
+
+// lower case, for reports
+const char* Name(Timer timer);
+
+// the time stamp counter where there is one, else steady_clock nanoseconds
+inline uint64_t Now() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// host nanoseconds per tick of Now(), measured against steady_clock on the first call
+double NsPerTick();
+
+struct TimerTotals {
+    uint64_t ticks = 0;
+    uint64_t calls = 0;
+};
+
+/**
+ * @brief How fast the simulator ran, since the core was loaded: the host time of its Run() calls against the cycles
+ * and instructions they simulated, and with kStageTimers the host time of each stage.
+ */
+class HostProfile {
+public:
+    void Add(Timer timer, uint64_t ticks) {
+        TimerTotals& totals = timers_[static_cast<size_t>(timer)];
+        totals.ticks += ticks;
+        totals.calls++;
+    }
+
+    void AddRun(uint64_t ns, uint64_t cycles, uint64_t instrs);
+    void Reset();
+
+    uint64_t RunNs() const { return run_ns_; }
+    uint64_t RunCycles() const { return run_cycles_; }
+    uint64_t RunInstrs() const { return run_instrs_; }
+    double Mips() const;
+    double NsPerCycle() const;
+
+    const TimerTotals& Totals(Timer timer) const { return timers_[static_cast<size_t>(timer)]; }
+    double StageNs(Timer timer) const;
+    // per cycle the Cycle timer saw, a run that skipped the stages (the functional fast path) doesn't count
+    double StageNsPerCycle(Timer timer) const;
+
+private:
+    uint64_t run_ns_ = 0;
+    uint64_t run_cycles_ = 0;
+    uint64_t run_instrs_ = 0;
+    std::array<TimerTotals, kNumTimers> timers_{};
+};
+
+class ScopedTimer {
+public:
+    ScopedTimer(HostProfile& profile, Timer timer) : profile_(profile), timer_(timer), start_(Now()) {}
+    ~ScopedTimer() { profile_.Add(timer_, Now() - start_); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    HostProfile& profile_;
+    Timer timer_;
+    uint64_t start_;
+};
+
+/**
+ * @brief Times one Run(): adds it to the profile and writes the simulated instructions per host second to log.
+ */
+class RunTimer {
+public:
+    RunTimer(uint64_t cycles, uint64_t instrs);
+    void Stop(HostProfile& profile, uint64_t cycles, uint64_t instrs, std::ostream& log);
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    uint64_t cycles_;
+    uint64_t instrs_;
+};
+
+} // namespace host_profile
+
+// times the rest of the enclosing scope as host_profile::Timer::timer, nothing unless built with VM_HOST_PROFILE
+#ifdef VM_HOST_PROFILE
+#define HOST_PROFILE_CONCAT_(a, b) a##b
+#define HOST_PROFILE_CONCAT(a, b) HOST_PROFILE_CONCAT_(a, b)
+#define HOST_PROFILE_SCOPE(profile, timer) \
+    ::host_profile::ScopedTimer HOST_PROFILE_CONCAT(host_profile_scope_, __LINE__)(profile, ::host_profile::Timer::timer)
+#else
+#define HOST_PROFILE_SCOPE(profile, timer) static_cast<void>(0)
+#endif
@@ -10,61 +10,121 @@
 #include "config.h"
 
 #include <vector>
+#include <memory>
 #include <unordered_map>
 #include <cstdint>
 #include <string>
 #include <stdexcept>
 
 /**
- * @brief Represents a memory block containing 1 KB of memory.
+ * @brief Pooled allocator for guest memory pages.
+ *
+ * Pages are carved out of large chunks and never handed back to the system while the arena lives.
+ * Released pages go on a free list and are zeroed again when they are handed out.
  */
-struct MemoryBlock {
-  std::vector<uint8_t> data; ///< A vector representing the memory block data.
-  unsigned int block_size = vm_config::config.getMemoryBlockSize(); ///< The size of the memory block in bytes.
+class PageArena {
+ public:
+  explicit PageArena(size_t page_size) : page_size_(page_size) {}
+
+  PageArena(const PageArena&) = delete;
+  PageArena& operator=(const PageArena&) = delete;
 
   /**
-   * @brief Constructs a MemoryBlock with a size of block_size (from config) initialized to 0.
+   * @brief Hands out a zero filled page.
+   * @return Pointer to the first byte of the page.
    */
-  MemoryBlock() {
-    data.resize(block_size, 0);
+  uint8_t* Allocate();
+
+  /**
+   * @brief Returns a page to the pool.
+   * @param page The page to release, must have come from Allocate().
+   */
+  void Release(uint8_t* page);
+
+  /**
+   * @brief Number of pages currently handed out.
+   */
+  size_t PagesInUse() const {
+    return pages_in_use_;
   }
+
+ private:
+  static constexpr size_t kPagesPerChunk = 64; ///< Pages carved out of one chunk allocation.
+
+  size_t page_size_;
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_; ///< Backing storage, owned by the arena.
+  std::vector<uint8_t*> free_list_; ///< Released pages, reused before carving a new chunk.
+  size_t next_in_chunk_ = kPagesPerChunk; ///< Next uncarved page in the last chunk.
+  size_t pages_in_use_ = 0;
 };
 
 /**
- * @brief Represents a memory management system with dynamic memory block allocation.
+ * @brief Represents a memory management system with on demand page allocation.
+ *
+ * Guest memory is mapped through a two level radix page table over a 48 bit canonical (sign extended) address
+ * space. Pages are 4 KB or 64 KB (memory_block_size in config) and come from a PageArena. Addresses that are not
+ * canonical still work, they are kept in a small side map. A one entry last page cache short-circuits the walk
+ * for consecutive accesses to the same page.
  */
 class Memory {
  private:
-  std::unordered_map<uint64_t, MemoryBlock> blocks_; ///< A map storing memory blocks, indexed by block index.
-  unsigned int block_size_; ///< The size of each memory block in bytes.
+  static constexpr unsigned int kVirtualAddressBits = 48; ///< Bits covered by the radix table.
+
+  unsigned int page_size_; ///< The size of each page in bytes.
+  unsigned int page_shift_; ///< log2(page_size_).
+  unsigned int leaf_bits_; ///< Page number bits resolved by a leaf table.
+  unsigned int root_bits_; ///< Page number bits resolved by the root table.
   uint64_t memory_size_ = vm_config::config.getMemorySize(); ///< The total memory size in bytes.
 
+  PageArena arena_; ///< Pool the pages are allocated from.
+  uint8_t*** root_ = nullptr; ///< Root table, each entry points to a leaf table of page pointers (lazily allocated).
+  std::unordered_map<uint64_t, uint8_t*> far_pages_; ///< Pages of non canonical addresses, indexed by page number.
+  std::vector<std::pair<uint64_t, uint8_t**>> mapped_pages_; ///< (page number, table slot) of every mapped page.
+
+  uint64_t last_page_number_ = ~0ULL; ///< Page number held by the last page cache.
+  uint8_t* last_page_ = nullptr; ///< Page held by the last page cache, nullptr if the cache is empty.
+
   /**
-   * @brief Gets the block index for a given memory address.
+   * @brief Gets the page number for a given memory address.
    * @param address The memory address.
-   * @return The block index corresponding to the address.
+   * @return The page number corresponding to the address.
    */
-  uint64_t GetBlockIndex(uint64_t address) const;
+  uint64_t GetPageNumber(uint64_t address) const {
+    return address >> page_shift_;
+  }
 
   /**
-   * @brief Gets the offset within a block for a given memory address.
+   * @brief Gets the offset within a page for a given memory address.
    * @param address The memory address.
-   * @return The offset within the block corresponding to the address.
+   * @return The offset within the page corresponding to the address.
    */
-  uint64_t GetBlockOffset(uint64_t address) const;
+  uint64_t GetPageOffset(uint64_t address) const {
+    return address & (page_size_ - 1);
+  }
+
+  /**
+   * @brief Finds the page holding the address, going through the last page cache first.
+   * @param address The memory address.
+   * @param allocate If true, an unmapped page gets mapped, otherwise nullptr is returned for it.
+   * @return Pointer to the start of the page, or nullptr if not mapped and allocate is false.
+   */
+  uint8_t* GetPage(uint64_t address, bool allocate) {
+    uint64_t page_number = GetPageNumber(address);
+    if (page_number==last_page_number_) {
+      return last_page_;
+    }
+    return WalkPageTable(address, allocate);
+  }
 
   /**
-   * @brief Checks if a memory block is present at the specified index.
-   * @param block_index The index of the block to check.
-   * @return True if the block is present, false otherwise.
+   * @brief Slow path of GetPage(), walks the page table and refills the last page cache.
    */
-  bool IsBlockPresent(uint64_t block_index) const;
+  uint8_t* WalkPageTable(uint64_t address, bool allocate);
 
   /**
-   * @brief Ensures that a memory block exists at the specified index, if not then adds it.
-   * @param block_index The index of the block to check or create.
+   * @brief Maps a fresh page into the given table slot.
    */
-  void EnsureBlockExists(uint64_t block_index);
+  uint8_t* MapPage(uint64_t page_number, uint8_t** slot);
 
   /**
    * @brief Generic function to read data of type T from the memory.
@@ -88,17 +148,19 @@ class Memory {
   /**
    * @brief Constructs a Memory object.
    */
-  Memory() {
-    block_size_ = vm_config::config.getMemoryBlockSize();
-  }
+  Memory();
   /**
    * @brief Destroys the Memory object.
    */
-  ~Memory() = default;
+  ~Memory();
 
-  void Reset() {
-    blocks_.clear();
-  }
+  Memory(const Memory&) = delete;
+  Memory& operator=(const Memory&) = delete;
+
+  /**
+   * @brief Unmaps every page and returns it to the arena. The tables themselves are kept.
+   */
+  void Reset();
 
   /**
    * @brief Reads a single byte from the given memory address.
@@ -9,43 +9,182 @@
 
 #include "../config.h"
 #include "main_memory.h"
+#include "cache/cache.h"
+#include "predecode_table.h"
+#include "globals.h"
 
 #include <iostream>
 #include <string>
 #include <vector>
+#include <stdexcept>
+#include <fstream>
+#include <utility>
 
 namespace memory_controller{
 
+/**
+ * @brief Extra cycles cache accesses took, split by the cache they missed in.
+ */
+struct StallCycles {
+    uint64_t fetch = 0; ///< I-cache
+    uint64_t data = 0; ///< D-cache
+
+    uint64_t Total() const {
+        return fetch + data;
+    }
+};
+
 /**
  * @brief The MemoryController class is responsible for managing memory in the VM.
+ *
+ * Fetch (FetchWord) and the LSU (ReadData/WriteData) go through the L1 I/D caches, every other access goes straight
+ * to Memory. The caches only model timing: cycles an access takes beyond the single cycle of its stage are collected
+ * and handed to the pipeline through TakeStallCycles().
+ *
+ * It also owns the predecode table of the loaded program, so that every write path can invalidate it.
  */
 class MemoryController {
 private:
     Memory memory_; ///< The main memory object.
+    cache::Cache icache_; ///< L1 instruction cache.
+    cache::Cache dcache_; ///< L1 data cache.
+    cache::CacheConfig icache_config_{.cache_type = cache::CacheType::Instruction};
+    cache::CacheConfig dcache_config_{.cache_type = cache::CacheType::Data};
+    StallCycles stall_cycles_; ///< Extra cycles accumulated by cache accesses since the last TakeStallCycles().
+    predecode::PredecodeTable predecode_table_; ///< Decoded instructions of the text section.
+
+    static void AddLatency(unsigned int latency, uint64_t& stall_cycles) {
+        if (latency > 1) {
+            stall_cycles += latency - 1;
+        }
+    }
+
 public:
-    MemoryController() = default;
+    MemoryController() {
+        ConfigureCaches();
+    }
 
     void Reset() {
         memory_.Reset();
+        predecode_table_.Reset(0);
+        ConfigureCaches();
+    }
+
+    /**
+     * @brief Sizes the predecode table for the text section [0, text_size), called once the program is loaded.
+     */
+    void SetTextSize(uint64_t text_size) {
+        predecode_table_.Reset(text_size);
+    }
+
+    predecode::PredecodeTable& GetPredecodeTable() {
+        return predecode_table_;
+    }
+
+    /**
+     * @brief (Re)builds both caches from the configs last given to SetCacheConfigs(), dropping their contents and
+     * stats.
+     */
+    void ConfigureCaches() {
+        icache_.Configure(icache_config_);
+        dcache_.Configure(dcache_config_);
+        stall_cycles_ = StallCycles{};
+    }
+
+    /**
+     * @brief Sets the configs the caches are built from on the next Reset() / ConfigureCaches().
+     */
+    void SetCacheConfigs(const cache::CacheConfig& icache_config, const cache::CacheConfig& dcache_config) {
+        icache_config_ = icache_config;
+        dcache_config_ = dcache_config;
+    }
+
+    /**
+     * @brief Returns the stall cycles collected since the last call and clears them.
+     */
+    StallCycles TakeStallCycles() {
+        return std::exchange(stall_cycles_, StallCycles{});
     }
 
-    void PrintCacheStatus() const {
+    const cache::CacheStats& GetICacheStats() const {
+        return icache_.GetStats();
+    }
+
+    const cache::CacheStats& GetDCacheStats() const {
+        return dcache_.GetStats();
+    }
+
+    bool CachesEnabled() const {
+        return icache_.Enabled() || dcache_.Enabled();
+    }
+
+    void PrintCacheStatus(std::ostream& os) const {
+        icache_.PrintStatus(os);
+        dcache_.PrintStatus(os);
+    }
+
+    /**
+     * @brief Writes the configuration and stats of both caches to globals::cache_dump_file_path.
+     */
+    void DumpCache(std::ostream& log) const {
+        std::ofstream file(globals::cache_dump_file_path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open cache dump file: " + globals::cache_dump_file_path.string());
+        }
+        file << "{\n";
+        file << "    \"icache\": ";
+        icache_.DumpJson(file, "        ");
+        file << ",\n";
+        file << "    \"dcache\": ";
+        dcache_.DumpJson(file, "        ");
+        file << "\n}\n";
+        file.close();
+
+        log << "VM_CACHE_DUMPED" << std::endl;
+    }
+
+    /**
+     * @brief Instruction fetch through the I-cache.
+     */
+    [[nodiscard]] uint32_t FetchWord(uint64_t address) {
+        AddLatency(icache_.Access(address, false), stall_cycles_.fetch);
+        return memory_.ReadWord(address);
+    }
+
+    /**
+     * @brief LSU load through the D-cache, see ReadSized().
+     */
+    [[nodiscard]] uint64_t ReadData(uint64_t address, size_t num_bytes) {
+        AddLatency(dcache_.Access(address, false), stall_cycles_.data);
+        return ReadSized(address, num_bytes);
+    }
+
+    /**
+     * @brief LSU store through the D-cache, see WriteSized().
+     */
+    void WriteData(uint64_t address, size_t num_bytes, uint64_t value) {
+        AddLatency(dcache_.Access(address, true), stall_cycles_.data);
+        WriteSized(address, num_bytes, value);
     }
 
     void WriteByte(uint64_t address, uint8_t value) {
       memory_.WriteByte(address, value);
+      predecode_table_.Invalidate(address, 1);
     }
 
     void WriteHalfWord(uint64_t address, uint16_t value) {
       memory_.WriteHalfWord(address, value);
+      predecode_table_.Invalidate(address, 2);
     }
 
     void WriteWord(uint64_t address, uint32_t value) {
       memory_.WriteWord(address, value);
+      predecode_table_.Invalidate(address, 4);
     }
 
     void WriteDoubleWord(uint64_t address, uint64_t value) {
       memory_.WriteDoubleWord(address, value);
+      predecode_table_.Invalidate(address, 8);
     }
 
     [[nodiscard]] uint8_t ReadByte(uint64_t address) {
@@ -64,6 +203,33 @@ public:
         return memory_.ReadDoubleWord(address);
     }
 
+    /**
+     * @brief Reads num_bytes (1, 2, 4 or 8) little endian bytes, zero extended, using the matching width access.
+     */
+    [[nodiscard]] uint64_t ReadSized(uint64_t address, size_t num_bytes) {
+        switch (num_bytes) {
+            case 1: return memory_.ReadByte(address);
+            case 2: return memory_.ReadHalfWord(address);
+            case 4: return memory_.ReadWord(address);
+            case 8: return memory_.ReadDoubleWord(address);
+            default: throw std::invalid_argument("Unsupported memory access width: " + std::to_string(num_bytes));
+        }
+    }
+
+    /**
+     * @brief Writes the low num_bytes (1, 2, 4 or 8) bytes of value using the matching width access.
+     */
+    void WriteSized(uint64_t address, size_t num_bytes, uint64_t value) {
+        switch (num_bytes) {
+            case 1: memory_.WriteByte(address, static_cast<uint8_t>(value)); break;
+            case 2: memory_.WriteHalfWord(address, static_cast<uint16_t>(value)); break;
+            case 4: memory_.WriteWord(address, static_cast<uint32_t>(value)); break;
+            case 8: memory_.WriteDoubleWord(address, value); break;
+            default: throw std::invalid_argument("Unsupported memory access width: " + std::to_string(num_bytes));
+        }
+        predecode_table_.Invalidate(address, num_bytes);
+    }
+
     void PrintMemory(const uint64_t address, unsigned int rows) {
       memory_.PrintMemory(address, rows);
     }
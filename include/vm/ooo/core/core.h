@@ -0,0 +1,198 @@
+#pragma once
+#include "./instruction_context/instruction_context.h"
+#include "../hardware/reservation_station.h"
+#include "vm/branch_predictor.h"
+#include "../hardware/decode_unit.h"
+#include "vm/registers.h"
+#include "vm/memory_controller.h"
+#include "vm/fast_forward/engine.h"
+#include "vm_asm_mw.h"
+#include "vm/vm_base.h"
+#include "vm/undo_ring.h"
+#include "vm/pipeline_trace.h"
+#include "vm/host_profile.h"
+#include "vm/fu_latency.h"
+
+
+namespace ooo{
+
+// the kinds of functional unit, each kind has one reservation station its units pick from
+enum class FuKind : uint8_t {
+    kAlu,
+    kFpu,
+    kLsu,
+    kCount
+};
+
+/**
+ * An N-wide out of order core: fetch, decode and issue move width instructions a cycle through two rows of latches,
+ * issue hands them to the reservation station of their unit kind in order, the functional units pick ready
+ * instructions out of order, and the ROB retires up to commit_width a cycle in order.
+ *
+ * An instruction follows this path:
+ * if_id_[width-1] -> ... -> if_id_[0] -> id_issue_[width-1] -> ... -> id_issue_[0] -> reservation station -> Rest
+ *
+ * Index 0 of a row is its oldest instruction.
+ */
+class OooCore{
+public:
+    struct Shape{
+        size_t width; // instructions fetched, decoded and issued per cycle
+        size_t commit_width; // instructions the ROB retires per cycle
+        std::array<size_t, static_cast<size_t>(FuKind::kCount)> units; // per FuKind, no FPU runs floating point on the ALUs
+        size_t rob_size;
+        size_t load_queue_size;
+        size_t store_queue_size;
+    };
+
+    static constexpr Shape kDualIssue{2, 2, {1, 0, 1}, 16, 8, 8};
+    static constexpr Shape kTripleIssue{3, 3, {1, 1, 1}, 32, 12, 12};
+
+    // an op still on a multi-cycle unit, its result goes onto the CDB in ready_cycle
+    struct InProgress{
+        uint64_t ready_cycle = 0;
+        OooInstrContext instr;
+    };
+
+    struct FunctionalUnit{
+        FuKind kind;
+        OooInstrContext picked; // taken from the reservation station at the start of the cycle
+        OooInstrContext exec; // being executed this cycle
+        OooInstrContext commit; // result waiting to go onto the CDB
+        FixedQueue<InProgress> in_progress; // executed ops with a latency over 1, oldest first
+        uint64_t busy_until = 0; // first cycle the unit can execute another op, see OpTiming::interval
+    };
+
+    // the state Undo() rolls a cycle back to. The register file and memory are not copied, what a cycle overwrote
+    // there is in undo_records_ under the seq of the instruction that wrote it (memory is only written at commit)
+    struct CycleCheckpoint{
+        uint64_t pc = 0;
+        uint32_t next_seq = 0;
+        std::vector<OooInstrContext> if_id;
+        std::vector<OooInstrContext> id_issue;
+        std::vector<FunctionalUnit> functional_units;
+        std::array<ReservationStation, static_cast<size_t>(FuKind::kCount)> stations;
+        ReorderBuffer commit_buffer;
+        CommonDataBus broadcast_bus;
+        RegisterStatusFile reg_status_file;
+        LoadStoreQueue load_store_queue;
+        bool refilling_after_squash = false;
+        VmBase::Stats core_stats;
+        pc_profile::CycleCharge profile_charge; ///< what the cycle charged to profile_, set once it has run
+    };
+
+    // default_shape is what the [Execution] keys that are left unset fall back to
+    explicit OooCore(const Shape& default_shape);
+
+    // drops every instruction younger than branch, which executed and turned out mispredicted: the latches before
+    // issue, and the reservation station, functional unit, CDB, ROB and load/store queue entries whose ROB entry
+    // (rob_idx and epoch) is gone once the ROB is cut back to branch
+    void SquashYoungerThan(const OooInstrContext& branch);
+
+    // true once fetch has run past the program and every latch, reservation station and the ROB have drained
+    bool ProgramEnded();
+
+    void ClearStop();
+
+    // sizes the latches, functional units, reservation stations, the ROB, the load/store queue and the CDB from the
+    // [Execution] config, done on every Load()
+    void ApplyShape();
+
+    const Shape& GetShape() const { return shape_; }
+
+    void SaveCheckpoint(CycleCheckpoint& checkpoint) const;
+    void RestoreCheckpoint(const CycleCheckpoint& checkpoint);
+
+    // the oldest instruction on a breakpoint among the ones the next cycle commits (the finished ones from the ROB
+    // head on, up to the commit width), nullptr if there is none
+    const OooInstrContext* NextBreakpointCommit() const;
+
+    // the instruction retirement waits on: the ROB head, or the oldest one before issue if the ROB is empty.
+    // nullptr if nothing is in flight
+    const OooInstrContext* OldestInFlight() const;
+
+    ReservationStation& Station(FuKind kind) { return stations_[static_cast<size_t>(kind)]; }
+
+    // the station an instruction issues to, floating point ops go to the ALUs when there is no FPU
+    ReservationStation& StationFor(const OooInstrContext& instr);
+
+    std::vector<OooInstrContext> if_id_;
+    std::vector<OooInstrContext> id_issue_;
+    std::vector<FunctionalUnit> functional_units_; // ALUs, then FPUs, then LSUs
+
+    uint64_t pc = 0;
+
+    bool is_stop_requested_ = false;
+
+    // set by a squash until the refetched path issues, its empty issue slots are bad speculation (see Stats::TopDown)
+    bool refilling_after_squash_ = false;
+
+    // brach prediction
+    bool branch_prediction_enabled_ = false;
+	bool branch_prediction_static_ = false;
+
+    // Debug vars
+    bool debug_mode_{true};
+    UndoRing<OooInstrContext> undo_instruction_stack_; ///< the retired instructions of the cycles in undo_cycles_
+    UndoRing<CycleCheckpoint> undo_cycles_; ///< one per stepped cycle, see CycleCheckpoint
+    size_t max_undo_stack_size_{256};
+    uint32_t next_seq_ = 0; ///< seq of the next fetched instruction
+    SeqTable<UndoRecord> undo_records_; ///< what each in flight or undoable instruction overwrote, keyed by seq
+    std::atomic<bool> stop_requested_{false}; ///< set from the GUI thread, cleared by ClearStop()
+    std::vector<uint64_t> breakpoints_;
+
+    // Hardware
+    alu::Alu alu_;
+    fu_latency::LatencyTable latency_table_; ///< how long an op holds an ALU/FPU, from the [Latency] config
+    register_file::RegisterFile register_file_;
+    memory_controller::MemoryController memory_controller_;
+    fast_forward::FastForwardEngine fast_forward_engine_;
+    OooDecodeUnit decode_unit_;
+    CommonDataBus broadcast_bus_;
+    ReorderBuffer commit_buffer_;
+    RegisterStatusFile reg_status_file_;
+    LoadStoreQueue load_store_queue_;
+    branch_predictor::BranchPredictor branch_predictor_;
+
+    // for input handling in syscalls:
+	std::mutex input_mutex_;
+	std::condition_variable input_cv_;
+	std::queue<std::string> input_queue_;
+
+    uint64_t program_size_ = 0;
+
+    VmBase::Stats core_stats_;
+    pc_profile::PcProfile profile_; ///< sized to the text section on load
+    pipeline_trace::Tracer trace_; ///< [Trace] events, a new trace on every load
+    host_profile::HostProfile host_profile_; ///< how fast the host simulates this core, reset on load
+
+    // what the core was loaded with, set by the model before it loads so that models with different configs can
+    // run side by side
+    vm_config::VmConfig config_;
+    std::ostream* log_ = &globals::vm_cout_file; ///< executor and syscall messages
+
+    std::ostream& Log() { return *log_; }
+    void SetLog(std::ostream& log);
+
+    uint64_t GetProgramCounter() const;
+    void AddToProgramCounter(int64_t value);
+    void SetProgramCounter(uint64_t value);
+
+    void Reset();
+
+    void Load();
+    void Load(AssembledProgram& program);
+
+private:
+    Shape default_shape_;
+    Shape shape_;
+
+    std::array<ReservationStation, static_cast<size_t>(FuKind::kCount)> stations_;
+
+    // sizes the rows of latches and the functional units to shape_
+    void BuildLatches();
+    void ResetLatches();
+};
+
+
+} // namespace ooo
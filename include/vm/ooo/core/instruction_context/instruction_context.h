@@ -0,0 +1,54 @@
+#pragma once
+#include "vm/instruction_context.h"
+#include "vm/branch_predictor.h"
+
+namespace ooo{
+
+struct OooInstrContext : InstrContext {
+    OooInstrContext();
+    OooInstrContext(uint64_t pc);
+    
+    // branch signals:
+    branch_predictor::BranchPrediction branch_prediction;
+    uint64_t branch_target = 0; // where a taken branch goes, for jal/jalr alu_out holds the return address (see OooStages::LinkJump)
+    bool branch_predicted_taken = false; // job of the 'FETCH' stage to update this. (For branch prediction)
+    bool branch_taken = false; // set when the branch executes, see OooStages::ResolveBranch
+    bool branch_mispredicted = false; // set when the branch executes, wrong direction or wrong target
+
+    bool wait_for_rs1 = true;
+    bool wait_for_rs2 = true;
+    bool wait_for_rs3 = true;
+
+    // is illegal instruction (pc was greater than program_size_)
+    bool illegal = false;
+
+    // a floating point op, issued to an FPU when the core has one (to an ALU otherwise)
+    bool into_falu = false;
+
+    size_t rob_idx = 0;
+    size_t epoch = 0;
+    uint64_t rs1_tag = 0;
+    uint64_t rs1_epoch = 0;
+    uint64_t rs2_tag = 0;
+    uint64_t rs2_epoch = 0;
+    uint64_t rs3_tag = 0;
+    uint64_t rs3_epoch = 0;
+
+    // forwarding vars
+    bool uses_rs1 = false;
+    bool uses_rs2 = false;
+    bool uses_rs3 = false;
+
+    // bools for status
+    bool ready_to_exec = false;
+
+    // a store whose address is in the store queue, see ReservationStation::ResolveStoreAddresses()
+    bool store_addr_done = false;
+
+    void reset_id_vars();
+};
+
+static_assert(std::is_trivially_copyable_v<OooInstrContext>);
+
+
+} // namespace ooo
\ No newline at end of file
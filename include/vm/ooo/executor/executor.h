@@ -0,0 +1,42 @@
+#include "../core/core.h"
+#include "../stages/stages.h"
+#include "utils.h"
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+
+namespace ooo{
+
+class OooExecutor{
+public:
+    /**
+     * @brief Cycles until the program has ended (fetch ran past it and the latches, reservation stations and ROB
+     * drained), the stop flag is set or the execution limit is hit. Keeps no undo records.
+     */
+    static void RunOoo(OooCore& vm_core);
+
+    /**
+     * @brief Like RunOoo(), one checkpointed cycle at a time with after_step called after each, the run ends once it
+     * gives false. Stops before an instruction on a breakpoint commits.
+     */
+    static void DebugRunOoo(OooCore& vm_core, const std::function<bool()>& after_step);
+
+    static void StepOoo(OooCore& vm_core);
+
+    /**
+     * @brief Takes back the last cycle stepped by StepOoo() or DebugRunOoo(). The branch predictor and caches keep
+     * what they learnt.
+     */
+    static void UndoOoo(OooCore& vm_core);
+
+    /**
+     * @brief Runs up to num_instrs instructions on the functional fast forward engine, only possible while the
+     * pipeline is empty (before the first cycle). Stats are not updated.
+     * @return The number of instructions retired.
+     */
+    static uint64_t FastForwardOoo(OooCore& vm_core, uint64_t num_instrs);
+};
+
+
+} // namespace ooo
@@ -0,0 +1,92 @@
+#pragma once
+#include "./data_bus.h"
+#include <set>
+#include <memory>
+
+namespace ooo{
+
+class OooCore;
+
+class ROBBuffer{
+public:
+    struct ROBBufferEntry{
+        bool ready_to_commit = false;
+        OooInstrContext instr;
+        size_t epoch_number;
+    };
+
+    ROBBuffer();
+    ROBBuffer(size_t slots);
+
+    size_t EmptySlots();
+    bool Empty();
+    bool HeadReady();
+
+    // the entry keeps instr (its rd) until the result comes in
+    std::pair<size_t, size_t> Reserve(const OooInstrContext& instr);
+    bool Push(OooInstrContext instr);
+    OooInstrContext Top();
+    void Pop();
+
+    std::tuple<bool, uint64_t, uint64_t> QueryVal(uint64_t rob_idx);
+
+    // false once the entry instr was reserved has been released (committed or squashed)
+    bool Holds(const OooInstrContext& instr);
+
+    void Reset();
+
+    const std::vector<ROBBufferEntry>& GetEntries() const;
+    std::pair<size_t, size_t> GetHeadTail() const;
+
+    // drops every entry after till_head (a mispredicted branch) and rebuilds the register status from the ones left
+    void ResetTailTillIdx(size_t till_head, OooCore& vm_core);
+
+private:
+    // sized by OooCore::ApplyShape(): 16 for the dual issue shape (4 + 4 from reservation stations, 8 in 4 pipeline
+    // registers (each register has 2)), 32 for the triple issue one
+    size_t max_size;
+
+    size_t head = 0;
+    size_t tail = 0;
+
+    std::vector<ROBBufferEntry> buffer;
+
+    size_t epoch_counter = 0;
+
+    bool InLimits(size_t idx);
+
+};
+
+class ReorderBuffer{
+public:
+    ReorderBuffer(){}
+    ReorderBuffer(size_t slots) : buffer(slots) {}
+
+    size_t EmptySlots();
+    bool Empty();
+
+    void Pull(OooCore& vm_core);
+    void Push(OooInstrContext& instr, OooCore& vm_core);
+    
+    void Commit(OooCore& vm_core);
+
+    std::pair<size_t, size_t> Reserve(const OooInstrContext& instr);
+
+    std::tuple<bool, uint64_t, uint64_t> QueryVal(uint64_t rob_idx);
+
+    bool Holds(const OooInstrContext& instr);
+
+    void Reset();
+
+    const std::vector<ROBBuffer::ROBBufferEntry>& GetEntries() const;
+    std::pair<size_t, size_t> GetHeadTail() const;
+
+    void ResetTailTillIdx(size_t till_head, OooCore& vm_core);
+    
+private:
+    ROBBuffer buffer;
+
+    void BroadCastMsgs(OooInstrContext& instr, CommonDataBus& data_bus, bool clear_dependency);
+};
+
+} // namespace ooo
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include "../core/instruction_context/instruction_context.h"
+#include "./fixed_queue.h"
+
+namespace ooo{
+
+class CommonDataBus{
+public:
+    struct BroadCastMessage{
+        uint64_t rob_idx = 0;
+        uint64_t value = 0;
+        bool clear_dependency = false;
+        uint64_t epoch = 0;
+
+        BroadCastMessage() = default;
+        BroadCastMessage(uint64_t rob_idx, uint64_t value, bool clear_dependency, uint64_t epoch): 
+            rob_idx{rob_idx}, 
+            value{value}, 
+            clear_dependency{clear_dependency}, 
+            epoch{epoch} 
+        {}
+    };
+
+    static constexpr size_t kDefaultSlots = 8;
+
+    FixedQueue<BroadCastMessage> broadcast_msgs;
+
+    // results of the functional units waiting for a slot on the bus, oldest first
+    FixedQueue<OooInstrContext> waiting_results;
+
+    // room for slots broadcasts and waiting results before the queues have to grow
+    explicit CommonDataBus(size_t slots = kDefaultSlots);
+
+    // results carried per cycle, 0 for unlimited
+    void SetWidth(size_t width);
+
+    // drops the broadcasts and every waiting result
+    void Reset();
+
+    // drops this cycle's broadcasts, results that lost arbitration stay for the next cycle
+    void EndCycle();
+
+    void BroadCast(uint64_t rob_idx, uint64_t value, bool clear_dependency, uint64_t epoch);
+
+    // queues a result for arbitration
+    void Request(const OooInstrContext& instr);
+
+    // hands out the oldest waiting result, false once the bus is out of slots for this cycle or nothing is waiting
+    bool Grant(OooInstrContext& instr);
+
+private:
+    size_t width_ = 0;
+    size_t granted_ = 0;
+};
+
+
+} // namespace ooo
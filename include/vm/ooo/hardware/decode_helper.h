@@ -5,5 +5,5 @@
 
 namespace DecoderHelper
 {
-    void SetContextValues(dual_issue::DualIssueInstrContext& instr_context);
+    void SetContextValues(ooo::OooInstrContext& instr_context);
 } // namespace DecoderHelper
\ No newline at end of file
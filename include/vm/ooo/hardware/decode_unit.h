@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/instructions.h"
+#include "vm/alu.h"
+#include "vm/registers.h"
+#include "vm/predecode_table.h"
+
+
+namespace ooo
+{
+struct OooInstrContext;
+
+/**
+ * @brief The DecodeUnit class is the decode unit of the CPU. Responsible for setting the control signals and getting the alu signal
+ */
+class OooDecodeUnit {
+public:
+    ~OooDecodeUnit() = default;
+
+    /**
+     * @brief DecodeInstruction decodes instr_context, taking the static fields (into_falu included) from
+     * predecode_table when it has them. Register values are read later, at issue (SetRegValues).
+     */
+    void DecodeInstruction(OooInstrContext& instr_context, predecode::PredecodeTable& predecode_table);
+
+    
+    /**
+     * @brief SetRegValues sets the register values. Simulates fetching from the register file
+     * @param instr_context The instruction being decoded.
+     * @param rf The register file of the vm
+     */
+    void SetRegValues(OooInstrContext& instr_context, register_file::RegisterFile& rf);
+
+private:
+    /**
+     * @brief DecodeStaticFields runs the full decode of the fields that only depend on the instruction word.
+     * @param instr_context The instruction being decoded.
+     */
+    void DecodeStaticFields(OooInstrContext& instr_context);
+
+    /**
+     * @brief DecodeInstrFields decodes the opcode, registers (rs1,rs2,rs3,rd), funct values and the immediate
+     * @param instr_context The instruction being decoded.
+     */
+    void DecodeInstrFields(OooInstrContext& instr_context);
+
+
+    /**
+     * @brief SetControlSignals sets the alu flags, mux select line flags.
+     * @param instr_context
+     */
+    void SetContextValues(OooInstrContext& instr_context);
+
+
+    /**
+     * @brief SetMemAccessSize sets the num_bytes field of OooInstrContext. Just tells how many bytes are being accesed in the memory phase
+     */
+    void SetMemValues(OooInstrContext& instr_context);
+
+    /**
+     * @brief GetAluSignal helper function used by SetContextValues which sets the alu flags
+     * @param instr_context
+     */
+    alu::AluOp GetAluSignal(OooInstrContext& instr_context);
+
+    /**
+     * @brief SetAluQue sets into_falu for the floating point ops, the ones an FPU executes
+     * @param instr_context
+     */
+    void SetAluQue(OooInstrContext& instr_context);
+
+    /**
+     * @brief ImmGenerator is a helper function used by SetRegImmValues, generates the immediate
+     * @param instr_context
+     */
+    int32_t ImmGenerator(OooInstrContext& instr_context);
+};
+
+} // namespace rv5s
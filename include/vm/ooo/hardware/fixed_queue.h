@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace ooo{
+
+/**
+ * A FIFO over a ring of slots allocated up front. Copying one queue onto another of the same capacity only copies
+ * the slots, so the cycle checkpoints (see OooCore::CycleCheckpoint) can be taken every cycle without allocating.
+ * Pushing onto a full queue doubles its capacity.
+ */
+template <typename T>
+class FixedQueue{
+public:
+    template <typename Queue, typename Value>
+    class Iterator{
+    public:
+        Iterator(Queue* queue, size_t idx) : queue_{queue}, idx_{idx}{}
+
+        Value& operator*() const { return (*queue_)[idx_]; }
+        Value* operator->() const { return &(*queue_)[idx_]; }
+        Iterator& operator++(){ idx_++; return *this; }
+        bool operator!=(const Iterator& other) const { return idx_!=other.idx_; }
+
+    private:
+        Queue* queue_;
+        size_t idx_;
+    };
+
+    using iterator = Iterator<FixedQueue, T>;
+    using const_iterator = Iterator<const FixedQueue, const T>;
+
+    FixedQueue() = default;
+    explicit FixedQueue(size_t capacity) : slots_(capacity){}
+
+    void PushBack(const T& value){
+        if(size_==slots_.size())
+            Grow();
+        slots_[(head_ + size_) % slots_.size()] = value;
+        size_++;
+    }
+
+    void PopFront(){
+        head_ = (head_ + 1) % slots_.size();
+        size_--;
+    }
+
+    void PopBack(){ size_--; }
+
+    // drops the first n entries
+    void PopFront(size_t n){
+        if(n==0)
+            return;
+        head_ = (head_ + n) % slots_.size();
+        size_ -= n;
+    }
+
+    // drops the entries pred holds for, the others keep their order
+    template <typename Pred>
+    void EraseIf(Pred pred){
+        size_t kept = 0;
+        for(size_t i=0;i<size_;i++){
+            if(pred((*this)[i]))
+                continue;
+            if(kept!=i)
+                (*this)[kept] = (*this)[i];
+            kept++;
+        }
+        size_ = kept;
+    }
+
+    void Clear(){
+        head_ = 0;
+        size_ = 0;
+    }
+
+    T& operator[](size_t idx){ return slots_[(head_ + idx) % slots_.size()]; }
+    const T& operator[](size_t idx) const { return slots_[(head_ + idx) % slots_.size()]; }
+
+    T& Front(){ return (*this)[0]; }
+    const T& Front() const { return (*this)[0]; }
+    T& Back(){ return (*this)[size_ - 1]; }
+    const T& Back() const { return (*this)[size_ - 1]; }
+
+    size_t Size() const { return size_; }
+    bool Empty() const { return size_==0; }
+    size_t Capacity() const { return slots_.size(); }
+
+    iterator begin(){ return {this, 0}; }
+    iterator end(){ return {this, size_}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+
+private:
+    std::vector<T> slots_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    void Grow(){
+        std::vector<T> slots(slots_.empty() ? 1 : 2 * slots_.size());
+        for(size_t i=0;i<size_;i++)
+            slots[i] = (*this)[i];
+        slots_.swap(slots);
+        head_ = 0;
+    }
+};
+
+
+} // namespace ooo
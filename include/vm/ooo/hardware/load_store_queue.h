@@ -0,0 +1,78 @@
+#pragma once
+#include "../core/instruction_context/instruction_context.h"
+#include "./fixed_queue.h"
+
+namespace ooo{
+
+/**
+ * The load queue and the store queue of the out of order core. Memory ops get an entry when they issue, in program
+ * order, and give it up when they commit (or are squashed).
+ *
+ * A store only fills in its entry before it commits, memory is written at commit (see OooStages::WriteBack). Its
+ * address goes in as soon as its base register is there (see ReservationStation::ResolveStoreAddresses()), its data
+ * once it has been through the LSU. A load may go to the LSU ahead of older memory ops once every older store has its
+ * address: it then takes its value from the youngest older store it overlaps (once that store has its data), or from
+ * memory if there is none. A load that only partly overlaps an older store waits until that store has committed.
+ */
+class LoadStoreQueue{
+public:
+    static constexpr size_t kDefaultSize = 8;
+
+    struct Entry{
+        uint32_t seq = 0;
+        bool addr_known = false;
+        uint64_t address = 0;
+        uint8_t bytes = 0;
+        bool data_known = false; // stores only
+        uint64_t data = 0; // stores only
+    };
+
+    LoadStoreQueue();
+    LoadStoreQueue(size_t load_slots, size_t store_slots);
+
+    // false if instr is a memory op and its queue is full
+    bool HasSlot(const OooInstrContext& instr) const;
+
+    // takes an entry for a load or a store, at issue
+    void Push(const OooInstrContext& instr);
+
+    // true if every store older than load has its address, none of them overlaps it only partly and the youngest
+    // one that overlaps it has its data
+    bool LoadMayIssue(const OooInstrContext& load) const;
+
+    // the address of a store whose base register is there, its data isn't known yet
+    void ResolveStoreAddress(const OooInstrContext& store);
+
+    // the address and data of a store, once the LSU has computed them
+    void ResolveStore(const OooInstrContext& store, uint64_t data);
+
+    // the value of load from the youngest older store that holds all of its bytes, false if no older store overlaps it
+    bool Forward(const OooInstrContext& load, uint64_t& value) const;
+
+    // drops the entry of a committed load or store, the oldest one of its queue
+    void Retire(const OooInstrContext& instr);
+
+    // drops the entries of the instrs younger than seq, a mispredicted branch
+    void SquashYoungerThan(uint32_t seq);
+
+    void Reset();
+
+    const FixedQueue<Entry>& GetLoads() const;
+    const FixedQueue<Entry>& GetStores() const;
+
+    // rs1 + imm, what the LSU computes for a load or store
+    static uint64_t EffectiveAddress(const OooInstrContext& instr);
+
+private:
+    size_t load_slots_;
+    size_t store_slots_;
+
+    FixedQueue<Entry> loads_; // oldest first
+    FixedQueue<Entry> stores_; // oldest first
+
+    // the youngest store older than load that overlaps [address, address + bytes), nullptr if there is none
+    const Entry* YoungestOverlap(uint32_t load_seq, uint64_t address, uint8_t bytes) const;
+};
+
+
+} // namespace ooo
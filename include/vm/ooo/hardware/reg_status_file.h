@@ -2,7 +2,7 @@
 #include "../core/instruction_context/instruction_context.h"
 #include "vm/registers.h"
 
-namespace dual_issue{
+namespace ooo{
 
 class TagFile{
 public:
@@ -47,4 +47,4 @@ private:
 };
 
 
-} // namespace dual_issue
\ No newline at end of file
+} // namespace ooo
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include "./commit_buffer.h"
+#include "./reg_status_file.h"
+#include "./data_bus.h"
+#include "./load_store_queue.h"
+#include <vector>
+
+namespace ooo{
+class OooCore;
+
+class ReservationStation{
+public:
+    static constexpr size_t kDefaultSize = 4;
+
+    ReservationStation();
+    ReservationStation(size_t slots);
+
+    size_t EmptySlots();
+    bool Empty();
+
+    void ListenToBroadCast(CommonDataBus& data_bus);
+
+    void Push(OooInstrContext instr, OooCore& vm_core);
+
+    OooInstrContext GetReadyInstr();
+    // like GetReadyInstr(), but a load only leaves once lsq lets it (see LoadStoreQueue::LoadMayIssue())
+    OooInstrContext GetReadyMemInstr(const LoadStoreQueue& lsq);
+
+    // the address of every store whose base is there goes into lsq, the station has its own adder for them. A store
+    // still leaves only once its data is there too, but the younger loads no longer wait on the data
+    void ResolveStoreAddresses(LoadStoreQueue& lsq);
+
+    // drops the entries whose ROB entry was squashed
+    void Squash(ReorderBuffer& commit_buffer);
+
+    void Reset();
+
+    const std::vector<OooInstrContext>& GetQue() const;
+    
+private:
+    size_t max_size_;
+
+    // removes que_[idx], the freed slot goes to the back
+    OooInstrContext Take(size_t idx);
+
+    std::vector<OooInstrContext> que_; // max_size_ slots, the free ones illegal
+};
+
+
+} // namespace ooo
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include "../core/core.h"
+
+namespace ooo{
+
+
+/**
+ * The stages of the out of order core, for any width and set of functional units (see OooCore for the path an
+ * instruction takes through the latches).
+ */
+
+class OooStages{
+public:
+    /**
+     * Fetches num_fetch instructions into the youngest num_fetch slots of if_id_. The fetch group ends at a
+     * predicted taken branch, the slots after it are left illegal.
+     * If num_fetch is 0, it doesn't fetch (no update to if_id_)
+     */
+    static void Fetch(OooCore& vm_core, size_t num_fetch);
+
+
+    /**
+     * Decodes the instructions of vm_core.if_id_ in place, doens't move anything
+     */
+    static void Decode(OooCore& vm_core);
+
+    /**
+     * Pushes the instructions of id_issue_ into their reservation stations, oldest first, up to the first one whose
+     * station or the ROB is full: an instruction never issues ahead of a stalled older one, it would reserve (and
+     * commit from) an earlier ROB slot. Illegal slots always go. The unpushed instructions move to the front of
+     * id_issue_ (oldest first).
+     *
+     * Returns the number of freed id_issue_ slots
+     */
+    static size_t Issue(OooCore& vm_core);
+
+    /**
+     * Executes the instruction in fu.exec on the unit. Branches are resolved separately, see ResolveBranch().
+     */
+    static void Execute(OooCore::FunctionalUnit& fu, OooCore& vm_core);
+
+    /**
+     * Resolves an executed branch. If it was predicted incorrectly, everything younger is squashed right away and
+     * fetch restarts at the right target, the older instructions stay in flight.
+     */
+    static void ResolveBranch(OooInstrContext& instr, OooCore& vm_core);
+
+    /**
+     * Retires wb_instruction (the ROB head). Stores write memory here and memory ops leave the load/store queue. A
+     * branch was resolved when it executed, here it only trains the predictor and is counted.
+     */
+    static void WriteBack(OooInstrContext& wb_instruction, OooCore& vm_core);
+
+    /**
+     * For jal/jalr, moves the jump target out of alu_out into branch_target and puts the return address (pc + 4)
+     * there instead, so dependents of rd read the link value off the CDB.
+     */
+    static void LinkJump(OooInstrContext& instr);
+
+    // the value a store writes, from rs2 or frs2
+    static uint64_t StoreData(const OooInstrContext& store);
+
+
+private:
+    // FIXME: this doesn't belong here
+    static void HandleSyscall(OooCore& vm_core);
+
+    static void CommitBranch(OooInstrContext& instr, OooCore& vm_core);
+
+    // an ALU runs the floating point ops too when the core has no FPU
+    static void ExecuteAlu(OooInstrContext& ex_instruction, OooCore& vm_core);
+    static void ExecuteFpu(OooInstrContext& ex_instruction, OooCore& vm_core);
+    static void ExecuteBasic(OooInstrContext& ex_instruction, OooCore& vm_core);
+    static void ExecuteFloat(OooInstrContext& ex_instruction, OooCore& vm_core);
+    static void ExecuteDouble(OooInstrContext& ex_instruction, OooCore& vm_core);
+
+    // a load reads memory (or takes its value from an older store in the store queue), a store only hands its address
+    // and data to the store queue
+    static void MemoryAccess(OooInstrContext& mem_instruction, OooCore& vm_core);
+
+    static void WriteBackCsr(OooInstrContext& wb_instruction, OooCore& vm_core);
+};
+
+
+} // namespace ooo
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "./core/core.h"
+#include "./stages/stages.h"
+#include "./executor/executor.h"
+#include "vm/vm_base.h"
+
+namespace ooo{
+
+class OooVM : public VmBase {
+public:
+    // the model keeps its own copy of config, so models built from different configs can run side by side.
+    // shape is the machine (e.g. OooCore::kDualIssue), the [Execution] width and unit keys override it
+    explicit OooVM(const OooCore::Shape& shape, const vm_config::VmConfig& config = vm_config::config);
+
+    void Reset() override;
+
+    void LoadVM() override;
+    void LoadVM(AssembledProgram program) override;
+
+    void Run() override;
+
+    void DebugRun() override;
+
+    void Step() override;
+
+    void Undo() override;
+
+    void SetBreakpoints(const std::vector<uint64_t>& pcs) override;
+
+    void RequestStop() override;
+    void ClearStop() override;
+    bool ProgramEnded() override;
+
+    uint64_t FastForward(uint64_t num_instrs) override;
+
+    uint64_t ReadMemDoubleWord(uint64_t address) override;
+
+    const std::array<uint64_t, 32>& GetGprValues() override;
+    const std::array<uint64_t, 32>& GetFprValues() override;
+
+    std::vector<uint64_t> GetInstructionPCs() override;
+    Stats& GetStats() override;
+    const pc_profile::PcProfile& GetProfile() override;
+    const host_profile::HostProfile& GetHostProfile() override;
+
+    std::pair<cache::CacheStats, cache::CacheStats> GetCacheStats() override;
+    void DumpCache() override;
+    void SetLog(std::ostream& log) override;
+
+    AssembledProgram program_;
+
+private:
+    OooCore vm_core_;
+
+    void FillPipelineSnapshot(PipelineSnapshot& snapshot) override;
+};
+
+
+} // namespace ooo
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "vm_asm_mw.h"
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace pc_profile {
+
+/**
+ * @brief What the profile counts for one instruction (or, summed, for one source line).
+ */
+struct PcCounters {
+    uint64_t retired = 0;
+    uint64_t cycles = 0;       ///< cycles charged to the instruction, see PcProfile
+    uint64_t stall_cycles = 0; ///< the part of cycles in which nothing retired, cache stalls included
+    uint64_t mispredicts = 0;
+
+    PcCounters& operator+=(const PcCounters& other);
+};
+
+/**
+ * @brief The cycles of one cycle (it and the cache stalls it took) and the instruction they are charged to.
+ */
+struct CycleCharge {
+    uint64_t pc = 0;
+    bool charged = false; ///< false if there was nothing in flight to charge
+    uint64_t cycles = 0;
+    uint64_t stall_cycles = 0;
+};
+
+/**
+ * @brief Per-PC cycle profile of a core, one PcCounters per word of the text section.
+ *
+ * Every cycle is charged to one instruction: the oldest one that retired in it or, if nothing retired, the oldest
+ * one in flight, the instruction retirement is waiting on. A long latency op or a missing load thus shows up as stall
+ * cycles on itself, and the cycles of a loop's instructions add up to the time the loop takes.
+ */
+class PcProfile {
+public:
+    // sized to the text section and zeroed, on every load and reset
+    void Resize(uint64_t text_size);
+
+    void Retire(uint64_t pc) { if (PcCounters* counters = At(pc)) counters->retired++; }
+    void Mispredict(uint64_t pc) { if (PcCounters* counters = At(pc)) counters->mispredicts++; }
+    void Charge(const CycleCharge& charge);
+
+    void Add(uint64_t pc, const PcCounters& counters);
+    // for Undo(), takes back what was added
+    void Subtract(uint64_t pc, const PcCounters& counters);
+
+    const std::vector<PcCounters>& Counters() const { return counters_; }
+
+private:
+    std::vector<PcCounters> counters_; ///< indexed by pc / 4
+
+    PcCounters* At(uint64_t pc) { return pc / 4 < counters_.size() ? &counters_[pc / 4] : nullptr; }
+};
+
+/**
+ * @brief counters (as in PcProfile::Counters()) summed per source line of program, lines start at 1.
+ */
+std::map<unsigned int, PcCounters> ByLine(const std::vector<PcCounters>& counters, const AssembledProgram& program);
+
+/**
+ * @brief The profile report (vm_state/profile.json): every instruction that was charged anything, with its source
+ * line, then the source lines, hottest first.
+ */
+void DumpJson(std::ostream& os, const std::vector<PcCounters>& counters, const AssembledProgram& program,
+              uint64_t total_cycles);
+
+} // namespace pc_profile
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Flat, read only copy of the fields of an InstrContext the views draw. Fields a model does not have
+ * (nopped on the out of order models, illegal on the in order ones, ...) stay at their defaults.
+ */
+struct InstrSlot {
+    uint64_t pc = 0;
+    uint32_t instruction = 0;
+
+    uint8_t opcode = 0;
+    uint8_t funct2 = 0;
+    uint8_t funct3 = 0;
+    uint8_t funct5 = 0;
+    uint8_t funct7 = 0;
+
+    uint8_t rs1 = 0;
+    uint8_t rs2 = 0;
+    uint8_t frs3 = 0;
+    uint8_t rd = 0;
+
+    uint8_t mem_access_bytes = 0;
+    int32_t immediate = 0;
+
+    uint64_t rs1_value = 0;
+    uint64_t rs2_value = 0;
+    uint64_t frs1_value = 0;
+    uint64_t frs2_value = 0;
+    uint64_t frs3_value = 0;
+    uint64_t alu_out = 0;
+    uint64_t mem_out = 0;
+
+    bool reg_write = false;
+    bool reg_write_to_fpr = false;
+    bool mem_to_reg = false;
+    bool imm_to_alu = false;
+    bool mem_read = false;
+    bool mem_write = false;
+    bool mem_write_data_from_gpr = false;
+    bool sign_extend = false;
+    bool rs1_from_fprf = false;
+    bool rs2_from_fprf = false;
+    bool branch = false;
+
+    bool branch_predicted_taken = false;
+    bool uses_rs1 = false;
+    bool uses_rs2 = false;
+    bool uses_rs3 = false;
+    bool nopped = false;
+    bool bubbled = false;
+    bool illegal = false;
+    bool ready_to_exec = false;
+    bool ready_to_commit = false; ///< reorder buffer entries only
+
+    template <typename Context>
+    static InstrSlot From(const Context& instr) {
+        InstrSlot slot;
+        slot.pc = instr.pc;
+        slot.instruction = instr.instruction;
+
+        slot.opcode = instr.opcode;
+        slot.funct2 = instr.funct2;
+        slot.funct3 = instr.funct3;
+        slot.funct5 = instr.funct5;
+        slot.funct7 = instr.funct7;
+
+        slot.rs1 = instr.rs1;
+        slot.rs2 = instr.rs2;
+        slot.frs3 = instr.frs3;
+        slot.rd = instr.rd;
+
+        slot.mem_access_bytes = static_cast<uint8_t>(instr.mem_access_bytes);
+        slot.immediate = instr.immediate;
+
+        slot.rs1_value = instr.rs1_value;
+        slot.rs2_value = instr.rs2_value;
+        slot.frs1_value = instr.frs1_value;
+        slot.frs2_value = instr.frs2_value;
+        slot.frs3_value = instr.frs3_value;
+        slot.alu_out = instr.alu_out;
+        slot.mem_out = instr.mem_out;
+
+        slot.reg_write = instr.reg_write;
+        slot.reg_write_to_fpr = instr.reg_write_to_fpr;
+        slot.mem_to_reg = instr.mem_to_reg;
+        slot.imm_to_alu = instr.imm_to_alu;
+        slot.mem_read = instr.mem_read;
+        slot.mem_write = instr.mem_write;
+        slot.mem_write_data_from_gpr = instr.mem_write_data_from_gpr;
+        slot.sign_extend = instr.sign_extend;
+        slot.rs1_from_fprf = instr.rs1_from_fprf;
+        slot.rs2_from_fprf = instr.rs2_from_fprf;
+        slot.branch = instr.branch;
+
+        if constexpr (requires { instr.branch_predicted_taken; }) {
+            slot.branch_predicted_taken = instr.branch_predicted_taken;
+        }
+        if constexpr (requires { instr.uses_rs1; }) {
+            slot.uses_rs1 = instr.uses_rs1;
+            slot.uses_rs2 = instr.uses_rs2;
+            slot.uses_rs3 = instr.uses_rs3;
+        }
+        if constexpr (requires { instr.nopped; }) {
+            slot.nopped = instr.nopped;
+            slot.bubbled = instr.bubbled;
+        }
+        if constexpr (requires { instr.illegal; }) {
+            slot.illegal = instr.illegal;
+            slot.ready_to_exec = instr.ready_to_exec;
+        }
+        return slot;
+    }
+};
+
+/**
+ * @brief What the processor views draw of a model: its pipeline latches, reservation stations and reorder buffer,
+ * as InstrSlots laid out one section after the other in a single buffer.
+ *
+ * A VM refills its snapshot only when asked for it after its generation moved (see VmBase::GetPipelineSnapshot), and
+ * the buffer keeps its capacity across refills and copies, so once it has held the widest model nothing is
+ * allocated. The spans handed out stay valid until the next refill or assignment.
+ */
+class PipelineSnapshot {
+public:
+    enum class Section : size_t {
+        kPipeline,
+        kReservationStationAlu,
+        kReservationStationFalu,
+        kReservationStationLsu,
+        kReorderBuffer,
+        kCount
+    };
+
+    /**
+     * @brief Empties every section and stamps the snapshot with generation. Sections must then be pushed in order.
+     */
+    void Begin(uint64_t generation);
+
+    template <typename Context>
+    void Push(Section section, const Context& instr) {
+        Append(section, InstrSlot::From(instr));
+    }
+
+    template <typename Context>
+    void PushRobEntry(const Context& instr, bool ready_to_commit) {
+        InstrSlot slot = InstrSlot::From(instr);
+        slot.ready_to_commit = ready_to_commit;
+        Append(Section::kReorderBuffer, slot);
+    }
+
+    void SetRobHeadTail(std::pair<size_t, size_t> head_tail) { rob_head_tail_ = head_tail; }
+
+    uint64_t Generation() const { return generation_; }
+
+    std::span<const InstrSlot> Get(Section section) const;
+    std::span<const InstrSlot> Pipeline() const { return Get(Section::kPipeline); }
+    std::span<const InstrSlot> ReservationStationAlu() const { return Get(Section::kReservationStationAlu); }
+    std::span<const InstrSlot> ReservationStationFalu() const { return Get(Section::kReservationStationFalu); }
+    std::span<const InstrSlot> ReservationStationLsu() const { return Get(Section::kReservationStationLsu); }
+    std::span<const InstrSlot> ReorderBuffer() const { return Get(Section::kReorderBuffer); }
+    std::pair<size_t, size_t> RobHeadTail() const { return rob_head_tail_; }
+
+private:
+    struct Range {
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+
+    uint64_t generation_ = 0; ///< 0 never matches a VM, so a fresh snapshot is always stale
+    std::vector<InstrSlot> slots_;
+    std::array<Range, static_cast<size_t>(Section::kCount)> ranges_{};
+    std::pair<size_t, size_t> rob_head_tail_ = {0, 0};
+
+    void Append(Section section, const InstrSlot& slot);
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "vm_asm_mw.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pipeline_trace {
+
+/**
+ * @brief The stages an instruction goes through. A model records the stages it has, the 5 stage pipeline has no Issue
+ * or Complete and the out of order cores no Memory (the LSU is their Execute).
+ */
+enum class Stage : uint8_t {
+    Fetch,
+    Decode,
+    Issue,    ///< into a reservation station
+    Execute,  ///< onto a functional unit
+    Memory,
+    Complete, ///< result written to the ROB
+    Commit,   ///< retired in this cycle
+    Squash,   ///< dropped in this cycle, on the wrong path of a branch
+    Count,
+};
+
+constexpr size_t kNumStages = static_cast<size_t>(Stage::Count);
+
+/**
+ * @brief One instruction of the trace file, written once it committed or was squashed.
+ */
+struct InstrRecord {
+    uint64_t cycle; ///< the first cycle it was traced in, its fetch unless that was before the cycle window
+    uint32_t pc;
+    uint32_t seq;
+    std::array<uint16_t, kNumStages> entered; ///< per Stage, 1 + the cycles from cycle until it got there (at most
+                                              ///< kMaxEntered), 0 if never
+};
+static_assert(sizeof(InstrRecord) == 32, "the trace file is an array of InstrRecord");
+
+constexpr uint16_t kMaxEntered = 0xffff;
+
+/**
+ * @brief The [Trace] section.
+ */
+struct TraceConfig {
+    bool enabled = false;
+    uint64_t start_cycle = 0;
+    uint64_t end_cycle = 0;          ///< first cycle that isn't recorded, 0 for no end
+    uint64_t buffer_records = 1 << 14; ///< size of the ring the writer streams to the file, in instructions
+    std::filesystem::path file;        ///< where the trace goes, empty for vm_state/trace.bin
+
+    /**
+     * @brief Applies a trace_enabled, trace_start_cycle, trace_end_cycle, trace_buffer_records or trace_file key.
+     */
+    void Modify(const std::string& key, const std::string& value);
+
+    // file, or vm_state/trace.bin if it is empty
+    std::filesystem::path File() const;
+};
+
+/**
+ * @brief Traces the instructions of one core into its trace file (TraceConfig::File()): a header, then an InstrRecord
+ * per instruction in the order they committed or were squashed.
+ *
+ * Record() stamps the stage into a table of the instructions in flight, a commit or squash moves the instruction's
+ * InstrRecord into a ring of chunks that a writer thread streams to the file. If the writer falls a whole ring behind, the
+ * core waits for it rather than drop instructions. Only the first cycle of a stage counts, a stage may be recorded
+ * again every cycle it lasts. Instructions still in flight when the trace ends aren't written, Undo() doesn't take
+ * back what was written.
+ */
+class Tracer {
+public:
+    Tracer() = default;
+    ~Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // ends the trace that was going and, if config.enabled, starts a new one into config.File()
+    void Open(const TraceConfig& config);
+    // writes out what was traced so far, the trace goes on
+    void Flush();
+    void Close();
+
+    bool Enabled() const { return enabled_; }
+    bool InWindow(uint64_t cycle) const { return enabled_ && cycle >= start_cycle_ && cycle < end_cycle_; }
+
+    void Record(uint64_t cycle, Stage stage, uint32_t seq, uint64_t pc) {
+        if (!InWindow(cycle)) {
+            return;
+        }
+
+        // a Fetch of a seq that is in flight is the refetch of an undone instruction
+        InstrRecord& record = in_flight_[seq & (kMaxInFlight - 1)];
+        if (record.seq != seq || stage == Stage::Fetch) {
+            record = InstrRecord{cycle, static_cast<uint32_t>(pc), seq, {}};
+        }
+        uint16_t& entered = record.entered[static_cast<size_t>(stage)];
+        if (entered == 0 && cycle >= record.cycle) {
+            entered = static_cast<uint16_t>(std::min<uint64_t>(cycle - record.cycle + 1, kMaxEntered));
+        }
+
+        if (stage == Stage::Commit || stage == Stage::Squash) {
+            ring_[chunk_ * chunk_records_ + fill_] = record;
+            record.seq = seq + 1; // no other seq of this slot
+            if (++fill_ == chunk_records_) {
+                Publish();
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kNumChunks = 8;
+    static constexpr size_t kMaxInFlight = 4096; ///< power of 2, beyond the largest ROB
+
+    bool enabled_ = false;
+    uint64_t start_cycle_ = 0;
+    uint64_t end_cycle_ = 0;
+
+    std::vector<InstrRecord> in_flight_; ///< indexed by seq % kMaxInFlight
+    std::vector<InstrRecord> ring_;      ///< kNumChunks chunks of chunk_records_
+    size_t chunk_records_ = 0;
+    size_t chunk_ = 0; ///< the chunk being filled
+    size_t fill_ = 0;  ///< records in it
+
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // guarded by mutex_
+    std::array<size_t, kNumChunks> chunk_fill_{};
+    uint64_t published_ = 0; ///< chunks handed to the writer
+    uint64_t written_ = 0;   ///< chunks it has written
+    bool closing_ = false;
+
+    // hands the current chunk to the writer and moves on to the next one, once it is free
+    void Publish();
+    void WriterLoop();
+};
+
+/**
+ * @brief The text of each instruction of program, indexed by pc / 4, to label a converted trace with.
+ */
+std::vector<std::string> Disassembly(const AssembledProgram& program);
+
+/**
+ * @brief Converts a trace file to the Kanata log format the Konata pipeline viewer reads. labels may be empty, the
+ * instructions are then labelled by pc. Throws std::runtime_error if trace isn't a trace file.
+ *
+ * Kanata is ordered by cycle, the records are sorted by their first cycle in memory.
+ */
+void ConvertToKanata(std::istream& trace, std::ostream& os, const std::vector<std::string>& labels);
+
+/**
+ * @brief Converts a trace file to gem5's O3PipeView format (util/o3-pipeview.py, Konata reads it too). A cycle is
+ * kTicksPerCycle ticks, stages a model doesn't have get the tick of the stage before them.
+ */
+void ConvertToO3PipeView(std::istream& trace, std::ostream& os, const std::vector<std::string>& labels);
+
+constexpr uint64_t kTicksPerCycle = 1000;
+
+} // namespace pipeline_trace
@@ -0,0 +1,230 @@
+/**
+ * @file predecode_table.h
+ * @brief Contains the PredecodeTable, a per program cache of decoded instructions indexed by pc.
+ */
+
+#ifndef PREDECODE_TABLE_H
+#define PREDECODE_TABLE_H
+
+#include "vm/alu.h"
+#include "vm/instruction_context.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace predecode {
+
+/**
+ * @brief The fields of an instruction context that only depend on the instruction word.
+ *
+ * Register values, csr values and everything produced after decode are left out, those are read from the
+ * core every time the instruction executes.
+ */
+struct PredecodedInstr {
+    bool valid = false;
+    uint32_t instruction = 0;
+
+    alu::AluOp alu_op = alu::AluOp::kNone;
+    uint8_t opcode = 0;
+    uint8_t funct2 = 0;
+    uint8_t funct3 = 0;
+    uint8_t funct5 = 0;
+    uint8_t funct7 = 0;
+    bool auipc = false;
+
+    bool mem_to_reg = false;
+    bool imm_to_alu = false;
+    bool mem_read = false;
+    bool mem_write = false;
+    bool mem_write_data_from_gpr = false;
+    size_t mem_access_bytes = 0;
+    bool sign_extend = false;
+
+    bool reg_write = false;
+    bool reg_write_to_fpr = false;
+
+    uint8_t rs1 = 0;
+    uint8_t rs2 = 0;
+    uint8_t frs3 = 0;
+    uint8_t rd = 0;
+    bool rs1_from_fprf = false;
+    bool rs2_from_fprf = false;
+
+    int32_t immediate = 0;
+
+    uint16_t csr_rd = 0;
+    uint8_t csr_uimm = 0;
+    bool csr_op = false;
+
+    bool branch = false;
+
+    // only present in some of the models' contexts
+    bool uses_rs1 = false;
+    bool uses_rs2 = false;
+    bool uses_rs3 = false;
+    bool branch_jalr = false;
+    bool into_falu = false;
+};
+
+/**
+ * @brief Decoded instructions of the text section, one entry per word, filled lazily by the decode units.
+ *
+ * Stores into the text section invalidate the entries they overlap (MemoryController does this on every write).
+ * A hit also has to match the fetched instruction word: a store can land between the fetch and the decode of the
+ * instruction it overwrites, and the stale word must not be decoded back into the table.
+ */
+class PredecodeTable {
+public:
+    /**
+     * @brief Drops every entry and sizes the table for a text section of text_size bytes starting at address 0.
+     */
+    void Reset(uint64_t text_size) {
+        entries_.assign(text_size / 4, PredecodedInstr{});
+        text_size_ = entries_.size() * 4;
+        generation_++;
+    }
+
+    /**
+     * @brief Bumped every time the table is reset or a write lands in the text section. Other caches of the
+     * text section (the fast forward engine's blocks) compare it to know when to drop their contents.
+     */
+    uint64_t Generation() const {
+        return generation_;
+    }
+
+    /**
+     * @brief Invalidates the entries overlapping [address, address + num_bytes).
+     */
+    void Invalidate(uint64_t address, size_t num_bytes) {
+        if (address >= text_size_ || num_bytes == 0) {
+            return;
+        }
+        generation_++;
+        uint64_t last = address + num_bytes - 1;
+        if (last >= text_size_ || last < address) {
+            last = text_size_ - 1;
+        }
+        for (uint64_t index = address >> 2; index <= (last >> 2); ++index) {
+            entries_[index].valid = false;
+        }
+    }
+
+    /**
+     * @brief Fills the static fields of instr_context from the table.
+     * @return False if there is no valid entry for instr_context.pc and instr_context.instruction.
+     */
+    template <typename Context>
+    bool Lookup(Context& instr_context) const {
+        if (instr_context.pc >= text_size_ || (instr_context.pc & 0b11)) {
+            return false;
+        }
+        const PredecodedInstr& entry = entries_[instr_context.pc >> 2];
+        if (!entry.valid || entry.instruction != instr_context.instruction) {
+            return false;
+        }
+
+        instr_context.alu_op = entry.alu_op;
+        instr_context.opcode = entry.opcode;
+        instr_context.funct2 = entry.funct2;
+        instr_context.funct3 = entry.funct3;
+        instr_context.funct5 = entry.funct5;
+        instr_context.funct7 = entry.funct7;
+        instr_context.auipc = entry.auipc;
+        instr_context.mem_to_reg = entry.mem_to_reg;
+        instr_context.imm_to_alu = entry.imm_to_alu;
+        instr_context.mem_read = entry.mem_read;
+        instr_context.mem_write = entry.mem_write;
+        instr_context.mem_write_data_from_gpr = entry.mem_write_data_from_gpr;
+        instr_context.mem_access_bytes = entry.mem_access_bytes;
+        instr_context.sign_extend = entry.sign_extend;
+        instr_context.reg_write = entry.reg_write;
+        instr_context.reg_write_to_fpr = entry.reg_write_to_fpr;
+        instr_context.rs1 = entry.rs1;
+        instr_context.rs2 = entry.rs2;
+        instr_context.frs3 = entry.frs3;
+        instr_context.rd = entry.rd;
+        instr_context.rs1_from_fprf = entry.rs1_from_fprf;
+        instr_context.rs2_from_fprf = entry.rs2_from_fprf;
+        instr_context.immediate = entry.immediate;
+        instr_context.csr_rd = entry.csr_rd;
+        instr_context.csr_uimm = entry.csr_uimm;
+        instr_context.csr_op = entry.csr_op;
+        instr_context.branch = entry.branch;
+
+        if constexpr (requires { instr_context.uses_rs1; }) {
+            instr_context.uses_rs1 = entry.uses_rs1;
+            instr_context.uses_rs2 = entry.uses_rs2;
+            instr_context.uses_rs3 = entry.uses_rs3;
+        }
+        if constexpr (requires { instr_context.branch_jalr; }) {
+            instr_context.branch_jalr = entry.branch_jalr;
+        }
+        if constexpr (requires { instr_context.into_falu; }) {
+            instr_context.into_falu = entry.into_falu;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Records the static fields of a freshly decoded instr_context.
+     */
+    template <typename Context>
+    void Insert(const Context& instr_context) {
+        if (instr_context.pc >= text_size_ || (instr_context.pc & 0b11)) {
+            return;
+        }
+        PredecodedInstr& entry = entries_[instr_context.pc >> 2];
+
+        entry.valid = true;
+        entry.instruction = instr_context.instruction;
+        entry.alu_op = instr_context.alu_op;
+        entry.opcode = instr_context.opcode;
+        entry.funct2 = instr_context.funct2;
+        entry.funct3 = instr_context.funct3;
+        entry.funct5 = instr_context.funct5;
+        entry.funct7 = instr_context.funct7;
+        entry.auipc = instr_context.auipc;
+        entry.mem_to_reg = instr_context.mem_to_reg;
+        entry.imm_to_alu = instr_context.imm_to_alu;
+        entry.mem_read = instr_context.mem_read;
+        entry.mem_write = instr_context.mem_write;
+        entry.mem_write_data_from_gpr = instr_context.mem_write_data_from_gpr;
+        entry.mem_access_bytes = instr_context.mem_access_bytes;
+        entry.sign_extend = instr_context.sign_extend;
+        entry.reg_write = instr_context.reg_write;
+        entry.reg_write_to_fpr = instr_context.reg_write_to_fpr;
+        entry.rs1 = instr_context.rs1;
+        entry.rs2 = instr_context.rs2;
+        entry.frs3 = instr_context.frs3;
+        entry.rd = instr_context.rd;
+        entry.rs1_from_fprf = instr_context.rs1_from_fprf;
+        entry.rs2_from_fprf = instr_context.rs2_from_fprf;
+        entry.immediate = instr_context.immediate;
+        entry.csr_rd = instr_context.csr_rd;
+        entry.csr_uimm = instr_context.csr_uimm;
+        entry.csr_op = instr_context.csr_op;
+        entry.branch = instr_context.branch;
+
+        if constexpr (requires { instr_context.uses_rs1; }) {
+            entry.uses_rs1 = instr_context.uses_rs1;
+            entry.uses_rs2 = instr_context.uses_rs2;
+            entry.uses_rs3 = instr_context.uses_rs3;
+        }
+        if constexpr (requires { instr_context.branch_jalr; }) {
+            entry.branch_jalr = instr_context.branch_jalr;
+        }
+        if constexpr (requires { instr_context.into_falu; }) {
+            entry.into_falu = instr_context.into_falu;
+        }
+    }
+
+private:
+    std::vector<PredecodedInstr> entries_;
+    uint64_t text_size_ = 0;
+    uint64_t generation_ = 0;
+};
+
+} // namespace predecode
+
+#endif // PREDECODE_TABLE_H
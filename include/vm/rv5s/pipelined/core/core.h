@@ -2,19 +2,30 @@
 
 #include "./instruction_context/instruction_context.h"
 #include "../hardware/decode_unit.h"
-#include "../hardware/branch_predictor.h"
 #include "../hardware/hazard_detector.h"
 #include "../../../alu.h"
+#include "../../../branch_predictor.h"
 #include "../../../registers.h"
 #include "../../../memory_controller.h"
+#include "vm/fast_forward/engine.h"
+#include "vm/fu_latency.h"
+#include "vm/undo_ring.h"
+#include "vm/pipeline_trace.h"
+#include "vm/host_profile.h"
 #include "vm_asm_mw.h"
 #include "vm/vm_base.h"
+#include "sim_state.h"
 
 namespace rv5s{
     
 class PipelinedCore{
 public:
-    std::deque<PipelinedInstrContext> instruction_deque_;
+    static constexpr size_t kNumStages = 5;
+
+    // the stage latches, IF at latch_head_ and WB just before it. A cycle moves the head back one latch, the latch
+    // WB retires from is reused for the next IF instruction.
+    std::array<PipelinedInstrContext, kNumStages> latches_;
+    size_t latch_head_ = 0;
     uint64_t program_counter_{};
 
     bool hazard_detection_enabled_ = false;
@@ -25,20 +36,27 @@ public:
     
     bool is_stop_requested_ = false;
 
+    // the specialized cycle and run loop, picked by PipelinedExecutor::Specialize() from the flags above
+    void (*step_fn_)(PipelinedCore&) = nullptr;
+    void (*run_fn_)(PipelinedCore&) = nullptr;
+
     // Debug vars
-    bool debug_mode_{true};
-    std::deque<PipelinedInstrContext> undo_instruction_stack_;
+    UndoRing<PipelinedInstrContext> undo_instruction_stack_; ///< retired WB instructions, sized on load
     size_t max_undo_stack_size_{256};
-    bool stop_requested_ = false;
+    uint32_t next_seq_ = 0; ///< seq of the next fetched instruction
+    SeqTable<UndoRecord> undo_records_; ///< what each in flight or undoable instruction overwrote, keyed by seq
+    std::atomic<bool> stop_requested_{false}; ///< set from the GUI thread, cleared by ClearStop()
     std::vector<uint64_t> breakpoints_;
 
     // hardware
 	PipelinedDecodeUnit decode_unit_;
-  	BranchPredictor branch_predictor_;
+  	branch_predictor::BranchPredictor branch_predictor_;
     HazardDetector hazard_detector_;
     alu::Alu alu_;
+    fu_latency::LatencyTable latency_table_; ///< how long an op holds EX, from the [Latency] config
     register_file::RegisterFile register_file_;
     memory_controller::MemoryController memory_controller_;
+    fast_forward::FastForwardEngine fast_forward_engine_;
     
 
     // for input handling in syscalls:
@@ -49,6 +67,19 @@ public:
     uint64_t program_size_ = 0;
 
     VmBase::Stats core_stats_;
+    pc_profile::PcProfile profile_; ///< sized to the text section on load
+    pipeline_trace::Tracer trace_; ///< [Trace] events, a new trace on every load
+    host_profile::HostProfile host_profile_; ///< how fast the host simulates this core, reset on load
+    SimState sim_state_; ///< forwarding/hazard events for the GUI, written by the hazard detector
+    bool data_hazard_detected_ = false; ///< the previous cycle stalled on a load-use hazard
+
+    // what the core was loaded with, set by the model before it loads so that models with different configs can
+    // run side by side
+    vm_config::VmConfig config_;
+    std::ostream* log_ = &globals::vm_cout_file; ///< executor and syscall messages
+
+    std::ostream& Log() { return *log_; }
+    void SetLog(std::ostream& log);
 
     PipelinedCore();
 
@@ -61,9 +92,21 @@ public:
     PipelinedInstrContext& GetExInstruction();
     PipelinedInstrContext& GetMemInstruction();
     PipelinedInstrContext& GetWbInstruction();
+    PipelinedInstrContext& GetLatch(size_t stage);
+
+    // the cycles instr spends in EX, bubbles and nops pass in one
+    unsigned int ExCycles(const PipelinedInstrContext& instr) const;
+
+    // moves every instruction one stage on, the WB instruction is dropped. Returns the IF latch to fill.
+    PipelinedInstrContext& ShiftLatches();
+    // moves every instruction one stage back, the IF instruction is dropped. Returns the WB latch to fill.
+    PipelinedInstrContext& UnshiftLatches();
 
     void ClearStop();
 
+    // true once fetch has run past the program and the pipeline has drained
+    bool ProgramEnded();
+
     void Reset();
 
     void Load(AssembledProgram& program);
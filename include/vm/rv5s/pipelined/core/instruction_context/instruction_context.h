@@ -2,18 +2,21 @@
 
 #include "vm/alu.h"
 #include "vm/instruction_context.h"
+#include "vm/branch_predictor.h"
 
 namespace rv5s {
 
 struct PipelinedInstrContext : InstrContext{    
     PipelinedInstrContext() : InstrContext() {}
     PipelinedInstrContext(uint64_t pc) : InstrContext(pc) {}
-    ~PipelinedInstrContext() = default;
     
+    branch_predictor::BranchPrediction branch_prediction; // what the 'FETCH' stage predicted, for training and recovery
+
     // branch signals:
     bool branch_predicted_taken = false; // job of the 'FETCH' stage to update this. (For branch prediction)
     bool branch_taken = false; // job of the 'EXEC' stage to update this. (For branch prediction), checked by the DetectControlHazard() in hazard_detector_
-    bool branch_jalr = false; // jalr branch should not update btb / be used for prediction
+    bool branch_jalr = false;
+    bool branch_mispredicted = false; // set by the 'EXEC' stage, wrong direction or (jalr) wrong target
 
     bool uses_rs1 = false;
     bool uses_rs2 = false;
@@ -23,6 +26,9 @@ struct PipelinedInstrContext : InstrContext{
     bool nopped = false;
     bool bubbled = false;
 
+    // EX cycles the op still needs after the current one, set when it enters EX (see PipelinedCore::ExCycles())
+    uint8_t ex_cycles_left = 0;
+
     // convert this instruction to nop
     void nopify(){
         mem_read = false;
@@ -59,6 +65,7 @@ struct PipelinedInstrContext : InstrContext{
         branch = false;
         branch_predicted_taken = false;
         branch_taken = false;
+        branch_mispredicted = false;
         
         rs1 = 0;
         rs2 = 0;
@@ -95,4 +102,6 @@ struct PipelinedInstrContext : InstrContext{
     }
 };
 
+static_assert(std::is_trivially_copyable_v<PipelinedInstrContext>);
+
 } // namespace rv5s
\ No newline at end of file
@@ -3,18 +3,35 @@
 #include "utils.h"
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <functional>
 
 namespace rv5s{
 
 class PipelinedExecutor{
 public:
+    /**
+     * @brief Picks the stage instantiations for the core's hazard detection, forwarding and branch prediction flags.
+     * To be called whenever the core is loaded, Run/Step don't look at the flags again. Run uses the non-debug
+     * instantiation (no undo records), Step and DebugRun the debug one.
+     */
+    static void Specialize(PipelinedCore& vm_core);
+
     static void RunPipelined(PipelinedCore& vm_core);
 
-    static void DebugRunPipelined(PipelinedCore& vm_core);
+    // steps until a breakpoint is fetched, calling after_step after each step, the run ends once it gives false
+    static void DebugRunPipelined(PipelinedCore& vm_core, const std::function<bool()>& after_step);
 
     static void StepPipelined(PipelinedCore& vm_core);
 
     static void UndoPipelined(PipelinedCore& vm_core);
+
+    /**
+     * @brief Runs up to num_instrs instructions on the functional fast forward engine, only possible while the
+     * pipeline is empty (before the first cycle). Stats are not updated.
+     * @return The number of instructions retired.
+     */
+    static uint64_t FastForwardPipelined(PipelinedCore& vm_core, uint64_t num_instrs);
     
 };
 
@@ -6,6 +6,7 @@
 #include "vm/alu.h"
 #include "../core/instruction_context/instruction_context.h"
 #include "vm/registers.h"
+#include "vm/predecode_table.h"
 
 
 namespace rv5s
@@ -19,9 +20,10 @@ public:
     ~PipelinedDecodeUnit() = default;
 
     /**
-     * @brief 
+     * @brief DecodeInstruction decodes instr_context, taking the static fields from predecode_table when it has them,
+     * and reads the source registers.
      */
-    void DecodeInstruction(PipelinedInstrContext& instr_context, register_file::RegisterFile& rf);
+    void DecodeInstruction(PipelinedInstrContext& instr_context, register_file::RegisterFile& rf, predecode::PredecodeTable& predecode_table);
     
 private:
     /**
@@ -31,11 +33,11 @@ private:
     void DecodeInstrFields(PipelinedInstrContext& instr_context);
 
     /**
-     * @brief SetRegImmValues sets the register values and generates the immediate. Simulates fetching from the register file
+     * @brief SetRegValues sets the register values. Simulates fetching from the register file
      * @param instr_context The instruction being decoded.
      * @param rf The register file of the vm
      */
-    void SetRegImmValues(PipelinedInstrContext& instr_context, register_file::RegisterFile& rf);
+    void SetRegValues(PipelinedInstrContext& instr_context, register_file::RegisterFile& rf);
 
     /**
      * @brief SetControlSignals sets the alu flags, mux select line flags.
@@ -3,15 +3,19 @@
 namespace rv5s {
 class PipelinedCore;
 
+// specialized on the core flags like the stages, instantiated for both values in hazard_detector.cpp
 class HazardDetector {    
 public:
 
+    template<bool kForwarding>
     bool DetectDataHazard(PipelinedCore& vm_core);
 
+    template<bool kBranchPrediction>
     void HandleDataHazard(PipelinedCore& vm_core);
 
     bool DetectControlHazard(PipelinedCore& vm_core);
 
+    template<bool kBranchPrediction>
     void HandleControlHazard(PipelinedCore& vm_core);
     
 private:
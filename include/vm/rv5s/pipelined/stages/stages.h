@@ -3,16 +3,26 @@
 
 namespace rv5s{
 
+/**
+ * The stages are specialized on the core flags they read, the executor picks the instantiation once when the core
+ * is loaded so none of these are checked per cycle. kDebug builds the undo records (overwritten memory, registers
+ * and csrs), the non-debug instantiations compile that out.
+ * Instantiated for both values of their flag in the stage's translation unit.
+ */
 class PipelinedStages{
 public:
+    template<bool kBranchPrediction>
     static void Fetch(PipelinedCore& vm_core);
 
     static void Decode(PipelinedCore& vm_core);
 
+    template<bool kBranchPrediction>
     static void Execute(PipelinedCore& vm_core);
 
+    template<bool kDebug>
     static void MemoryAccess(PipelinedCore& vm_core);
 
+    template<bool kDebug>
     static void WriteBack(PipelinedCore& vm_core);
 
 
@@ -20,11 +30,13 @@ private:
     // FIXME: this doesn't belong here
     static void HandleSyscall(PipelinedCore& vm_core);
 
+    template<bool kBranchPrediction>
     static void ResolveBranch(PipelinedCore& vm_core);
     static void ExecuteBasic(PipelinedCore& vm_core);
     static void ExecuteFloat(PipelinedCore& vm_core);
     static void ExecuteDouble(PipelinedCore& vm_core);
 
+    template<bool kDebug>
     static void WriteBackCsr(PipelinedCore& vm_core);
 };
 
@@ -9,7 +9,8 @@ namespace rv5s{
 
 class PipelinedVM : public VmBase {
 public:
-    PipelinedVM();
+    // the model keeps its own copy of config, so models built from different configs can run side by side
+    explicit PipelinedVM(const vm_config::VmConfig& config = vm_config::config);
 
     void Reset() override;
 
@@ -24,23 +25,38 @@ public:
 
     void Undo() override;
 
+    void SetBreakpoints(const std::vector<uint64_t>& pcs) override;
+
+    void RequestStop() override;
+    void ClearStop() override;
+    bool ProgramEnded() override;
+
+    uint64_t FastForward(uint64_t num_instrs) override;
+
     uint64_t ReadMemDoubleWord(uint64_t address) override;
 
     const std::array<uint64_t, 32>& GetGprValues() override;
     const std::array<uint64_t, 32>& GetFprValues() override;
 
     std::vector<uint64_t> GetInstructionPCs() override;
-    InstrView GetInstructions() override;
-
     bool ForwardingEnabled();
     bool HazardEnabled();
 
     VmBase::Stats& GetStats() override;
+    const pc_profile::PcProfile& GetProfile() override;
+    const host_profile::HostProfile& GetHostProfile() override;
+
+    std::pair<cache::CacheStats, cache::CacheStats> GetCacheStats() override;
+    void DumpCache() override;
+    void SetLog(std::ostream& log) override;
+    SimState& GetSimState() override;
 
     AssembledProgram program_;
 
 private:
     PipelinedCore vm_core_;
+
+    void FillPipelineSnapshot(PipelineSnapshot& snapshot) override;
 };
 
 
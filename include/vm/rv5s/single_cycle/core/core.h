@@ -5,8 +5,12 @@
 #include "../../../alu.h"
 #include "../../../registers.h"
 #include "../../../memory_controller.h"
+#include "vm/fast_forward/engine.h"
 #include "vm_asm_mw.h"
 #include "vm/vm_base.h"
+#include "vm/undo_ring.h"
+#include "vm/pipeline_trace.h"
+#include "vm/host_profile.h"
 
 namespace rv5s{
     
@@ -20,7 +24,9 @@ public:
     bool debug_mode_{true};
     std::deque<SingleCycleInstrContext> undo_instruction_stack_;
     size_t max_undo_stack_size_{256};
-    bool stop_requested_ = false;
+    uint32_t next_seq_ = 0; ///< seq of the next fetched instruction
+    SeqTable<UndoRecord> undo_records_; ///< what each undoable instruction overwrote, keyed by seq
+    std::atomic<bool> stop_requested_{false}; ///< set from the GUI thread, cleared by ClearStop()
     std::vector<uint64_t> breakpoints_;
 
     // hardware
@@ -28,6 +34,7 @@ public:
     alu::Alu alu_;
     register_file::RegisterFile register_file_;
     memory_controller::MemoryController memory_controller_;
+    fast_forward::FastForwardEngine fast_forward_engine_;
 
     // for input handling in syscalls:
 	std::mutex input_mutex_;
@@ -37,6 +44,17 @@ public:
     uint64_t program_size_ = 0;
 
     VmBase::Stats core_stats_;
+    pc_profile::PcProfile profile_; ///< sized to the text section on load
+    pipeline_trace::Tracer trace_; ///< [Trace] events, a new trace on every load
+    host_profile::HostProfile host_profile_; ///< how fast the host simulates this core, reset on load
+
+    // what the core was loaded with, set by the model before it loads so that models with different configs can
+    // run side by side
+    vm_config::VmConfig config_;
+    std::ostream* log_ = &globals::vm_cout_file; ///< executor and syscall messages
+
+    std::ostream& Log() { return *log_; }
+    void SetLog(std::ostream& log);
 
     SingleCycleCore();
 
@@ -48,6 +66,8 @@ public:
 
     void ClearStop();
 
+    bool ProgramEnded() const;
+
     void Reset();
 
     void Load(AssembledProgram& program);
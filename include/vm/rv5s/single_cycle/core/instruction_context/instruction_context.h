@@ -7,7 +7,6 @@ namespace rv5s {
 struct SingleCycleInstrContext : InstrContext{   
     SingleCycleInstrContext() : InstrContext() {}
     SingleCycleInstrContext(uint64_t pc) : InstrContext(pc) {}
-    ~SingleCycleInstrContext() = default;
     
     void reset_id_vars(){
         alu_op = alu::AluOp::kNone;
@@ -57,4 +56,6 @@ struct SingleCycleInstrContext : InstrContext{
         fcsr_update = false;
     }
 };
+
+static_assert(std::is_trivially_copyable_v<SingleCycleInstrContext>);
 } // namespace rv5s
\ No newline at end of file
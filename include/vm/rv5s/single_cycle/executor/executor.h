@@ -3,6 +3,8 @@
 #include "utils.h"
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <functional>
 
 namespace rv5s{
 
@@ -10,11 +12,20 @@ class SingleCycleExecutor{
 public:
     static void RunSingleCycle(SingleCycleCore& vm_core);
 
-    static void DebugRunSingleCycle(SingleCycleCore& vm_core);
+    // steps until a breakpoint pc is next, calling after_step after each step, the run ends once it gives false
+    static void DebugRunSingleCycle(SingleCycleCore& vm_core, const std::function<bool()>& after_step);
 
     static void StepSingleCycle(SingleCycleCore& vm_core, bool dump);
 
     static void UndoSingleCycle(SingleCycleCore& vm_core);
+
+    /**
+     * @brief Runs up to num_instrs instructions on the functional fast forward engine. Stats are not updated.
+     * @param retired_at If given, counts the retirements of each instruction (see FastForwardEngine::Run()).
+     * @return The number of instructions retired.
+     */
+    static uint64_t FastForwardSingleCycle(SingleCycleCore& vm_core, uint64_t num_instrs,
+                                           std::vector<uint64_t>* retired_at = nullptr);
 };
 
 
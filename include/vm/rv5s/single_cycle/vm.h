@@ -9,7 +9,8 @@ namespace rv5s{
 
 class SingleCycleVM : public VmBase{
 public:
-    SingleCycleVM();
+    // the model keeps its own copy of config, so models built from different configs can run side by side
+    explicit SingleCycleVM(const vm_config::VmConfig& config = vm_config::config);
 
     void Reset() override;
 
@@ -24,20 +25,34 @@ public:
 
     void Undo() override;
 
+    void SetBreakpoints(const std::vector<uint64_t>& pcs) override;
+
+    void RequestStop() override;
+    void ClearStop() override;
+    bool ProgramEnded() override;
+
+    uint64_t FastForward(uint64_t num_instrs) override;
+
     uint64_t ReadMemDoubleWord(uint64_t address) override;
 
     const std::array<uint64_t, 32>& GetGprValues() override;
     const std::array<uint64_t, 32>& GetFprValues() override;
 
     std::vector<uint64_t> GetInstructionPCs() override;
-    InstrView GetInstructions() override;
-
     VmBase::Stats& GetStats() override;
+    const pc_profile::PcProfile& GetProfile() override;
+    const host_profile::HostProfile& GetHostProfile() override;
+
+    std::pair<cache::CacheStats, cache::CacheStats> GetCacheStats() override;
+    void DumpCache() override;
+    void SetLog(std::ostream& log) override;
 
     AssembledProgram program_;
 
 private:
     SingleCycleCore vm_core_;
+
+    void FillPipelineSnapshot(PipelineSnapshot& snapshot) override;
 };
 
 
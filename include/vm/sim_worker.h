@@ -0,0 +1,182 @@
+/**
+ * @file sim_worker.h
+ * @brief Contains the SimWorker, which runs the VM on its own thread for the GUI.
+ */
+
+#ifndef SIM_WORKER_H
+#define SIM_WORKER_H
+
+#include "vm/vm_main.h"
+#include "command_handler.h"
+#include "sim_state.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sim_worker {
+
+/**
+ * @brief Everything the GUI draws, copied out of the VM by the worker thread.
+ */
+struct SimSnapshot {
+    uint64_t version = 0; ///< bumped on every publish
+    bool busy = false;    ///< the worker was in the middle of a command when this was published
+
+    VM::Which type = VM::Which::SingleCycle;
+    bool pipelining_enabled = false;
+    bool forwarding_enabled = false;
+    bool hazard_enabled = false;
+    bool program_ended = false;
+
+    std::array<uint64_t, 32> gpr = {};
+    std::array<uint64_t, 32> fpr = {};
+    VmBase::Stats stats{};
+    std::pair<cache::CacheStats, cache::CacheStats> cache_stats;
+    std::vector<pc_profile::PcCounters> profile; ///< per pc, see pc_profile::PcProfile
+
+    std::vector<uint64_t> instruction_pcs;
+    PipelineSnapshot pipeline; ///< copied only when the model's generation moved, into the capacity it already has
+
+    // Only ever touched by the GUI thread once loaded, both buffers share it
+    std::shared_ptr<AssembledProgram> program;
+    uint64_t loads = 0;       ///< number of LOAD commands handled
+    bool load_failed = false; ///< the last LOAD did not assemble
+
+    uint64_t memory_start = 0;
+    std::vector<uint64_t> memory; ///< double words from memory_start
+
+    // the event flags the models raised since the previous publish, the GUI clears them once drawn
+    SimState sim_state;
+};
+
+/**
+ * @brief Owns the VM and runs it on a worker thread fed by a queue of command_handler::Commands.
+ *
+ * The GUI posts commands and reads the VM only through snapshots. There are two snapshot buffers: the worker fills
+ * the back one without any lock, then flips it to the front under snapshot_mutex_. The GUI holds that mutex while it
+ * builds a frame (AcquireSnapshot), so the worker blocks on a flip for at most one frame and a run never waits on
+ * the render loop otherwise. During runs snapshots are published at most every kPublishInterval.
+ *
+ * Handled commands (args in brackets):
+ *  - LOAD [file]: assembles and loads the file.
+ *  - MODIFY_CONFIG: rebuilds the VM from vm_config::config (after the processor selection changed).
+ *  - RUN: full speed run, published once it returns.
+ *  - DEBUG_RUN: VM::DebugRun() with run_step_delay between steps, publishing as it goes. Stops at breakpoints.
+ *  - ADD_BREAKPOINT, REMOVE_BREAKPOINT [address].
+ *  - STEP, UNDO, RESET, DUMP_CACHE, DUMP_PROFILE.
+ *  - GET_MEMORY_POINT [address, rows]: moves the memory window of the snapshot. The window is taken at Post() so it
+ *    also moves under a running command, the queued command only republishes.
+ *    Rows past the end of guest memory show as 0.
+ *  - EXIT: ends the thread.
+ *
+ * STOP is not queued: Stop() drops every pending command and stops the running one at its next cycle boundary.
+ * A command that throws (a guest access out of memory) is logged to vm_cout_file, the VM stays where it stopped.
+ */
+class SimWorker {
+public:
+    static constexpr std::chrono::milliseconds kPublishInterval{16};
+
+    /**
+     * @brief The front snapshot, locked for as long as the view lives.
+     */
+    class SnapshotView {
+    public:
+        SnapshotView(std::unique_lock<std::mutex> lock, SimSnapshot& snapshot)
+            : lock_(std::move(lock)), snapshot_(&snapshot) {}
+
+        SimSnapshot& operator*() const { return *snapshot_; }
+        SimSnapshot* operator->() const { return snapshot_; }
+        SimSnapshot* get() const { return snapshot_; }
+
+    private:
+        std::unique_lock<std::mutex> lock_;
+        SimSnapshot* snapshot_;
+    };
+
+    SimWorker() = default;
+    ~SimWorker();
+
+    SimWorker(const SimWorker&) = delete;
+    SimWorker& operator=(const SimWorker&) = delete;
+
+    /**
+     * @brief Builds the VM from the current config, publishes a first snapshot and starts the thread.
+     */
+    void Start();
+
+    /**
+     * @brief Stops whatever is running and joins the thread. Not to be called while holding a SnapshotView.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Queues a command. STOP and EXIT are handled right away (see Stop() and Shutdown()).
+     */
+    void Post(const command_handler::Command& command);
+    void Post(command_handler::CommandType type, const std::vector<std::string>& args = {});
+
+    /**
+     * @brief Drops the queued commands and stops the running one.
+     */
+    void Stop();
+
+    /**
+     * @brief True while a command is running or queued.
+     */
+    bool Busy() const;
+
+    SnapshotView AcquireSnapshot();
+
+private:
+    struct PendingCommand {
+        command_handler::Command command;
+        uint64_t stop_epoch; ///< stop_epoch_ when the command was posted, a Stop() since cancels it
+        // vm_config::config when the command was posted, the GUI thread may change it while the command runs
+        uint64_t step_limit = 0;
+        uint64_t step_delay_ms = 0;
+    };
+
+    VM vm_;
+
+    std::thread thread_;
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<PendingCommand> queue_;
+    bool exit_requested_ = false;
+    std::atomic<bool> running_command_{false};
+
+    // Stop() bumps the epoch before setting the VM's stop flag, the worker clears the flag before comparing epochs
+    std::atomic<uint64_t> stop_epoch_{0};
+    std::mutex vm_mutex_; ///< held while vm_ swaps its model (LOAD, MODIFY_CONFIG), so Stop() never sees it half built
+
+    std::array<SimSnapshot, 2> snapshots_;
+    size_t front_ = 0;
+    std::mutex snapshot_mutex_;
+    std::chrono::steady_clock::time_point last_publish_;
+
+    std::shared_ptr<AssembledProgram> program_ = std::make_shared<AssembledProgram>();
+    uint64_t loads_ = 0;
+    bool load_failed_ = false;
+    std::atomic<uint64_t> memory_start_{0};
+    std::atomic<size_t> memory_rows_{32};
+
+    void ThreadMain();
+    void Execute(const PendingCommand& pending);
+    void DebugRun(const PendingCommand& pending);
+    bool Stopped(uint64_t stop_epoch) const;
+
+    void Publish(bool busy);
+    void PublishThrottled();
+};
+
+} // namespace sim_worker
+
+#endif // SIM_WORKER_H
@@ -0,0 +1,97 @@
+/**
+ * @file sweep.h
+ * @brief Contains the configuration sweep: every workload run on every point of a config grid, in parallel.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "vm/vm_main.h"
+#include "config.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sweep {
+
+/**
+ * @brief An assembled program and the name it is reported under.
+ */
+struct Workload {
+    std::string name;
+    AssembledProgram program;
+    uint64_t output = 0; ///< where the program leaves the address and length of its output, 0 if it has none
+};
+
+/**
+ * @brief One point of the grid. The axes are kept next to the config they were applied to for the CSV.
+ */
+struct ConfigPoint {
+    std::string model;
+    std::string branch_prediction;
+    size_t reservation_station_size = 0;
+    size_t rob_size = 0;
+    size_t cdb_width = 0;
+    vm_config::VmConfig config;
+};
+
+/**
+ * @brief The axes of the grid. Every combination becomes one ConfigPoint, except that the window sizes are only
+ * crossed with the out of order models (dual, triple), the in order ones get a single point per predictor.
+ *
+ * An empty axis keeps what the base config has (e.g. from an ini file), a given one overrides it.
+ */
+struct ConfigGrid {
+    std::vector<std::string> models = {"single"}; ///< single, pipelined, pipelined-hazard, pipelined-forwarding, dual, triple
+    std::vector<std::string> branch_predictions; ///< none, static, bimodal, gshare, tournament
+    std::vector<size_t> reservation_station_sizes;
+    std::vector<size_t> rob_sizes; ///< 0 for the model default
+    std::vector<size_t> cdb_widths; ///< 0 for unlimited
+
+    /**
+     * @brief Every point of the grid, as base with the axes of the point applied.
+     * @throws std::invalid_argument On an unknown model or branch prediction, or a window size the config rejects.
+     */
+    std::vector<ConfigPoint> Expand(const vm_config::VmConfig& base) const;
+};
+
+/**
+ * @brief What one (workload, point) job left behind. error is set instead of the stats when the run threw.
+ *
+ * The checksums are FNV-1a, over the integer and then the floating point registers, and over the output bytes of
+ * the workload (0 without one).
+ */
+struct JobResult {
+    VmBase::Stats stats;
+    std::pair<cache::CacheStats, cache::CacheStats> cache_stats;
+    bool ended = false; ///< ran off the end of the program, rather than into the limit
+    uint64_t reg_checksum = 0;
+    uint64_t mem_checksum = 0;
+    double host_seconds = 0.0;
+    std::string error;
+};
+
+/**
+ * @brief Runs every workload on every point, on num_threads threads (all host cores for 0).
+ *
+ * Each job builds its own VM from the config of its point and logs to nowhere, the jobs share nothing but the
+ * (read only) workloads. Workloads have to be assembled before, the assembler still works on vm_config::config
+ * and the vm_state files. With [Trace] enabled, job j traces into <trace file stem>_<j><extension> next to the
+ * configured trace file.
+ *
+ * @return One result per job, workload major: the result of workload w on point p is at w*points.size() + p.
+ */
+std::vector<JobResult> Run(const std::vector<Workload>& workloads, const std::vector<ConfigPoint>& points,
+                           unsigned int num_threads = 0);
+
+/**
+ * @brief Writes the results of Run() as one CSV, a header line and one row per job in job order.
+ */
+void WriteCsv(std::ostream& os, const std::vector<Workload>& workloads, const std::vector<ConfigPoint>& points,
+              const std::vector<JobResult>& results);
+
+} // namespace sweep
+
+#endif // SWEEP_H
@@ -0,0 +1,101 @@
+/**
+ * @file undo_ring.h
+ * @brief Contains the UndoRing, a fixed capacity stack of undo records that drops its oldest record when full, and
+ * the SeqTable, a side table of per instruction records indexed by sequence number.
+ */
+
+#ifndef UNDO_RING_H
+#define UNDO_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The last Capacity() records pushed, newest first.
+ *
+ * The storage is allocated by Reserve() (on load) and never again, Push() overwrites the oldest record once the ring
+ * is full, so recording an undo step every cycle doesn't allocate.
+ */
+template <typename T>
+class UndoRing {
+public:
+    /**
+     * @brief Drops every record and sizes the ring for capacity records, each a copy of prototype. A record holding
+     * containers should get a prototype with the capacities it will need, so overwriting it never allocates.
+     */
+    void Reserve(size_t capacity, const T& prototype = T{}) {
+        records_.assign(capacity, prototype);
+        top_ = 0;
+        size_ = 0;
+    }
+
+    void Push(const T& record) {
+        if (records_.empty())
+            return;
+        top_ = (top_ + 1) % records_.size();
+        records_[top_] = record;
+        if (size_ < records_.size())
+            size_++;
+    }
+
+    // like Push(), but hands out the slot of the new record (still holding whatever record was there) for the caller
+    // to overwrite in place, the ring must have a capacity
+    T& PushSlot() {
+        top_ = (top_ + 1) % records_.size();
+        if (size_ < records_.size())
+            size_++;
+        return records_[top_];
+    }
+
+    // the newest record, the ring must not be empty
+    T& Top() { return records_[top_]; }
+
+    void Pop() {
+        top_ = (top_ + records_.size() - 1) % records_.size();
+        size_--;
+    }
+
+    void Clear() { size_ = 0; }
+
+    bool Empty() const { return size_ == 0; }
+    size_t Size() const { return size_; }
+    size_t Capacity() const { return records_.size(); }
+
+private:
+    std::vector<T> records_;
+    size_t top_ = 0;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief One record per instruction, indexed by the instruction's seq, for the last Capacity() sequence numbers.
+ *
+ * Keeps the records the hot instruction contexts don't carry (what they overwrote, for undo). The capacity is a
+ * power of two of at least the requested number of live instructions, and seq simply wraps around it: the record of
+ * an instruction is valid as long as fewer than Capacity() instructions were fetched after it.
+ */
+template <typename T>
+class SeqTable {
+public:
+    /**
+     * @brief Drops every record and sizes the table for at least live_instrs instructions in flight or undoable.
+     */
+    void Reserve(size_t live_instrs) {
+        size_t capacity = 1;
+        while (capacity < live_instrs)
+            capacity <<= 1;
+        records_.assign(capacity, T{});
+        mask_ = capacity - 1;
+    }
+
+    T& operator[](uint64_t seq) { return records_[seq & mask_]; }
+
+    size_t Capacity() const { return records_.size(); }
+
+private:
+    std::vector<T> records_ = std::vector<T>(1); ///< a single shared record until Reserve()
+    size_t mask_ = 0;
+};
+
+#endif // UNDO_RING_H
@@ -2,10 +2,16 @@
 #include "registers.h"
 #include "memory_controller.h"
 #include "alu.h"
+#include "cache/cache.h"
+#include "branch_predictor.h"
+#include "pc_profile.h"
+#include "host_profile.h"
 
 #include "./instruction_context.h"
+#include "./pipeline_snapshot.h"
 
 #include "vm_asm_mw.h"
+#include "sim_state.h"
 
 #include <vector>
 #include <string>
@@ -15,6 +21,10 @@
 #include <condition_variable>
 #include <queue>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <thread>
 
 enum SyscallCode {
     SYSCALL_PRINT_INT = 1,
@@ -29,25 +39,39 @@ enum SyscallCode {
 
 class VmBase {
 public:
-    struct InstrView{
-        std::vector<std::unique_ptr<const InstrContext>> pipeline;
-        std::vector<std::unique_ptr<const InstrContext>> reservation_station_alu;
-        std::vector<std::unique_ptr<const InstrContext>> reservation_station_falu;
-        std::vector<std::unique_ptr<const InstrContext>> reservation_station_lsu;
-        std::vector<std::unique_ptr<const InstrContext>> reorder_buffer;
-        std::vector<bool> rob_status;
-        std::pair<size_t, size_t> rob_head_tail;
+    /**
+     * Top-down accounting: every issue slot of every cycle (width slots a cycle) goes to exactly one category. An
+     * instruction's slot is counted once it retires or is squashed, so mid-run the in flight ones are missing.
+     */
+    struct TopDown{
+        size_t retiring = 0; ///< slots of instructions that retired
+        size_t frontend_bound = 0; ///< slots fetch/decode left empty, I-cache misses included
+        size_t bad_speculation = 0; ///< slots of squashed instructions and the empty ones while refilling after a squash
+        size_t backend_bound = 0; ///< slots the backend couldn't take: hazard stalls, full stations/ROB/LSQ, busy units, D-cache misses
+
+        size_t Slots() const { return retiring + frontend_bound + bad_speculation + backend_bound; }
     };
 
     struct Stats{
-        size_t cycles;
-        size_t instrs_retired;
-        size_t branch_instrs;
-        size_t branch_mispredicts;
+        size_t cycles = 0;
+        size_t instrs_retired = 0;
+        size_t branch_instrs = 0;
+        size_t branch_mispredicts = 0;
+        branch_predictor::MispredictBreakdown mispredicts; ///< branch_mispredicts by predictor component
+        size_t store_forwards = 0; ///< loads that took their value from an uncommitted store (out of order cores)
+        TopDown top_down;
+
+        // one cycle plus the cycles the caches stalled it for, the model has already counted the slots of the cycle
+        // itself. A stalled cycle's slots go to the frontend (I-cache) or to the backend (D-cache)
+        void AddCycle(size_t width, const memory_controller::StallCycles& stalls){
+            cycles += 1 + stalls.Total();
+            top_down.frontend_bound += stalls.fetch * width;
+            top_down.backend_bound += stalls.data * width;
+        }
     };
 
 
-    VmBase() = default;
+    VmBase() : generation_(NextGeneration()) {}
     virtual ~VmBase() = default;
 
     virtual void Reset() = 0;
@@ -56,17 +80,91 @@ public:
     virtual void LoadVM(AssembledProgram program) = 0;
 
     virtual void Run() = 0;
+    // steps until a breakpoint, the end of the program, the instruction execution limit or a stop, see SetDebugStepHook()
     virtual void DebugRun() = 0;
     virtual void Step() = 0;
     virtual void Undo() = 0;
 
+    // DebugRun() stops before an instruction at one of pcs
+    virtual void SetBreakpoints(const std::vector<uint64_t>& pcs) = 0;
+
+    // Called by DebugRun() after every step in place of sleeping run_step_delay, DebugRun() returns once it gives
+    // false. An empty hook (the default) sleeps.
+    using DebugStepHook = std::function<bool()>;
+    void SetDebugStepHook(DebugStepHook hook){ debug_step_hook_ = std::move(hook); }
+
+    // Stop is sticky: Run/DebugRun return at the next cycle boundary until ClearStop() is called.
+    // RequestStop() is safe to call from another thread while Run() is going.
+    virtual void RequestStop() = 0;
+    virtual void ClearStop() = 0;
+
+    // true once the program has run off the end of the text section and the model has drained
+    virtual bool ProgramEnded() = 0;
+
+    // runs up to num_instrs instructions functionally (no timing), returns how many retired
+    virtual uint64_t FastForward(uint64_t num_instrs) = 0;
+
     virtual uint64_t ReadMemDoubleWord(uint64_t address) = 0;
 
     virtual const std::array<uint64_t, 32>& GetGprValues() = 0;
     virtual const std::array<uint64_t, 32>& GetFprValues() = 0;
 
     virtual std::vector<uint64_t> GetInstructionPCs() = 0;
-    virtual InstrView GetInstructions() = 0;
+
+    // The pipeline latches, reservation stations and reorder buffer, refilled only if the model changed since the
+    // last call. Generations are unique across VM instances, so a snapshot copied out of a model that was since
+    // replaced never looks current.
+    uint64_t Generation() const { return generation_; }
+    const PipelineSnapshot& GetPipelineSnapshot(){
+        if(pipeline_snapshot_.Generation()!=generation_){
+            pipeline_snapshot_.Begin(generation_);
+            FillPipelineSnapshot(pipeline_snapshot_);
+        }
+        return pipeline_snapshot_;
+    }
 
     virtual Stats& GetStats() = 0;
+
+    // cycles, retirements and mispredicts per instruction, see pc_profile::PcProfile
+    virtual const pc_profile::PcProfile& GetProfile() = 0;
+
+    // host time of the Run() calls since load, and of each stage if built with VM_HOST_PROFILE
+    virtual const host_profile::HostProfile& GetHostProfile() = 0;
+
+    // {I-cache, D-cache}
+    virtual std::pair<cache::CacheStats, cache::CacheStats> GetCacheStats() = 0;
+    virtual void DumpCache() = 0;
+
+    // where the model writes its messages (program ended, syscalls, cache status), globals::vm_cout_file by default
+    virtual void SetLog(std::ostream& log) = 0;
+
+    // events the GUI lights up (steps, forwarding, hazards), set by the model and cleared by whoever draws them
+    virtual SimState& GetSimState(){ return sim_state_; }
+
+protected:
+    SimState sim_state_;
+
+    // to be called by everything that can change what GetPipelineSnapshot() shows
+    void BumpGeneration(){ generation_ = NextGeneration(); }
+
+    virtual void FillPipelineSnapshot(PipelineSnapshot& snapshot) = 0;
+
+    // what DebugRun() does after every step: the model changed, then the hook or the step delay
+    bool AfterDebugStep(uint64_t delay_ms){
+        BumpGeneration();
+        if(debug_step_hook_)
+            return debug_step_hook_();
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        return true;
+    }
+
+private:
+    uint64_t generation_;
+    DebugStepHook debug_step_hook_;
+    PipelineSnapshot pipeline_snapshot_;
+
+    static uint64_t NextGeneration(){
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
 };
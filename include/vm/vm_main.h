@@ -13,19 +13,37 @@ public:
 
 
     VM();
+    explicit VM(const vm_config::VmConfig& config);
 
     void Reset();
 
+    // rebuild the model from vm_config::config, or from config. The VM keeps no reference to config.
     void LoadVM();
+    void LoadVM(const vm_config::VmConfig& config);
     void LoadVM(AssembledProgram program);
+    void LoadVM(AssembledProgram program, const vm_config::VmConfig& config);
 
     void Run();
+    // steps until a breakpoint, the end of the program, the limit or a stop, with the hook (or the step delay) after
+    // every step, see VmBase::SetDebugStepHook()
     void DebugRun();
+    void SetDebugStepHook(VmBase::DebugStepHook hook);
+
+    // pcs DebugRun() stops at, kept across LoadVM()
+    void AddBreakpoint(uint64_t pc);
+    void RemoveBreakpoint(uint64_t pc);
+    const std::vector<uint64_t>& GetBreakpoints() const { return breakpoints_; }
 
     void Step();
 
     void Undo();
 
+    void RequestStop();
+    void ClearStop();
+    bool ProgramEnded();
+
+    uint64_t FastForward(uint64_t num_instrs);
+
     uint64_t ReadMemDoubleWord(uint64_t address);
 
     const std::array<uint64_t, 32>& GetGprValues();
@@ -34,7 +52,7 @@ public:
 
     std::vector<uint64_t> GetInstructionPCs();
 
-    VmBase::InstrView GetInstructions();
+    const PipelineSnapshot& GetPipelineSnapshot();
 
     bool PipeliningEnabled();
     bool ForwardingEnabled();
@@ -46,7 +64,22 @@ public:
 
     VmBase::Stats& GetStats();
 
+    std::pair<cache::CacheStats, cache::CacheStats> GetCacheStats();
+    void DumpCache();
+
+    const pc_profile::PcProfile& GetProfile();
+    const host_profile::HostProfile& GetHostProfile();
+    // writes the profile, by pc and by line of program_, to globals::profile_dump_file_path
+    void DumpProfile();
+
+    // kept across LoadVM(), every model built after this logs to log as well
+    void SetLog(std::ostream& log);
+
+    SimState& GetSimState();
+
 private:
     std::unique_ptr<VmBase> vm_;
     Which type_;
+    std::ostream* log_ = &globals::vm_cout_file;
+    std::vector<uint64_t> breakpoints_;
 };
\ No newline at end of file
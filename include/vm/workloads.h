@@ -0,0 +1,74 @@
+/**
+ * @file workloads.h
+ * @brief Contains the guest workload suite: loading the kernels of workloads/ at a chosen problem size, and the
+ * baselines their runs are checked against.
+ */
+
+#ifndef WORKLOADS_H
+#define WORKLOADS_H
+
+#include "vm/sweep.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+namespace workloads {
+
+/**
+ * @brief A kernel assembled at one problem size.
+ *
+ * Every kernel starts its .data with
+ *
+ *     size:   .dword <n>      # the problem size
+ *     out:    .dword 0, 0     # the address and length in bytes of its output, set by the kernel
+ *
+ * and ends by running off the end of its .text.
+ */
+struct Kernel {
+    sweep::Workload workload; ///< named after the file, without the extension
+    uint64_t size = 0;
+};
+
+/**
+ * @brief Assembles the kernel at path with its problem size set to size, or left as in the file for 0. A resized
+ * kernel is assembled from a copy in the vm_state directory.
+ * @throws std::runtime_error If the file can't be read, has no size line or doesn't assemble.
+ */
+Kernel LoadKernel(const std::filesystem::path& path, uint64_t size = 0);
+
+/**
+ * @brief The golden results of a kernel at a size on a model, under a config: "default" or the name of the ini file
+ * (without the extension) the run was configured with.
+ */
+struct Baseline {
+    uint64_t cycles = 0;
+    uint64_t instrs_retired = 0;
+    uint64_t reg_checksum = 0;
+    uint64_t mem_checksum = 0;
+};
+
+using BaselineKey = std::tuple<std::string, uint64_t, std::string, std::string>; ///< kernel, size, model, config
+
+constexpr const char* kDefaultConfig = "default";
+using Baselines = std::map<BaselineKey, Baseline>;
+
+/**
+ * @brief Reads baselines written by WriteBaselines().
+ * @throws std::runtime_error On a malformed line.
+ */
+Baselines ReadBaselines(std::istream& is);
+
+/**
+ * @brief Writes the baselines as CSV, a header line and one row per key in key order. The CPI and IPC columns are
+ * for the reader, ReadBaselines() skips them.
+ */
+void WriteBaselines(std::ostream& os, const Baselines& baselines);
+
+} // namespace workloads
+
+#endif // WORKLOADS_H
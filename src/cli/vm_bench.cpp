@@ -0,0 +1,576 @@
+/**
+ * @file vm_bench.cpp
+ * @brief Microbenchmarks of the simulator's hot paths: guest memory, the decode units, the ALU, the out of order
+ * core's CDB and ROB, one Step() of every model and the assembler. Prints ns/op, heap allocations per op and
+ * throughput of each as JSON, to be compared across commits.
+ *
+ * Usage: vm_bench [options]
+ *   --filter <text>                          only run the benchmarks whose name contains text
+ *   --min-time-ms <n>                        grow the batch of ops until it takes this long (default: 100)
+ *   --repetitions <n>                        timed batches per benchmark, the fastest counts (default: 5)
+ *   --output <file.json>                     write the JSON there instead of stdout
+ *   --list                                   print the benchmark names and exit
+ *
+ * Build with -DCMAKE_BUILD_TYPE=Release to measure what users run. The inputs (programs, the 100k line assembler
+ * file) are generated into vm_state.
+ */
+
+#include "vm/vm_main.h"
+#include "vm/main_memory.h"
+#include "vm/alu.h"
+#include "vm/rv5s/single_cycle/hardware/decode_unit.h"
+#include "vm/rv5s/pipelined/hardware/decode_unit.h"
+#include "vm/ooo/core/core.h"
+#include "assembler/assembler.h"
+#include "config.h"
+#include "globals.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// every heap allocation of the process goes through these, the benchmarks report how many an op made
+namespace {
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+void* Allocate(size_t size, size_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    size = size != 0 ? size : 1;
+    void* ptr = alignment <= alignof(std::max_align_t)
+        ? std::malloc(size)
+        : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+// out of line, or the compiler sees free() meet operator new and warns
+[[gnu::noinline]] void Deallocate(void* ptr) {
+    std::free(ptr);
+}
+} // namespace
+
+void* operator new(size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { Deallocate(ptr); }
+
+namespace {
+
+struct BenchOptions {
+    std::string filter;
+    uint64_t min_time_ms = 100;
+    unsigned int repetitions = 5;
+    std::string output;
+    bool list = false;
+};
+
+void PrintUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options]\n"
+              << "  --filter <text>\n"
+              << "  --min-time-ms <n>\n"
+              << "  --repetitions <n>\n"
+              << "  --output <file.json>\n"
+              << "  --list\n";
+}
+
+BenchOptions ParseArgs(int argc, char* argv[]) {
+    BenchOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--filter") {
+            opts.filter = next_value();
+        }
+        else if (arg == "--min-time-ms") {
+            opts.min_time_ms = std::stoull(next_value());
+        }
+        else if (arg == "--repetitions") {
+            opts.repetitions = static_cast<unsigned int>(std::stoul(next_value()));
+            if (opts.repetitions == 0)
+                throw std::invalid_argument("--repetitions needs at least one");
+        }
+        else if (arg == "--output") {
+            opts.output = next_value();
+        }
+        else if (arg == "--list") {
+            opts.list = true;
+        }
+        else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    return opts;
+}
+
+// keeps the compiler from dropping the computation of value
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    uint64_t ops;            ///< per timed batch
+    double ns_per_op;
+    double allocs_per_op;    ///< over every timed batch
+    double alloc_bytes_per_op;
+    std::string unit;        ///< what an op processes, items_per_second counts these
+    double items_per_second;
+};
+
+class Suite {
+public:
+    explicit Suite(const BenchOptions& opts) : opts_(opts) {}
+
+    bool Selected(const std::string& name) const {
+        if (name.find(opts_.filter) == std::string::npos)
+            return false;
+        if (opts_.list) {
+            std::cout << name << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Times op() (one operation, items_per_op items of unit): the batch doubles until it takes min_time_ms, then
+     * repetitions batches of that size run and the fastest one counts.
+     */
+    template <typename Op>
+    void Measure(const std::string& name, const char* unit, double items_per_op, Op&& op) {
+        if (!Selected(name))
+            return;
+
+        auto run_batch = [&](uint64_t ops) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < ops; i++)
+                op();
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        };
+
+        // the batch that reached min_time_ms is the first repetition
+        const double min_ns = static_cast<double>(opts_.min_time_ms) * 1e6;
+        uint64_t batch = 1;
+        uint64_t allocs_before = 0;
+        uint64_t bytes_before = 0;
+        double best_ns = 0;
+        while (true) {
+            allocs_before = allocations.load(std::memory_order_relaxed);
+            bytes_before = allocated_bytes.load(std::memory_order_relaxed);
+            best_ns = run_batch(batch);
+            if (best_ns >= min_ns || batch >= (uint64_t{1} << 40))
+                break;
+            batch *= 2;
+        }
+        for (unsigned int rep = 1; rep < opts_.repetitions; rep++)
+            best_ns = std::min(best_ns, run_batch(batch));
+        double total_ops = static_cast<double>(batch) * opts_.repetitions;
+        double allocs = static_cast<double>(allocations.load(std::memory_order_relaxed) - allocs_before);
+        double bytes = static_cast<double>(allocated_bytes.load(std::memory_order_relaxed) - bytes_before);
+
+        BenchResult result;
+        result.name = name;
+        result.ops = batch;
+        result.ns_per_op = best_ns / static_cast<double>(batch);
+        result.allocs_per_op = allocs / total_ops;
+        result.alloc_bytes_per_op = bytes / total_ops;
+        result.unit = unit;
+        result.items_per_second = result.ns_per_op > 0 ? items_per_op * 1e9 / result.ns_per_op : 0.0;
+        results_.push_back(result);
+
+        std::cerr << name << ": " << result.ns_per_op << " ns/op, " << result.allocs_per_op << " allocs/op" << std::endl;
+    }
+
+    void WriteJson(std::ostream& os) const {
+        os << "{\n";
+        os << "    \"min_time_ms\": " << opts_.min_time_ms << ",\n";
+        os << "    \"repetitions\": " << opts_.repetitions << ",\n";
+        os << "    \"host_profile\": " << (host_profile::kStageTimers ? "true" : "false") << ",\n";
+        os << "    \"benchmarks\": [";
+        bool first = true;
+        for (const BenchResult& result : results_) {
+            os << (first ? "\n" : ",\n")
+               << "        {\"name\": \"" << result.name << "\", "
+               << "\"ops\": " << result.ops << ", "
+               << "\"ns_per_op\": " << result.ns_per_op << ", "
+               << "\"allocs_per_op\": " << result.allocs_per_op << ", "
+               << "\"alloc_bytes_per_op\": " << result.alloc_bytes_per_op << ", "
+               << "\"unit\": \"" << result.unit << "\", "
+               << "\"items_per_second\": " << result.items_per_second << "}";
+            first = false;
+        }
+        os << (first ? "]\n" : "\n    ]\n");
+        os << "}" << std::endl;
+    }
+
+private:
+    const BenchOptions& opts_;
+    std::vector<BenchResult> results_;
+};
+
+std::filesystem::path WriteInput(const std::string& name, const std::string& text) {
+    std::filesystem::path path = globals::vm_state_directory / name;
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("Unable to write " + path.string());
+    file << text;
+    return path;
+}
+
+// one of every kind of instruction the decode units tell apart
+const char* kDecodeProgram = R"(.data
+buf: .dword 1, 2, 3, 4
+.text
+    la x9, buf
+    add x1, x2, x3
+    addi x1, x2, 5
+    lw x4, 0(x9)
+    sd x4, 8(x9)
+    lui x5, 0x12345
+    mul x6, x1, x4
+    div x7, x6, x1
+    slli x8, x1, 3
+    fadd.s f1, f2, f3
+    fmadd.d f1, f2, f3, f4
+    fld f5, 16(x9)
+    fsd f5, 24(x9)
+    csrrw x10, fcsr, x2
+    beq x1, x2, end
+    jal x1, end
+    jalr x0, 0(x1)
+end:
+    addi x0, x0, 0
+)";
+
+// loops for longer than any benchmark steps it
+const char* kStepProgram = R"(.data
+buf: .dword 0, 0, 0, 0, 0, 0, 0, 0
+.text
+    la x9, buf
+    li x5, 1000000000
+    li x6, 0
+loop:
+    addi x6, x6, 3
+    mul x7, x6, x6
+    sd x7, 0(x9)
+    ld x8, 0(x9)
+    xor x10, x8, x6
+    andi x11, x10, 15
+    beq x11, x0, skip
+    addi x10, x10, 1
+skip:
+    addi x5, x5, -1
+    bne x5, x0, loop
+)";
+
+std::string AssemblerInput(size_t num_lines) {
+    std::string text = ".data\nbuf: .dword 1, 2, 3, 4\n.text\n    la x9, buf\n";
+    size_t lines = 4;
+    for (size_t block = 0; lines < num_lines; block++) {
+        std::string label = "l" + std::to_string(block);
+        std::string next = "l" + std::to_string(block + 1);
+        text += label + ":\n"
+                "    addi x5, x5, 1\n"
+                "    add x6, x5, x7\n"
+                "    lw x8, 0(x9)\n"
+                "    sw x8, 4(x9)\n"
+                "    mul x10, x6, x5\n"
+                "    beq x5, x6, " + label + "\n"
+                "    fadd.d f1, f2, f3\n"
+                "    slli x11, x5, 3\n"
+                "    jal x0, " + next + "\n";
+        lines += 10;
+    }
+    size_t num_blocks = (lines - 4) / 10;
+    text += "l" + std::to_string(num_blocks) + ":\n    addi x0, x0, 0\n";
+    return text;
+}
+
+void BenchMemory(Suite& suite) {
+    Memory memory;
+    constexpr uint64_t kDenseBase = 0x10000000;
+    constexpr uint64_t kDenseBytes = 1 << 16;
+    // pages megabytes apart and visited in no order: the last page cache never hits and the walk goes through many
+    // leaf tables
+    constexpr uint64_t kSparseAddresses = 1 << 12;
+    constexpr uint64_t kSparseStride = 0x10000 * 257 + 8;
+    std::vector<uint64_t> sparse(kSparseAddresses);
+    for (uint64_t i = 0; i < kSparseAddresses; i++) {
+        sparse[i] = ((i * 2654435761u) % kSparseAddresses) * kSparseStride;
+        memory.WriteDoubleWord(sparse[i], i);
+    }
+    for (uint64_t address = kDenseBase; address < kDenseBase + kDenseBytes; address += 8)
+        memory.WriteDoubleWord(address, address);
+
+    uint64_t i = 0;
+    suite.Measure("memory/read_word/dense", "bytes", 4, [&] {
+        DoNotOptimize(memory.ReadWord(kDenseBase + (i++ * 4) % kDenseBytes));
+    });
+    suite.Measure("memory/read_word/sparse", "bytes", 4, [&] {
+        DoNotOptimize(memory.ReadWord(sparse[i++ % kSparseAddresses]));
+    });
+    suite.Measure("memory/write_double_word/dense", "bytes", 8, [&] {
+        memory.WriteDoubleWord(kDenseBase + (i * 8) % kDenseBytes, i);
+        i++;
+    });
+    suite.Measure("memory/write_double_word/sparse", "bytes", 8, [&] {
+        memory.WriteDoubleWord(sparse[i % kSparseAddresses], i);
+        i++;
+    });
+}
+
+// decodes the instructions of program in turn: predecoded takes them from a warm table, full decodes them from the
+// word every time (the table is empty)
+template <typename Context, typename Decode>
+void BenchDecode(Suite& suite, const std::string& model, const AssembledProgram& program, Decode&& decode) {
+    std::vector<uint32_t> words(program.text_buffer.begin(), program.text_buffer.end());
+    predecode::PredecodeTable warm;
+    warm.Reset(words.size() * 4);
+    predecode::PredecodeTable empty;
+    empty.Reset(0);
+
+    for (predecode::PredecodeTable* table : {&warm, &empty}) {
+        std::string name = "decode/" + model + (table == &warm ? "/predecoded" : "/full");
+        size_t i = 0;
+        suite.Measure(name, "instrs", 1, [&] {
+            size_t idx = i++ % words.size();
+            Context instr(idx * 4);
+            instr.instruction = words[idx];
+            decode(instr, *table);
+            DoNotOptimize(instr);
+        });
+    }
+}
+
+void BenchDecodeUnits(Suite& suite) {
+    AssembledProgram program = assemble(WriteInput("bench_decode.s", kDecodeProgram).string());
+    register_file::RegisterFile rf;
+
+    rv5s::SingleCycleDecodeUnit single_cycle;
+    BenchDecode<rv5s::SingleCycleInstrContext>(suite, "single_cycle", program,
+        [&](rv5s::SingleCycleInstrContext& instr, predecode::PredecodeTable& table) {
+            single_cycle.DecodeInstruction(instr, rf, table);
+        });
+
+    rv5s::PipelinedDecodeUnit pipelined;
+    BenchDecode<rv5s::PipelinedInstrContext>(suite, "pipelined", program,
+        [&](rv5s::PipelinedInstrContext& instr, predecode::PredecodeTable& table) {
+            pipelined.DecodeInstruction(instr, rf, table);
+        });
+
+    ooo::OooDecodeUnit out_of_order;
+    BenchDecode<ooo::OooInstrContext>(suite, "ooo", program,
+        [&](ooo::OooInstrContext& instr, predecode::PredecodeTable& table) {
+            out_of_order.DecodeInstruction(instr, table);
+        });
+}
+
+void BenchAlu(Suite& suite) {
+    constexpr std::array<alu::AluOp, 8> kIntOps = {
+        alu::AluOp::kAdd, alu::AluOp::kSub, alu::AluOp::kMul, alu::AluOp::kDiv,
+        alu::AluOp::kXor, alu::AluOp::kSll, alu::AluOp::kSra, alu::AluOp::kSltu,
+    };
+    uint64_t i = 0;
+    suite.Measure("alu/execute", "ops", 1, [&] {
+        DoNotOptimize(alu::Alu::execute(kIntOps[i % kIntOps.size()], i * 0x9e3779b97f4a7c15ULL, (i & 63) + 1));
+        i++;
+    });
+
+    // every call sets the rounding mode of its rm and puts the host's back
+    float a = 1.5f;
+    float b = 0.1f;
+    uint64_t fa = 0;
+    uint64_t fb = 0;
+    std::memcpy(&fa, &a, sizeof(a));
+    std::memcpy(&fb, &b, sizeof(b));
+    suite.Measure("alu/fpexecute/fesetround", "ops", 1, [&] {
+        DoNotOptimize(alu::Alu::fpexecute(alu::AluOp::FADD_S, fa, fb, 0, static_cast<uint8_t>(i++ % 4)));
+    });
+
+    double c = 1.5;
+    double d = 0.1;
+    uint64_t dc = 0;
+    uint64_t dd = 0;
+    std::memcpy(&dc, &c, sizeof(c));
+    std::memcpy(&dd, &d, sizeof(d));
+    suite.Measure("alu/dfpexecute/fesetround", "ops", 1, [&] {
+        DoNotOptimize(alu::Alu::dfpexecute(alu::AluOp::FMUL_D, dc, dd, 0, static_cast<uint8_t>(i++ % 4)));
+    });
+}
+
+void BenchOooHardware(Suite& suite) {
+    ooo::OooCore core(ooo::OooCore::kTripleIssue);
+    core.config_ = vm_config::config;
+    core.Load();
+
+    // producers in the ROB whose results haven't come in, the station fills up with instructions waiting on them
+    constexpr size_t kProducers = 8;
+    for (size_t reg = 1; reg <= kProducers; reg++) {
+        ooo::OooInstrContext producer(reg * 4);
+        producer.reg_write = true;
+        producer.rd = static_cast<uint8_t>(reg);
+        auto [rob_idx, epoch] = core.commit_buffer_.Reserve(producer);
+        core.reg_status_file_.UpdateTableRobIdx(producer.rd, true, rob_idx);
+    }
+
+    constexpr size_t kStationSize = 16;
+    ooo::ReservationStation station(kStationSize);
+    for (size_t slot = 0; slot < kStationSize; slot++) {
+        ooo::OooInstrContext consumer(0x100 + slot * 4);
+        consumer.uses_rs1 = true;
+        consumer.uses_rs2 = true;
+        consumer.rs1 = static_cast<uint8_t>(1 + slot % kProducers);
+        consumer.rs2 = static_cast<uint8_t>(1 + (slot + 1) % kProducers);
+        station.Push(consumer, core);
+    }
+
+    // results of the right ROB entries but of an older epoch: every entry compares against every message and
+    // nothing wakes up, so each op does the same work
+    ooo::CommonDataBus bus;
+    for (size_t msg = 0; msg < kProducers; msg++)
+        bus.BroadCast(msg, msg, false, 0);
+
+    suite.Measure("ooo/listen_to_broadcast/full", "msgs", static_cast<double>(kProducers), [&] {
+        station.ListenToBroadCast(bus);
+        DoNotOptimize(station);
+    });
+
+    // a full ROB cut back to its last entry: nothing is dropped, the register status is rebuilt from every entry
+    while (core.commit_buffer_.EmptySlots() > 0) {
+        ooo::OooInstrContext instr(0x200);
+        instr.reg_write = true;
+        instr.rd = static_cast<uint8_t>(1 + core.commit_buffer_.EmptySlots() % 31);
+        core.commit_buffer_.Reserve(instr);
+    }
+    auto [head, tail] = core.commit_buffer_.GetHeadTail();
+    size_t rob_size = core.commit_buffer_.GetEntries().size();
+    size_t last = (tail + rob_size - 1) % rob_size;
+    suite.Measure("ooo/rob_reset_tail_till_idx/full", "entries", static_cast<double>(rob_size - 1), [&] {
+        core.commit_buffer_.ResetTailTillIdx(last, core);
+    });
+    DoNotOptimize(head);
+}
+
+void BenchStep(Suite& suite) {
+    AssembledProgram program = assemble(WriteInput("bench_step.s", kStepProgram).string());
+
+    const std::array<std::pair<const char*, VM::Which>, 4> kModels = {{
+        {"single_cycle", VM::Which::SingleCycle},
+        {"pipelined", VM::Which::Pipelined},
+        {"dual_issue", VM::Which::DualIssue},
+        {"triple_issue", VM::Which::TripleIssue},
+    }};
+    for (const auto& [name, which] : kModels) {
+        if (!suite.Selected(std::string("step/") + name))
+            continue;
+
+        vm_config::VmConfig config = vm_config::config;
+        config.dual_issue = which == VM::Which::DualIssue;
+        config.triple_issue = which == VM::Which::TripleIssue;
+        config.pipelining_enabled = which == VM::Which::Pipelined;
+        config.hazard_detection_enabled = config.pipelining_enabled;
+        config.data_forwarding_enabled = config.pipelining_enabled;
+
+        // the VM writes its messages (every step logs its pc) to the log, not to vm_state
+        std::ofstream null_log;
+        VM vm(config);
+        vm.SetLog(null_log);
+        vm.LoadVM(program, config);
+
+        suite.Measure(std::string("step/") + name, "cycles", 1, [&] {
+            vm.Step();
+        });
+    }
+}
+
+void BenchAssembler(Suite& suite) {
+    constexpr size_t kLines = 100000;
+    if (!suite.Selected("assemble/100k_lines"))
+        return;
+
+    std::string path = WriteInput("bench_assemble.s", AssemblerInput(kLines)).string();
+    suite.Measure("assemble/100k_lines", "lines", static_cast<double>(kLines), [&] {
+        AssembledProgram program = assemble(path);
+        DoNotOptimize(program.text_buffer.size());
+    });
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    try {
+        opts = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    // the inputs are generated there, and assemble() dumps the disassembly/errors into it
+    setupVmStateDirectory();
+
+    Suite suite(opts);
+    try {
+        BenchMemory(suite);
+        BenchDecodeUnits(suite);
+        BenchAlu(suite);
+        BenchOooHardware(suite);
+        BenchStep(suite);
+        BenchAssembler(suite);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (opts.list)
+        return 0;
+
+    std::ofstream output_file;
+    if (!opts.output.empty()) {
+        output_file.open(opts.output);
+        if (!output_file) {
+            std::cerr << "Error: unable to open output file: " << opts.output << std::endl;
+            return 2;
+        }
+    }
+    suite.WriteJson(opts.output.empty() ? std::cout : output_file);
+    return 0;
+}
@@ -0,0 +1,311 @@
+/**
+ * @file vm_cli.cpp
+ * @brief Headless driver: assembles a program, runs it on the selected model and prints the stats as JSON.
+ * The "host" object is how fast the simulator ran, by stage too if built with -DVM_HOST_PROFILE=ON.
+ *
+ * Usage: vm_cli [options] <file.s>
+ *   --model <single|pipelined|dual|triple>   processor model (default: single)
+ *   --hazard                                 pipelined: enable hazard detection
+ *   --forwarding                             pipelined: enable data forwarding (implies --hazard)
+ *   --branch-prediction <none|static|dynamic|bimodal|gshare|tournament>
+ *                                            dynamic keeps the [BranchPrediction] type of the config (bimodal)
+ *   --limit <n>                              stop after n steps (default: no limit)
+ *   --fast-forward <n>                       run the first n instructions functionally before the timed run
+ *   --config <file.ini>                      apply an ini file (e.g. its [Cache] section) before the flags
+ *   --cache                                  enable the L1 I/D caches
+ *   --dump-cache                             also write vm_state/cache_dump.json
+ *   --dump-profile                           also write vm_state/profile.json (cycles per pc and source line)
+ *   --trace                                  record the stages of every instruction into vm_state/trace.bin
+ *   --trace-window <first>:<end>             only trace cycles first to end - 1 (implies --trace), end 0 for no end
+ */
+
+#include "vm/vm_main.h"
+#include "assembler/assembler.h"
+#include "config.h"
+#include "globals.h"
+#include "utils.h"
+
+#include <iostream>
+#include <string>
+#include <limits>
+#include <stdexcept>
+#include <filesystem>
+
+namespace {
+
+struct CliOptions {
+    std::string file;
+    VM::Which model = VM::Which::SingleCycle;
+    bool hazard = false;
+    bool forwarding = false;
+    std::string branch_prediction = "none";
+    uint64_t limit = std::numeric_limits<uint64_t>::max();
+    uint64_t fast_forward = 0;
+    std::string config_file;
+    bool cache = false;
+    bool dump_cache = false;
+    bool dump_profile = false;
+    bool trace = false;
+    std::string trace_window;
+};
+
+void PrintUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options] <file.s>\n"
+              << "  --model <single|pipelined|dual|triple>\n"
+              << "  --hazard\n"
+              << "  --forwarding\n"
+              << "  --branch-prediction <none|static|dynamic|bimodal|gshare|tournament>\n"
+              << "  --limit <n>\n"
+              << "  --fast-forward <n>\n"
+              << "  --config <file.ini>\n"
+              << "  --cache\n"
+              << "  --dump-cache\n"
+              << "  --dump-profile\n"
+              << "  --trace\n"
+              << "  --trace-window <first>:<end>\n";
+}
+
+VM::Which ParseModel(const std::string& name) {
+    if (name == "single") return VM::Which::SingleCycle;
+    if (name == "pipelined") return VM::Which::Pipelined;
+    if (name == "dual") return VM::Which::DualIssue;
+    if (name == "triple") return VM::Which::TripleIssue;
+    throw std::invalid_argument("Unknown model: " + name);
+}
+
+const char* ModelName(VM::Which model) {
+    switch (model) {
+        case VM::Which::SingleCycle: return "single";
+        case VM::Which::Pipelined: return "pipelined";
+        case VM::Which::DualIssue: return "dual";
+        case VM::Which::TripleIssue: return "triple";
+    }
+    return "unknown";
+}
+
+CliOptions ParseArgs(int argc, char* argv[]) {
+    CliOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--model") {
+            opts.model = ParseModel(next_value());
+        }
+        else if (arg == "--hazard") {
+            opts.hazard = true;
+        }
+        else if (arg == "--forwarding") {
+            opts.hazard = true;
+            opts.forwarding = true;
+        }
+        else if (arg == "--branch-prediction") {
+            opts.branch_prediction = next_value();
+            if (opts.branch_prediction != "none" && opts.branch_prediction != "static" && opts.branch_prediction != "dynamic"
+                && opts.branch_prediction != "bimodal" && opts.branch_prediction != "gshare"
+                && opts.branch_prediction != "tournament")
+                throw std::invalid_argument("Unknown branch prediction: " + opts.branch_prediction);
+        }
+        else if (arg == "--limit") {
+            opts.limit = std::stoull(next_value());
+        }
+        else if (arg == "--fast-forward") {
+            opts.fast_forward = std::stoull(next_value());
+        }
+        else if (arg == "--config") {
+            opts.config_file = next_value();
+        }
+        else if (arg == "--cache") {
+            opts.cache = true;
+        }
+        else if (arg == "--dump-cache") {
+            opts.dump_cache = true;
+        }
+        else if (arg == "--dump-profile") {
+            opts.dump_profile = true;
+        }
+        else if (arg == "--trace") {
+            opts.trace = true;
+        }
+        else if (arg == "--trace-window") {
+            opts.trace = true;
+            opts.trace_window = next_value();
+            if (opts.trace_window.find(':') == std::string::npos)
+                throw std::invalid_argument("Trace window must be <first>:<end>: " + opts.trace_window);
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+        else {
+            opts.file = arg;
+        }
+    }
+
+    if (opts.file.empty())
+        throw std::invalid_argument("No input file given");
+
+    return opts;
+}
+
+// Mirrors what set_processor_type() does for the GUI, without touching vm_state/config.ini
+void ApplyConfig(const CliOptions& opts) {
+    vm_config::VmConfig& config = vm_config::config;
+
+    config.dual_issue = opts.model == VM::Which::DualIssue;
+    config.triple_issue = opts.model == VM::Which::TripleIssue;
+    config.pipelining_enabled = opts.model == VM::Which::Pipelined;
+    config.hazard_detection_enabled = config.pipelining_enabled && opts.hazard;
+    config.data_forwarding_enabled = config.pipelining_enabled && opts.forwarding;
+
+    config.branch_prediction_enabled = opts.branch_prediction != "none";
+    config.branch_prediction_static = opts.branch_prediction == "static";
+    if (opts.branch_prediction != "none" && opts.branch_prediction != "static" && opts.branch_prediction != "dynamic") {
+        config.modifyConfig("BranchPrediction", "branch_prediction_type", opts.branch_prediction);
+    }
+
+    config.setInstructionExecutionLimit(opts.limit);
+
+    if (opts.cache) {
+        config.icache_config.enabled = true;
+        config.dcache_config.enabled = true;
+    }
+
+    if (opts.trace) {
+        config.modifyConfig("Trace", "trace_enabled", "true");
+    }
+    if (!opts.trace_window.empty()) {
+        size_t colon = opts.trace_window.find(':');
+        config.modifyConfig("Trace", "trace_start_cycle", opts.trace_window.substr(0, colon));
+        config.modifyConfig("Trace", "trace_end_cycle", opts.trace_window.substr(colon + 1));
+    }
+}
+
+void PrintCacheStats(const char* name, const cache::CacheStats& stats, bool last) {
+    std::cout << "        \"" << name << "\": {"
+              << "\"accesses\": " << stats.accesses << ", "
+              << "\"hits\": " << stats.hits << ", "
+              << "\"misses\": " << stats.misses << ", "
+              << "\"writebacks\": " << stats.writebacks << ", "
+              << "\"hit_rate\": " << stats.HitRate() << "}" << (last ? "\n" : ",\n");
+}
+
+// the stages only if vm_core was built with VM_HOST_PROFILE
+void PrintHostProfile(const host_profile::HostProfile& profile) {
+    std::cout << "    \"host\": {\n";
+    std::cout << "        \"seconds\": " << static_cast<double>(profile.RunNs()) / 1e9 << ",\n";
+    std::cout << "        \"mips\": " << profile.Mips() << ",\n";
+    std::cout << "        \"kips\": " << profile.Mips() * 1e3 << ",\n";
+    std::cout << "        \"ns_per_cycle\": " << profile.NsPerCycle() << ",\n";
+    std::cout << "        \"stages\": {";
+    bool first = true;
+    for (size_t timer = 1; timer < host_profile::kNumTimers; timer++) {
+        const host_profile::TimerTotals& totals = profile.Totals(static_cast<host_profile::Timer>(timer));
+        if (totals.calls == 0)
+            continue;
+        std::cout << (first ? "\n" : ",\n") << "            \"" << host_profile::Name(static_cast<host_profile::Timer>(timer))
+                  << "\": {\"calls\": " << totals.calls << ", "
+                  << "\"ns\": " << profile.StageNs(static_cast<host_profile::Timer>(timer)) << ", "
+                  << "\"ns_per_cycle\": " << profile.StageNsPerCycle(static_cast<host_profile::Timer>(timer)) << "}";
+        first = false;
+    }
+    std::cout << (first ? "}\n" : "\n        }\n");
+    std::cout << "    }\n";
+}
+
+void PrintStats(const CliOptions& opts, VM& vm, uint64_t fast_forwarded) {
+    VmBase::Stats& stats = vm.GetStats();
+    double cpi = stats.instrs_retired ? static_cast<double>(stats.cycles) / stats.instrs_retired : 0.0;
+    double ipc = stats.cycles ? static_cast<double>(stats.instrs_retired) / stats.cycles : 0.0;
+
+    std::cout << "{\n";
+    std::cout << "    \"file\": \"" << opts.file << "\",\n";
+    std::cout << "    \"model\": \"" << ModelName(opts.model) << "\",\n";
+    std::cout << "    \"hazard_detection\": " << (vm_config::config.hazard_detection_enabled ? "true" : "false") << ",\n";
+    std::cout << "    \"data_forwarding\": " << (vm_config::config.data_forwarding_enabled ? "true" : "false") << ",\n";
+    std::cout << "    \"branch_prediction\": \"" << opts.branch_prediction << "\",\n";
+    std::cout << "    \"instrs_fast_forwarded\": " << fast_forwarded << ",\n";
+    std::cout << "    \"stats\": {\n";
+    std::cout << "        \"cycles\": " << stats.cycles << ",\n";
+    std::cout << "        \"instrs_retired\": " << stats.instrs_retired << ",\n";
+    std::cout << "        \"branch_instrs\": " << stats.branch_instrs << ",\n";
+    std::cout << "        \"branch_mispredicts\": " << stats.branch_mispredicts << ",\n";
+    std::cout << "        \"mispredicts\": {"
+              << "\"unpredicted\": " << stats.mispredicts.unpredicted << ", "
+              << "\"static\": " << stats.mispredicts.static_rule << ", "
+              << "\"bimodal\": " << stats.mispredicts.bimodal << ", "
+              << "\"gshare\": " << stats.mispredicts.gshare << ", "
+              << "\"btb\": " << stats.mispredicts.btb << ", "
+              << "\"ras\": " << stats.mispredicts.ras << "},\n";
+    std::cout << "        \"store_forwards\": " << stats.store_forwards << ",\n";
+    std::cout << "        \"top_down\": {"
+              << "\"retiring\": " << stats.top_down.retiring << ", "
+              << "\"frontend_bound\": " << stats.top_down.frontend_bound << ", "
+              << "\"bad_speculation\": " << stats.top_down.bad_speculation << ", "
+              << "\"backend_bound\": " << stats.top_down.backend_bound << "},\n";
+    std::cout << "        \"cpi\": " << cpi << ",\n";
+    std::cout << "        \"ipc\": " << ipc << "\n";
+    std::cout << "    },\n";
+    std::cout << "    \"cache\": {\n";
+    auto [icache, dcache] = vm.GetCacheStats();
+    PrintCacheStats("icache", icache, false);
+    PrintCacheStats("dcache", dcache, true);
+    std::cout << "    },\n";
+    PrintHostProfile(vm.GetHostProfile());
+    std::cout << "}" << std::endl;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    CliOptions opts;
+    try {
+        opts = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    // assemble() dumps the disassembly/errors into vm_state
+    setupVmStateDirectory();
+    if (!opts.config_file.empty()) {
+        if (!std::filesystem::exists(opts.config_file)) {
+            std::cerr << "Error: config file not found: " << opts.config_file << std::endl;
+            return 2;
+        }
+        vm_config::LoadConfigFile(opts.config_file);
+    }
+    ApplyConfig(opts);
+
+    VM vm;
+    try {
+        vm.LoadVM(assemble(opts.file));
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    uint64_t fast_forwarded = 0;
+    if (opts.fast_forward > 0) {
+        fast_forwarded = vm.FastForward(opts.fast_forward);
+    }
+
+    vm.Run();
+
+    if (opts.dump_cache) {
+        vm.DumpCache();
+    }
+    if (opts.dump_profile) {
+        vm.DumpProfile();
+    }
+
+    PrintStats(opts, vm, fast_forwarded);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file vm_sweep.cpp
+ * @brief Headless sweep driver: runs every program on every point of a config grid in parallel and writes the stats
+ * of all runs as one CSV.
+ *
+ * Usage: vm_sweep [options] <file.s>...
+ *   --models <list>              single,pipelined,pipelined-hazard,pipelined-forwarding,dual,triple (default: single)
+ *   --branch-prediction <list>   none,static,bimodal,gshare,tournament (default: the config's, none)
+ *   --rs <list>                  reservation station sizes, dual/triple only (default: the config's, 4)
+ *   --rob <list>                 ROB sizes, 0 for the model default, dual/triple only (default: the config's, 0)
+ *   --cdb <list>                 CDB widths, 0 for unlimited, dual/triple only (default: the config's, 0)
+ *   --limit <n>                  stop each run after n steps (default: no limit)
+ *   --config <file.ini>          apply an ini file (e.g. its [Cache] section) to every point
+ *   --cache                      enable the L1 I/D caches
+ *   --threads <n>                worker threads (default: all host cores)
+ *   --output <file.csv>          write the CSV there instead of stdout
+ *
+ * Lists are comma separated, the grid is their cross product.
+ */
+
+#include "vm/sweep.h"
+#include "assembler/assembler.h"
+#include "config.h"
+#include "globals.h"
+#include "utils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SweepOptions {
+    std::vector<std::string> files;
+    sweep::ConfigGrid grid;
+    uint64_t limit = std::numeric_limits<uint64_t>::max();
+    std::string config_file;
+    bool cache = false;
+    unsigned int threads = 0;
+    std::string output;
+};
+
+void PrintUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options] <file.s>...\n"
+              << "  --models <single,pipelined,pipelined-hazard,pipelined-forwarding,dual,triple>\n"
+              << "  --branch-prediction <none,static,bimodal,gshare,tournament>\n"
+              << "  --rs <n,...>\n"
+              << "  --rob <n,...>\n"
+              << "  --cdb <n,...>\n"
+              << "  --limit <n>\n"
+              << "  --config <file.ini>\n"
+              << "  --cache\n"
+              << "  --threads <n>\n"
+              << "  --output <file.csv>\n";
+}
+
+std::vector<std::string> SplitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    if (items.empty()) {
+        throw std::invalid_argument("Empty list: " + list);
+    }
+    return items;
+}
+
+std::vector<size_t> SplitSizes(const std::string& list) {
+    std::vector<size_t> sizes;
+    for (const std::string& item : SplitList(list)) {
+        sizes.push_back(std::stoul(item));
+    }
+    return sizes;
+}
+
+SweepOptions ParseArgs(int argc, char* argv[]) {
+    SweepOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--models") {
+            opts.grid.models = SplitList(next_value());
+        }
+        else if (arg == "--branch-prediction") {
+            opts.grid.branch_predictions = SplitList(next_value());
+        }
+        else if (arg == "--rs") {
+            opts.grid.reservation_station_sizes = SplitSizes(next_value());
+        }
+        else if (arg == "--rob") {
+            opts.grid.rob_sizes = SplitSizes(next_value());
+        }
+        else if (arg == "--cdb") {
+            opts.grid.cdb_widths = SplitSizes(next_value());
+        }
+        else if (arg == "--limit") {
+            opts.limit = std::stoull(next_value());
+        }
+        else if (arg == "--config") {
+            opts.config_file = next_value();
+        }
+        else if (arg == "--cache") {
+            opts.cache = true;
+        }
+        else if (arg == "--threads") {
+            opts.threads = static_cast<unsigned int>(std::stoul(next_value()));
+        }
+        else if (arg == "--output") {
+            opts.output = next_value();
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+        else {
+            opts.files.push_back(arg);
+        }
+    }
+
+    if (opts.files.empty())
+        throw std::invalid_argument("No input files given");
+
+    return opts;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    SweepOptions opts;
+    std::vector<sweep::ConfigPoint> points;
+    try {
+        opts = ParseArgs(argc, argv);
+
+        // assemble() dumps the disassembly/errors into vm_state
+        setupVmStateDirectory();
+        if (!opts.config_file.empty()) {
+            if (!std::filesystem::exists(opts.config_file)) {
+                std::cerr << "Error: config file not found: " << opts.config_file << std::endl;
+                return 2;
+            }
+            vm_config::LoadConfigFile(opts.config_file);
+        }
+
+        vm_config::VmConfig base = vm_config::config;
+        base.setInstructionExecutionLimit(opts.limit);
+        if (opts.cache) {
+            base.icache_config.enabled = true;
+            base.dcache_config.enabled = true;
+        }
+        points = opts.grid.Expand(base);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    // the assembler works on the globals, so the workloads are assembled up front on this thread
+    std::vector<sweep::Workload> workloads;
+    for (const std::string& file : opts.files) {
+        try {
+            workloads.push_back(sweep::Workload{file, assemble(file)});
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << file << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<sweep::JobResult> results = sweep::Run(workloads, points, opts.threads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (opts.output.empty()) {
+        sweep::WriteCsv(std::cout, workloads, points, results);
+    }
+    else {
+        std::ofstream file(opts.output);
+        if (!file.is_open()) {
+            std::cerr << "Error: cannot write " << opts.output << std::endl;
+            return 1;
+        }
+        sweep::WriteCsv(file, workloads, points, results);
+    }
+
+    std::cerr << results.size() << " runs (" << workloads.size() << " workloads x " << points.size()
+              << " configs) in " << elapsed.count() << " s" << std::endl;
+    return 0;
+}
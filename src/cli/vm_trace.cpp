@@ -0,0 +1,123 @@
+/**
+ * @file vm_trace.cpp
+ * @brief Converts a pipeline trace (vm_state/trace.bin, see the [Trace] config and vm_cli --trace) to a text format
+ * pipeline viewers read.
+ *
+ * Usage: vm_trace [options] [trace.bin]
+ *   --format <kanata|o3>                     Kanata log for Konata (default) or gem5 O3PipeView
+ *   --program <file.s>                       label the instructions with their disassembly
+ *   --output <file>                          write there instead of stdout
+ */
+
+#include "vm/pipeline_trace.h"
+#include "assembler/assembler.h"
+#include "globals.h"
+#include "utils.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct TraceOptions {
+    std::string trace = globals::trace_file_path.string();
+    std::string format = "kanata";
+    std::string program;
+    std::string output;
+};
+
+void PrintUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options] [trace.bin]\n"
+              << "  --format <kanata|o3>\n"
+              << "  --program <file.s>\n"
+              << "  --output <file>\n";
+}
+
+TraceOptions ParseArgs(int argc, char* argv[]) {
+    TraceOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--format") {
+            opts.format = next_value();
+            if (opts.format != "kanata" && opts.format != "o3")
+                throw std::invalid_argument("Unknown format: " + opts.format);
+        }
+        else if (arg == "--program") {
+            opts.program = next_value();
+        }
+        else if (arg == "--output") {
+            opts.output = next_value();
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+        else {
+            opts.trace = arg;
+        }
+    }
+
+    return opts;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    TraceOptions opts;
+    try {
+        opts = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::ifstream trace(opts.trace, std::ios::binary);
+    if (!trace) {
+        std::cerr << "Error: unable to open trace file: " << opts.trace << std::endl;
+        return 2;
+    }
+
+    std::vector<std::string> labels;
+    if (!opts.program.empty()) {
+        // assemble() dumps the disassembly/errors into vm_state
+        setupVmStateDirectory();
+        try {
+            labels = pipeline_trace::Disassembly(assemble(opts.program));
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream output_file;
+    if (!opts.output.empty()) {
+        output_file.open(opts.output);
+        if (!output_file) {
+            std::cerr << "Error: unable to open output file: " << opts.output << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& os = opts.output.empty() ? std::cout : output_file;
+
+    try {
+        if (opts.format == "o3")
+            pipeline_trace::ConvertToO3PipeView(trace, os, labels);
+        else
+            pipeline_trace::ConvertToKanata(trace, os, labels);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file vm_workloads.cpp
+ * @brief Guest workload suite driver: runs the kernels of workloads/ on every model and checks their register and
+ * memory checksums, cycles and instructions against the recorded baselines.
+ *
+ * Usage: vm_workloads [options] [<kernel.s>...]
+ *   --dir <dir>                  run every .s in dir when no kernels are given (default: workloads)
+ *   --size <kernel>=<n>          problem size of a kernel, may be repeated (default: the size in its file)
+ *   --models <list>              (default: single,pipelined-forwarding,dual,triple, one per VM::Which)
+ *   --baseline <file.csv>        the baselines to check against (default: <dir>/baselines.csv)
+ *   --record                     write the results into the baselines instead of checking them
+ *   --tolerance <pct>            how far cycles may drift from the baseline (default: 0)
+ *   --limit <n>                  stop each run after n steps (default: no limit)
+ *   --config <file.ini>          apply an ini file to every model, its runs have baselines of their own (keyed by
+ *                                the file name without the extension)
+ *   --threads <n>                worker threads (default: all host cores)
+ *   --output <file.csv>          write the report there instead of stdout
+ *
+ * The report has one row per run with its status: ok, new (no baseline), checksum, cycles (or instructions) off the
+ * baseline, models (the checksums differ from the first model's), limit (never ran off the end) or error. Any status
+ * but ok and new makes the exit code 1, and keeps --record from writing.
+ */
+
+#include "vm/workloads.h"
+#include "config.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct WorkloadsOptions {
+    std::vector<std::string> files;
+    std::string dir = "workloads";
+    std::map<std::string, uint64_t> sizes;
+    std::vector<std::string> models = {"single", "pipelined-forwarding", "dual", "triple"};
+    std::string baseline;
+    bool record = false;
+    double tolerance = 0.0;
+    uint64_t limit = std::numeric_limits<uint64_t>::max();
+    std::string config_file;
+    unsigned int threads = 0;
+    std::string output;
+};
+
+void PrintUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options] [<kernel.s>...]\n"
+              << "  --dir <dir>\n"
+              << "  --size <kernel>=<n>\n"
+              << "  --models <single,pipelined,pipelined-hazard,pipelined-forwarding,dual,triple>\n"
+              << "  --baseline <file.csv>\n"
+              << "  --record\n"
+              << "  --tolerance <pct>\n"
+              << "  --limit <n>\n"
+              << "  --config <file.ini>\n"
+              << "  --threads <n>\n"
+              << "  --output <file.csv>\n";
+}
+
+std::vector<std::string> SplitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    if (items.empty()) {
+        throw std::invalid_argument("Empty list: " + list);
+    }
+    return items;
+}
+
+WorkloadsOptions ParseArgs(int argc, char* argv[]) {
+    WorkloadsOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--dir") {
+            opts.dir = next_value();
+        }
+        else if (arg == "--size") {
+            std::string value = next_value();
+            size_t eq = value.find('=');
+            if (eq == std::string::npos || eq == 0)
+                throw std::invalid_argument("Expected <kernel>=<n>: " + value);
+            uint64_t size = std::stoull(value.substr(eq + 1));
+            if (size == 0)
+                throw std::invalid_argument("Problem sizes start at 1: " + value);
+            opts.sizes[value.substr(0, eq)] = size;
+        }
+        else if (arg == "--models") {
+            opts.models = SplitList(next_value());
+        }
+        else if (arg == "--baseline") {
+            opts.baseline = next_value();
+        }
+        else if (arg == "--record") {
+            opts.record = true;
+        }
+        else if (arg == "--tolerance") {
+            opts.tolerance = std::stod(next_value());
+        }
+        else if (arg == "--limit") {
+            opts.limit = std::stoull(next_value());
+        }
+        else if (arg == "--config") {
+            opts.config_file = next_value();
+        }
+        else if (arg == "--threads") {
+            opts.threads = static_cast<unsigned int>(std::stoul(next_value()));
+        }
+        else if (arg == "--output") {
+            opts.output = next_value();
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+        else {
+            opts.files.push_back(arg);
+        }
+    }
+
+    if (opts.files.empty()) {
+        if (!std::filesystem::is_directory(opts.dir))
+            throw std::invalid_argument("No kernels given and no directory " + opts.dir);
+        for (const auto& entry : std::filesystem::directory_iterator(opts.dir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".s") {
+                opts.files.push_back(entry.path().string());
+            }
+        }
+        std::sort(opts.files.begin(), opts.files.end());
+        if (opts.files.empty())
+            throw std::invalid_argument("No kernels in " + opts.dir);
+    }
+    if (opts.baseline.empty()) {
+        opts.baseline = (std::filesystem::path(opts.dir) / "baselines.csv").string();
+    }
+
+    return opts;
+}
+
+workloads::Baseline ToBaseline(const sweep::JobResult& result) {
+    return {result.stats.cycles, result.stats.instrs_retired, result.reg_checksum, result.mem_checksum};
+}
+
+std::string Status(const sweep::JobResult& result, const sweep::JobResult& first, const workloads::Baselines& baselines,
+                   const workloads::BaselineKey& key, double tolerance) {
+    if (!result.error.empty()) {
+        return "error";
+    }
+    if (!result.ended) {
+        return "limit";
+    }
+    // every model has to leave the same architectural state behind
+    if (result.reg_checksum != first.reg_checksum || result.mem_checksum != first.mem_checksum) {
+        return "models";
+    }
+
+    auto it = baselines.find(key);
+    if (it == baselines.end()) {
+        return "new";
+    }
+    const workloads::Baseline& baseline = it->second;
+    if (result.reg_checksum != baseline.reg_checksum || result.mem_checksum != baseline.mem_checksum) {
+        return "checksum";
+    }
+    double drift = baseline.cycles
+        ? std::abs(static_cast<double>(result.stats.cycles) - static_cast<double>(baseline.cycles))*100.0 / baseline.cycles
+        : 0.0;
+    if (result.stats.instrs_retired != baseline.instrs_retired || drift > tolerance) {
+        return "cycles";
+    }
+    return "ok";
+}
+
+void WriteReport(std::ostream& os, const std::vector<workloads::Kernel>& kernels,
+                 const std::vector<sweep::ConfigPoint>& points, const std::vector<sweep::JobResult>& results,
+                 const std::vector<std::string>& statuses) {
+    os << "kernel,size,model,cycles,instrs_retired,cpi,ipc,reg_checksum,mem_checksum,host_seconds,mips,status\n";
+
+    for (size_t job = 0; job < results.size(); job++) {
+        const workloads::Kernel& kernel = kernels[job/points.size()];
+        const sweep::JobResult& result = results[job];
+        const VmBase::Stats& stats = result.stats;
+
+        double cpi = stats.instrs_retired ? static_cast<double>(stats.cycles) / stats.instrs_retired : 0.0;
+        double ipc = stats.cycles ? static_cast<double>(stats.instrs_retired) / stats.cycles : 0.0;
+        double mips = result.host_seconds > 0.0 ? static_cast<double>(stats.instrs_retired) / result.host_seconds / 1e6 : 0.0;
+
+        std::ostringstream row;
+        row << kernel.workload.name << ',' << kernel.size << ',' << points[job%points.size()].model << ','
+            << stats.cycles << ',' << stats.instrs_retired << ','
+            << std::fixed << std::setprecision(4) << cpi << ',' << ipc << ','
+            << std::hex << std::setfill('0') << "0x" << std::setw(16) << result.reg_checksum << ','
+            << "0x" << std::setw(16) << result.mem_checksum << ','
+            << std::dec << std::setfill(' ') << std::setprecision(6) << result.host_seconds << ','
+            << std::setprecision(2) << mips << ',' << statuses[job] << '\n';
+        os << row.str();
+    }
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    WorkloadsOptions opts;
+    std::vector<sweep::ConfigPoint> points;
+    try {
+        opts = ParseArgs(argc, argv);
+
+        // assemble() dumps the disassembly/errors into vm_state, resized kernels are written there too
+        setupVmStateDirectory();
+        if (!opts.config_file.empty()) {
+            if (!std::filesystem::exists(opts.config_file)) {
+                std::cerr << "Error: config file not found: " << opts.config_file << std::endl;
+                return 2;
+            }
+            vm_config::LoadConfigFile(opts.config_file);
+        }
+
+        vm_config::VmConfig base = vm_config::config;
+        base.setInstructionExecutionLimit(opts.limit);
+        sweep::ConfigGrid grid;
+        grid.models = opts.models;
+        points = grid.Expand(base);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    // the assembler works on the globals, so the kernels are assembled up front on this thread
+    std::vector<workloads::Kernel> kernels;
+    std::vector<sweep::Workload> jobs;
+    for (const std::string& file : opts.files) {
+        try {
+            auto size = opts.sizes.find(std::filesystem::path(file).stem().string());
+            kernels.push_back(workloads::LoadKernel(file, size != opts.sizes.end() ? size->second : 0));
+            jobs.push_back(kernels.back().workload);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << file << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    workloads::Baselines baselines;
+    if (std::filesystem::exists(opts.baseline)) {
+        std::ifstream file(opts.baseline);
+        try {
+            baselines = workloads::ReadBaselines(file);
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << opts.baseline << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // a run under another config is checked against (and recorded into) baselines of that config
+    const std::string config_name = opts.config_file.empty()
+        ? std::string(workloads::kDefaultConfig)
+        : std::filesystem::path(opts.config_file).stem().string();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<sweep::JobResult> results = sweep::Run(jobs, points, opts.threads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::vector<std::string> statuses(results.size());
+    size_t failed = 0;
+    for (size_t job = 0; job < results.size(); job++) {
+        const workloads::Kernel& kernel = kernels[job/points.size()];
+        const sweep::JobResult& first = results[job - job%points.size()];
+        workloads::BaselineKey key{kernel.workload.name, kernel.size, points[job%points.size()].model, config_name};
+
+        statuses[job] = Status(results[job], first, opts.record ? workloads::Baselines{} : baselines, key,
+                               opts.tolerance);
+        if (statuses[job] != "ok" && statuses[job] != "new") {
+            failed++;
+            if (!results[job].error.empty()) {
+                std::cerr << "Error: " << kernel.workload.name << " on " << std::get<2>(key) << ": "
+                          << results[job].error << std::endl;
+            }
+        }
+        else if (opts.record) {
+            baselines[key] = ToBaseline(results[job]);
+            statuses[job] = "recorded";
+        }
+    }
+
+    if (opts.output.empty()) {
+        WriteReport(std::cout, kernels, points, results, statuses);
+    }
+    else {
+        std::ofstream file(opts.output);
+        if (!file.is_open()) {
+            std::cerr << "Error: cannot write " << opts.output << std::endl;
+            return 1;
+        }
+        WriteReport(file, kernels, points, results, statuses);
+    }
+
+    if (opts.record && failed == 0) {
+        std::ofstream file(opts.baseline);
+        if (!file.is_open()) {
+            std::cerr << "Error: cannot write " << opts.baseline << std::endl;
+            return 1;
+        }
+        workloads::WriteBaselines(file, baselines);
+    }
+
+    std::cerr << results.size() << " runs (" << kernels.size() << " kernels x " << points.size() << " models) in "
+              << elapsed.count() << " s, " << failed << " failed"
+              << (opts.record ? (failed == 0 ? ", recorded into " + opts.baseline : ", nothing recorded") : "")
+              << std::endl;
+    return failed == 0 ? 0 : 1;
+}
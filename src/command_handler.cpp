@@ -52,6 +52,8 @@ Command ParseCommand(const std::string &input) {
     command_type = command_handler::CommandType::GET_MEMORY_POINT;
   } else if (command_str=="dump_cache") {
     command_type = command_handler::CommandType::DUMP_CACHE;
+  } else if (command_str=="dump_profile") {
+    command_type = command_handler::CommandType::DUMP_PROFILE;
   } else if (command_str=="add_breakpoint") {
     command_type = command_handler::CommandType::ADD_BREAKPOINT;
   } else if (command_str=="remove_breakpoint") {
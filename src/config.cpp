@@ -9,8 +9,58 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <iostream>
 
 namespace vm_config {
     VmConfig config;
+
+void LoadConfigFile(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return;
+  }
+
+  auto trim = [](std::string str) {
+    const char *whitespace = " \t\r\n";
+    size_t begin = str.find_first_not_of(whitespace);
+    if (begin == std::string::npos) {
+      return std::string{};
+    }
+    size_t end = str.find_last_not_of(whitespace);
+    return str.substr(begin, end - begin + 1);
+  };
+
+  std::string section;
+  std::string line;
+  unsigned int line_number = 0;
+  while (std::getline(file, line)) {
+    line_number++;
+    line = trim(line.substr(0, line.find_first_of(";#")));
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '[' && line.back() == ']') {
+      section = trim(line.substr(1, line.size() - 2));
+      continue;
+    }
+
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      std::cerr << path.string() << ":" << line_number << ": expected key=value" << std::endl;
+      continue;
+    }
+
+    std::string key = trim(line.substr(0, eq));
+    std::string value = trim(line.substr(eq + 1));
+    try {
+      config.modifyConfig(section, key, value);
+    } catch (const std::exception &e) {
+      std::cerr << path.string() << ":" << line_number << ": ignored [" << section << "] " << key
+                << " (" << e.what() << ")" << std::endl;
+    }
+  }
 }
 
+} // namespace vm_config
+
@@ -9,6 +9,8 @@ std::filesystem::path globals::errors_dump_file_path = (globals::invokation_path
 std::filesystem::path globals::registers_dump_file_path = (globals::invokation_path / "vm_state" / "registers_dump.json");
 std::filesystem::path globals::memory_dump_file_path = (globals::invokation_path / "vm_state" / "memory_dump.json");
 std::filesystem::path globals::cache_dump_file_path = (globals::invokation_path / "vm_state" / "cache_dump.json");
+std::filesystem::path globals::profile_dump_file_path = (globals::invokation_path / "vm_state" / "profile.json");
+std::filesystem::path globals::trace_file_path = (globals::invokation_path / "vm_state" / "trace.bin");
 std::filesystem::path globals::vm_state_dump_file_path = (globals::invokation_path / "vm_state" / "vm_state_dump.json");
 std::filesystem::path globals::vm_cout_file_path = (globals::invokation_path / "vm_state" / "vm_cout.txt");
 std::ofstream globals::vm_cout_file(globals::vm_cout_file_path.string());
@@ -17,7 +17,8 @@ bool in_memory = false;
 bool show_gpr = true;
 bool show_fpr = false;
 
-VM vm;
+sim_worker::SimWorker vm_worker;
+sim_worker::SimSnapshot* vm_snapshot = nullptr;
 
 void LoadFonts(ImGuiIO& io){
     STANDARD_EXTRA_SMALL_FONT = io.Fonts->AddFontFromFileTTF("../imgui/misc/fonts/Roboto-Medium.ttf", 12.0f);
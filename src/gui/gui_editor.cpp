@@ -1036,6 +1036,21 @@ void TextEditor::Render()
 				}
 			}
 
+			// Heat map gutter, the hottest line in full red
+			if(mDebugMode && static_cast<size_t>(lineNo) < mHeatMap.size() && mHeatMap[lineNo] > 0.0f){
+				float heat = mHeatMap[lineNo] / mHeatMapMax;
+				ImVec2 gutter_start(lineStartScreenPos.x, lineStartScreenPos.y);
+				ImVec2 gutter_end(lineStartScreenPos.x + mLeftMargin * 0.6f, lineStartScreenPos.y + mCharAdvance.y);
+				drawList->AddRectFilled(gutter_start, gutter_end, ImGui::ColorConvertFloat4ToU32({1.0f, 0.85f * (1.0f - heat), 0.1f, 0.25f + 0.75f * heat}));
+
+				if (ImGui::IsMouseHoveringRect(gutter_start, ImVec2(lineStartScreenPos.x + mTextStart, gutter_end.y)))
+				{
+					ImGui::BeginTooltip();
+					ImGui::Text("%.1f%% of cycles", mHeatMap[lineNo] * 100.0f);
+					ImGui::EndTooltip();
+				}
+			}
+
 			// Debug mode highlighting
 			if(mDebugMode){
 				if(mSingleCycle){
@@ -1502,6 +1517,11 @@ void TextEditor::SetDebugLines(size_t aIfLine, size_t aIdLine, size_t aExLine, s
 	mDebugLines.WbLine = aWbLine;
 }
 
+void TextEditor::SetHeatMap(std::vector<float> aCycleShares){
+	mHeatMap = std::move(aCycleShares);
+	mHeatMapMax = mHeatMap.empty() ? 0.0f : *std::max_element(mHeatMap.begin(), mHeatMap.end());
+}
+
 void TextEditor::SetFilePath(std::string aValue){
 	mFilePath = aValue;
 }
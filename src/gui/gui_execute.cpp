@@ -1,7 +1,9 @@
 #include "../../include/gui/gui_execute.h"
-#include "vm/instruction_context.h"
-#include "vm/rv5s/pipelined/core/instruction_context/instruction_context.h"
-#include "vm/rv5s/single_cycle/core/instruction_context/instruction_context.h"
+#include "vm/pipeline_snapshot.h"
+#include "vm/pc_profile.h"
+
+#include <array>
+#include <span>
 
 void editor_execute(){
 	ImVec2 window_size = ImGui::GetWindowSize();
@@ -22,38 +24,31 @@ void editor_execute(){
 
         text_editor.SetDebugMode(true);
 
-        if(vm.GetType() != VM::Which::DualIssue && vm.GetType() != VM::Which::TripleIssue){
-            if(!vm.PipeliningEnabled()){
+        if(vm_snapshot->type != VM::Which::DualIssue && vm_snapshot->type != VM::Which::TripleIssue){
+            if(!vm_snapshot->pipelining_enabled){
                 text_editor.SetDebugModeTypeSingleCycle(true);
-                size_t text_line_number = vm.program_.instruction_number_line_number_mapping[vm.GetInstructionPCs()[0] / 4];
+                size_t text_line_number = vm_snapshot->program->instruction_number_line_number_mapping[vm_snapshot->instruction_pcs[0] / 4];
                 text_editor.SetDebugLines(text_line_number-1, -1, -1, -1, -1);
                 text_editor.SetCursorPosition({static_cast<int>(text_line_number),0});
             }
             else{
                 text_editor.SetDebugModeTypeSingleCycle(false);
-                // std::vector<uint64_t> pcs = vm.GetInstructionPCs();
+                // std::vector<uint64_t> pcs = vm_snapshot->instruction_pcs;
                 // for(int i=0;i<5;i++)
-                //     pcs[i] = vm.program_.instruction_number_line_number_mapping[pcs[i] / 4];
+                //     pcs[i] = vm_snapshot->program->instruction_number_line_number_mapping[pcs[i] / 4];
                 // text_editor.SetDebugLines(pcs[0]-1, pcs[1]-1, pcs[2]-1, pcs[3]-1, pcs[4]-1);
                 // text_editor.SetCursorPosition({static_cast<int>(pcs[3]),0});
 
-                std::vector<std::unique_ptr<const InstrContext>> instructions = vm.GetInstructions().pipeline;
-                std::vector<uint64_t> line_numbers(5);
-
-                for(int i=0;i<5;i++){
-                    const auto* instruction = dynamic_cast<const rv5s::PipelinedInstrContext*>(instructions[i].get());
-                    if(instruction){
-                        if(instruction->bubbled || instruction->nopped){
-                            line_numbers[i] = -1;
-                        }
-                        else{
-                            uint64_t instr_pc = instruction->pc;
-                            line_numbers[i] = vm.program_.instruction_number_line_number_mapping[instr_pc/4] - 1;
-                        }
+                std::span<const InstrSlot> instructions = vm_snapshot->pipeline.Pipeline();
+                std::array<uint64_t, 5> line_numbers;
+
+                for(size_t i=0;i<line_numbers.size();i++){
+                    if(i>=instructions.size() || instructions[i].bubbled || instructions[i].nopped){
+                        line_numbers[i] = -1;
                     }
                     else{
-                        std::cerr << "Tried to downcast InstrContext to PipelinedInstrContext while setting debug lines" << std::endl;
-                        line_numbers[i] = -1;
+                        uint64_t instr_pc = instructions[i].pc;
+                        line_numbers[i] = vm_snapshot->program->instruction_number_line_number_mapping[instr_pc/4] - 1;
                     }
                 }
 
@@ -69,6 +64,19 @@ void editor_execute(){
         else{
             text_editor.SetDebugLines(-1, -1, -1, -1, -1);
         }
+
+        // where the cycles went, per source line
+        std::vector<float> cycle_shares;
+        if(vm_snapshot->stats.cycles>0){
+            for(const auto& [line, counters] : pc_profile::ByLine(vm_snapshot->profile, *vm_snapshot->program)){
+                if(line==0)
+                    continue;
+                if(cycle_shares.size()<line)
+                    cycle_shares.resize(line);
+                cycle_shares[line-1] = static_cast<float>(counters.cycles) / vm_snapshot->stats.cycles;
+            }
+        }
+        text_editor.SetHeatMap(std::move(cycle_shares));
         
 
         text_editor.Render("Editor Read Only", text_area_size, true);
@@ -106,38 +114,31 @@ void assembled_editor_main(){
 
 
         assembled_editor.SetDebugMode(true);
-        if(vm.GetType() != VM::Which::DualIssue && vm.GetType() != VM::Which::TripleIssue){
-            if(!vm.PipeliningEnabled()){
+        if(vm_snapshot->type != VM::Which::DualIssue && vm_snapshot->type != VM::Which::TripleIssue){
+            if(!vm_snapshot->pipelining_enabled){
                 assembled_editor.SetDebugModeTypeSingleCycle(true);
-                size_t text_line_number = vm.program_.instruction_number_disassembly_mapping[vm.GetInstructionPCs()[0] / 4];
+                size_t text_line_number = vm_snapshot->program->instruction_number_disassembly_mapping[vm_snapshot->instruction_pcs[0] / 4];
                 assembled_editor.SetDebugLines(text_line_number-1, -1, -1, -1, -1);
                 assembled_editor.SetCursorPosition({static_cast<int>(text_line_number), 0});
             }
             else{
                 assembled_editor.SetDebugModeTypeSingleCycle(false);
-                // std::vector<uint64_t> pcs = vm.GetInstructionPCs();
+                // std::vector<uint64_t> pcs = vm_snapshot->instruction_pcs;
                 // for(int i=0;i<5;i++)
-                //     pcs[i] = vm.program_.instruction_number_disassembly_mapping[pcs[i] / 4];
+                //     pcs[i] = vm_snapshot->program->instruction_number_disassembly_mapping[pcs[i] / 4];
                 // assembled_editor.SetDebugLines(pcs[0]-1, pcs[1]-1, pcs[2]-1, pcs[3]-1, pcs[4]-1);
                 // assembled_editor.SetCursorPosition({static_cast<int>(pcs[3]),0});
                 
-                std::vector<std::unique_ptr<const InstrContext>> instructions = vm.GetInstructions().pipeline;
-                std::vector<uint64_t> line_numbers(5);
-
-                for(int i=0;i<5;i++){
-                    const auto* instruction = dynamic_cast<const rv5s::PipelinedInstrContext*>(instructions[i].get());
-                    if(instruction){
-                        if(instruction->bubbled || instruction->nopped){
-                            line_numbers[i] = -1;
-                        }
-                        else{
-                            uint64_t instr_pc = instruction->pc;
-                            line_numbers[i] = vm.program_.instruction_number_line_number_mapping[instr_pc/4] - 1;
-                        }
+                std::span<const InstrSlot> instructions = vm_snapshot->pipeline.Pipeline();
+                std::array<uint64_t, 5> line_numbers;
+
+                for(size_t i=0;i<line_numbers.size();i++){
+                    if(i>=instructions.size() || instructions[i].bubbled || instructions[i].nopped){
+                        line_numbers[i] = -1;
                     }
                     else{
-                        std::cerr << "Tried to downcast InstrContext to PipelinedInstrContext while setting debug lines" << std::endl;
-                        line_numbers[i] = -1;
+                        uint64_t instr_pc = instructions[i].pc;
+                        line_numbers[i] = vm_snapshot->program->instruction_number_line_number_mapping[instr_pc/4] - 1;
                     }
                 }
 
@@ -20,6 +20,10 @@ static void glfw_error_callback(int error, const char* description)
 // Main code
 int gui_main()
 {
+    // [Cache] etc. from vm_state/config.ini, picked up by the next LoadVM
+    vm_config::LoadConfigFile(globals::config_file_path);
+    vm_worker.Start();
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit())
         return 1;
@@ -105,6 +109,20 @@ int gui_main()
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
+        // the windows read the VM through this until the frame is built
+        std::optional<sim_worker::SimWorker::SnapshotView> snapshot = vm_worker.AcquireSnapshot();
+        vm_snapshot = snapshot->get();
+        const bool sim_busy = vm_worker.Busy();
+
+        // switch to the execute view once a LOAD posted by Assemble went through
+        static uint64_t AWAITED_LOADS = 0;
+        if(AWAITED_LOADS!=0 && vm_snapshot->loads>=AWAITED_LOADS){
+            if(!vm_snapshot->load_failed){
+                in_editor = false; in_execute = true; in_processor = false; in_memory = false;
+            }
+            AWAITED_LOADS = 0;
+        }
+
         ImGuiViewport* main_viewport = ImGui::GetMainViewport();
         ImVec2 main_viewport_pos = main_viewport->Pos;
         ImVec2 main_viewport_size = main_viewport->Size; 
@@ -200,36 +218,38 @@ int gui_main()
             const float button_height = top_panel_height * 0.86f;
             const float spacing       = 12.0f;
 
+            // everything but Stop waits for the worker to go idle
+            ImGui::BeginDisabled(sim_busy);
             if(ImGui::Button("Assemble",ImVec2(button_width,button_height))){
                 text_editor.SaveFile();
-                try{
-                    vm.LoadVM(assemble(text_editor.FilePath()));
-                    globals::vm_cout_file << "Assembly successful!" << std::endl << std::endl;
-                    in_editor = false; in_execute = true; in_processor = false; in_memory = false;
-                } catch(const std::runtime_error& e){
-                    globals::vm_cout_file << "Assembly failed." << std::endl;
-                    std::cerr << "Error: " << e.what() << std::endl;
-                }
+                vm_worker.Post(command_handler::CommandType::LOAD, {text_editor.FilePath()});
+                AWAITED_LOADS = vm_snapshot->loads + 1;
             }
             ImGui::SameLine(0.0f, spacing);
 
             if(ImGui::Button("Undo", ImVec2(button_width,button_height))){
-                vm.Undo();
+                vm_worker.Post(command_handler::CommandType::UNDO);
             }
             ImGui::SameLine(0.0f, spacing);
 
             if(ImGui::Button("Step", ImVec2(button_width, button_height))){
-                vm.Step();
+                vm_worker.Post(command_handler::CommandType::STEP);
             }
             ImGui::SameLine(0.0f, spacing);
 
             if(ImGui::Button("Run", ImVec2(button_width,button_height))) {
-                vm.DebugRun();
+                vm_worker.Post(command_handler::CommandType::DEBUG_RUN);
             }
             ImGui::SameLine(0.0f, spacing);
 
             if(ImGui::Button("Run FF", ImVec2(button_width,button_height))) {
-                vm.Run();
+                vm_worker.Post(command_handler::CommandType::RUN);
+            }
+            ImGui::EndDisabled();
+            ImGui::SameLine(0.0f, spacing);
+
+            if(ImGui::Button("Stop", ImVec2(button_width,button_height))) {
+                vm_worker.Stop();
             }
 
             if(in_processor){
@@ -240,9 +260,12 @@ int gui_main()
             }
 
             ImGui::SameLine(0.0f, spacing);
+            // the modal writes vm_config::config, which a running model reads
+            ImGui::BeginDisabled(sim_busy);
             if(ImGui::Button("Processor", ImVec2(button_width, button_height))){
                 ImGui::OpenPopup("Processor Selection Modal");
             }
+            ImGui::EndDisabled();
 
             // Step N cycles
             ImGui::SameLine(0.0f, spacing);
@@ -275,10 +298,11 @@ int gui_main()
                 }
                 ImGui::EndGroup();
                 
-                if(EXEC){
+                // one step per frame, so each one gets drawn
+                if(EXEC && !sim_busy){
                     if(STEP_N > 0){
                         STEP_N--;
-                        vm.Step();
+                        vm_worker.Post(command_handler::CommandType::STEP);
                     } else {
                         EXEC = false;
                     }
@@ -483,6 +507,10 @@ int gui_main()
         }
         // ImGui::ShowDemoWindow();
 
+        // hand the snapshot back before rendering, so the worker can publish while we wait on vsync
+        vm_snapshot = nullptr;
+        snapshot.reset();
+
         // Rendering
         ImGui::Render();
         int display_w, display_h;
@@ -497,6 +525,7 @@ int gui_main()
     ImGui::PopFont();
 
     // Cleanup
+    vm_worker.Shutdown();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -1,11 +1,9 @@
 #include "../../include/gui/gui_memory.h"
-#include "sim_state.h"
 
 size_t NUM_ROWS = 32;
 uint64_t MEM_START_ADDRESS = 0;
 uint64_t MEM_END_ADDRESS = MEM_START_ADDRESS + NUM_ROWS;
 
-std::vector<uint64_t> MEMORY_VALUES;
 
 std::string conv_uint64_to_hex(uint64_t val){
     std::stringstream ss;
@@ -20,20 +18,21 @@ std::string conv_byte_to_bin(uint8_t val){
     return binary.to_string();
 }
 
+// the worker reads the rows into every snapshot it publishes from now on
 void update_memory(){
-    MEMORY_VALUES.clear();
-    for(size_t i=0;i<NUM_ROWS;i++){
-        MEMORY_VALUES.push_back(vm.ReadMemDoubleWord(MEM_START_ADDRESS + i*8));
-    }
+    vm_worker.Post(command_handler::CommandType::GET_MEMORY_POINT, {std::to_string(MEM_START_ADDRESS), std::to_string(NUM_ROWS)});
 }
 
 
 void memory_main(){
     static bool inited = false;
-    if(!inited || SimState_.MEMORY_DIRTY){
+    if(!inited){
         update_memory();
-        SimState_.MEMORY_DIRTY = false;
+        inited = true;
     }
+    // rows of the window the last snapshot was taken at, the one just asked for shows up on the next publish
+    const std::vector<uint64_t>& MEMORY_VALUES = vm_snapshot->memory;
+    const uint64_t SNAPSHOT_START_ADDRESS = vm_snapshot->memory_start;
 
     ImVec2 WINDOW_SIZE = ImGui::GetWindowSize();
     ImVec2 WINDOW_POS = ImGui::GetWindowPos();
@@ -87,7 +86,7 @@ void memory_main(){
         ImU32 alternate_light_color = ImGui::ColorConvertFloat4ToU32({70.0f/255.0f, 70.0f/255.0f, 70.0f/255.0f, 1.0f});
         ImGui::PushFont(row_font);
         {
-            for(size_t i=0;i<NUM_ROWS;i++){
+            for(size_t i=0;i<std::min(NUM_ROWS, MEMORY_VALUES.size());i++){
                 if(row_cursor.y + row_size_y <= header_start_y + header_size_y){
                     row_cursor.y += row_size_y;
                     continue;
@@ -112,7 +111,7 @@ void memory_main(){
                 
                 // address
                 row_cursor.x += address_block_size_x / 2.0f;
-                std::string mem_address = conv_uint64_to_hex(MEM_START_ADDRESS + i*8);
+                std::string mem_address = conv_uint64_to_hex(SNAPSHOT_START_ADDRESS + i*8);
                 float text_size = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, mem_address.c_str()).x;
                 row_cursor.x -= text_size/2.0f;
                 draw_list->AddText(row_cursor, row_color, mem_address.c_str());
@@ -224,7 +223,7 @@ void parse_address(std::string address){
     }
 
     MEM_END_ADDRESS = MEM_START_ADDRESS + NUM_ROWS;
-    SimState_.MEMORY_DIRTY = true;
+    update_memory();
 }
 
 
@@ -257,11 +256,11 @@ void memory_navigator_main(){
     if(ImGui::Button("UP", {button_size.x, button_size.y})){
         if(MEM_START_ADDRESS<NUM_ROWS){
             MEM_START_ADDRESS = 0;
-            SimState_.MEMORY_DIRTY = true;
+            update_memory();
         }
         else{
             MEM_START_ADDRESS -= NUM_ROWS;
-            SimState_.MEMORY_DIRTY = true;
+            update_memory();
         }
     }
 
@@ -270,11 +269,11 @@ void memory_navigator_main(){
     if(ImGui::Button("DOWN", {button_size.x, button_size.y})){
         if(vm_config::config.getMemorySize() - NUM_ROWS < MEM_START_ADDRESS){
             MEM_START_ADDRESS = vm_config::config.getMemorySize() - NUM_ROWS * 8;
-            SimState_.MEMORY_DIRTY = true;
+            update_memory();
         }
         else{
             MEM_START_ADDRESS += NUM_ROWS;
-            SimState_.MEMORY_DIRTY = true;
+            update_memory();
         }
     }
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include "../include/gui/gui_processor_window.h"
 #include "gui/gui_common.h"
 #include "sim_state.h"
-#include "vm/rv5s/pipelined/core/instruction_context/instruction_context.h"
-#include "vm/dual_issue/core/instruction_context/instruction_context.h"
-#include "vm/instruction_context.h"
+#include "vm/pipeline_snapshot.h"
+
+#include <span>
 
 // alu struct, stores the top_left_coords of the alu and the height of the alu.
 struct AluStruct{
@@ -332,7 +332,7 @@ void draw_ex_stage(WindowConfig& window_config){
         draw_list->AddText(text_pos_mux, window_config.col, "MX");
 
         // Alu mux if data forwarding is enabled
-        if(vm.ForwardingEnabled()){
+        if(vm_snapshot->forwarding_enabled){
             mux_top_left.y = window_config.main_alu.get_input1_line_coords().y-mux_height*0.5f;
             mux_bottom_right.y = mux_top_left.y + mux_height;
             window_config.alu_mux_forward = Rectangle{mux_top_left, mux_bottom_right};
@@ -527,7 +527,7 @@ void draw_id_buses(WindowConfig& window_config){
         ImVec2 register_file_output_reg2{register_file.bottom_right.x, alu_mux_input1.y};
 
         draw_list->AddLine(register_file_output_reg2, alu_mux_input1, window_config.col, window_config.thickness);
-        if(vm.ForwardingEnabled()){
+        if(vm_snapshot->forwarding_enabled){
             ImVec2 alu_mux_forward_in{window_config.alu_mux_forward.top_left.x, (window_config.alu_mux_forward.bottom_right.y + window_config.alu_mux_forward.top_left.y)/2.0f};
             ImVec2 alu_mux_forward_out{window_config.alu_mux_forward.bottom_right.x, alu_mux_forward_in.y};
             draw_list->AddLine(register_file_output_reg1, alu_mux_forward_in, window_config.col, window_config.thickness);
@@ -706,33 +706,33 @@ void draw_data_forwarding_unit(WindowConfig& window_config){
         static bool lit_up_ex_mem = false;
         static bool lit_up_mem_wb = false;
 
-        if(SimState_.DATA_FORWARD){
+        if(vm_snapshot->sim_state.DATA_FORWARD){
             frame_count = 120;
-            SimState_.DATA_FORWARD = false;
+            vm_snapshot->sim_state.DATA_FORWARD = false;
 
             lit_up_rs1 = false;
             lit_up_rs2 = false;
             lit_up_ex_mem = false;
             lit_up_mem_wb = false;
 
-            if(SimState_.DF_PATH == SimState::DataForwardPaths::EXEC_MEM_RS1){
+            if(vm_snapshot->sim_state.DF_PATH == SimState::DataForwardPaths::EXEC_MEM_RS1){
                 lit_up_rs1 = true;
                 lit_up_ex_mem = true;
             }
-            else if(SimState_.DF_PATH == SimState::DataForwardPaths::EXEC_MEM_RS2){
+            else if(vm_snapshot->sim_state.DF_PATH == SimState::DataForwardPaths::EXEC_MEM_RS2){
                 lit_up_rs2 = true;
                 lit_up_ex_mem = true;
             }
-            else if(SimState_.DF_PATH == SimState::DataForwardPaths::MEM_WB_RS1){
+            else if(vm_snapshot->sim_state.DF_PATH == SimState::DataForwardPaths::MEM_WB_RS1){
                 lit_up_rs1 = true;
                 lit_up_mem_wb = true;
             }
-            else if(SimState_.DF_PATH == SimState::DataForwardPaths::MEM_WB_RS2){
+            else if(vm_snapshot->sim_state.DF_PATH == SimState::DataForwardPaths::MEM_WB_RS2){
                 lit_up_rs2 = true;
                 lit_up_mem_wb = true;
             }
 
-            if(SimState_.DF_ALL){
+            if(vm_snapshot->sim_state.DF_ALL){
                 lit_up_rs1 = true;
                 lit_up_rs2 = true;
                 lit_up_ex_mem = true;
@@ -837,9 +837,9 @@ void draw_hazard_detector(WindowConfig& window_config){
     {
         // bus from {ex-mem register, detector}
         {
-            if(SimState_.HAZARD_DETECTED && SimState_.HZ_PATH == SimState::HazardPaths::EXEC_MEM){
+            if(vm_snapshot->sim_state.HAZARD_DETECTED && vm_snapshot->sim_state.HZ_PATH == SimState::HazardPaths::EXEC_MEM){
                 frame_count = 120;
-                SimState_.HAZARD_DETECTED = false;
+                vm_snapshot->sim_state.HAZARD_DETECTED = false;
             }
 
             if(frame_count>0){
@@ -848,7 +848,7 @@ void draw_hazard_detector(WindowConfig& window_config){
             }
             
             // bypass data forwarding unit
-            if(vm.ForwardingEnabled()){
+            if(vm_snapshot->forwarding_enabled){
                 ImVec2 p1{mem_stage_start, window_config.WINDOW_POS.y + window_config.stage_height};
                 ImVec2 p2{p1.x, (window_config.data_forwarding_unit.top_left.y + p1.y) / 2.0f};
                 ImVec2 p3{p2.x + window_config.data_forwarding_unit_width * 0.6f, p2.y};
@@ -870,9 +870,9 @@ void draw_hazard_detector(WindowConfig& window_config){
 
         // bus from {mem-wb register, detector}
         {
-            if(SimState_.HAZARD_DETECTED && SimState_.HZ_PATH == SimState::HazardPaths::MEM_WB){
+            if(vm_snapshot->sim_state.HAZARD_DETECTED && vm_snapshot->sim_state.HZ_PATH == SimState::HazardPaths::MEM_WB){
                 frame_count = 120;
-                SimState_.HAZARD_DETECTED = false;
+                vm_snapshot->sim_state.HAZARD_DETECTED = false;
             }
 
             if(frame_count>0){
@@ -880,7 +880,7 @@ void draw_hazard_detector(WindowConfig& window_config){
                 window_config.col = window_config.red_col;
             }
 
-            if(!vm.ForwardingEnabled()){
+            if(!vm_snapshot->forwarding_enabled){
                 ImVec2 p1{wb_stage_start, window_config.WINDOW_POS.y + window_config.stage_height};
                 ImVec2 p2{p1.x, (window_config.hazard_detector.top_left.y + window_config.hazard_detector.bottom_right.y) / 2.0f};
                 ImVec2 p3{window_config.hazard_detector.bottom_right.x, p2.y};
@@ -911,73 +911,73 @@ void draw_hazard_detector(WindowConfig& window_config){
 }
 
 
-std::vector<std::pair<std::string, std::string>> decode_stage_instr_fields(const rv5s::PipelinedInstrContext* instr){
+std::vector<std::pair<std::string, std::string>> decode_stage_instr_fields(const InstrSlot& instr){
     std::vector<std::pair<std::string, std::string>> cont;
 
-    cont.push_back({"PC", std::to_string(instr->pc)});
+    cont.push_back({"PC", std::to_string(instr.pc)});
     cont.push_back({"##separate##", "##separate##"});
 
-    cont.push_back({"Instruction", std::to_string(instr->instruction)});
-    cont.push_back({"   Opcode", std::to_string(instr->opcode)});
-    cont.push_back({"   Funct2", std::to_string(instr->funct2)});
-    cont.push_back({"   Funct3", std::to_string(instr->funct3)});
-    cont.push_back({"   Funct5", std::to_string(instr->funct5)});
-    cont.push_back({"   Funct7", std::to_string(instr->funct7)});
+    cont.push_back({"Instruction", std::to_string(instr.instruction)});
+    cont.push_back({"   Opcode", std::to_string(instr.opcode)});
+    cont.push_back({"   Funct2", std::to_string(instr.funct2)});
+    cont.push_back({"   Funct3", std::to_string(instr.funct3)});
+    cont.push_back({"   Funct5", std::to_string(instr.funct5)});
+    cont.push_back({"   Funct7", std::to_string(instr.funct7)});
     cont.push_back({"##separate##", "##separate##"});
 
-    cont.push_back({"Writeback", std::to_string(instr->reg_write)});
-    if(instr->reg_write){
-        cont.push_back({"   Writeback To GPR", std::to_string(!instr->reg_write_to_fpr)});
-        cont.push_back({"   Writeback To FPR", std::to_string(instr->reg_write_to_fpr)});
-        cont.push_back({"   Writeback From Alu", std::to_string(!instr->mem_to_reg)});
-        cont.push_back({"   Writeback From Memory", std::to_string(instr->mem_to_reg)});
+    cont.push_back({"Writeback", std::to_string(instr.reg_write)});
+    if(instr.reg_write){
+        cont.push_back({"   Writeback To GPR", std::to_string(!instr.reg_write_to_fpr)});
+        cont.push_back({"   Writeback To FPR", std::to_string(instr.reg_write_to_fpr)});
+        cont.push_back({"   Writeback From Alu", std::to_string(!instr.mem_to_reg)});
+        cont.push_back({"   Writeback From Memory", std::to_string(instr.mem_to_reg)});
     }
     cont.push_back({"##separate##", "##separate##"});
 
-    cont.push_back({"Branch type", std::to_string(instr->branch)});
-    if(instr->branch){
-        cont.push_back({"   Branch Was Predicted Taken", std::to_string(instr->branch_predicted_taken)});
+    cont.push_back({"Branch type", std::to_string(instr.branch)});
+    if(instr.branch){
+        cont.push_back({"   Branch Was Predicted Taken", std::to_string(instr.branch_predicted_taken)});
     }
     cont.push_back({"##separate##", "##separate##"});
 
-    cont.push_back({"RS1", std::to_string(instr->rs1)});
-    cont.push_back({"RS2", std::to_string(instr->rs2)});
-    cont.push_back({"(F)RS3", std::to_string(instr->frs3)});
-    cont.push_back({"RD", std::to_string(instr->rd)});
+    cont.push_back({"RS1", std::to_string(instr.rs1)});
+    cont.push_back({"RS2", std::to_string(instr.rs2)});
+    cont.push_back({"(F)RS3", std::to_string(instr.frs3)});
+    cont.push_back({"RD", std::to_string(instr.rd)});
     cont.push_back({"##line##", "##line##"});
-    cont.push_back({"Uses RS1", std::to_string(instr->uses_rs1)});
-    cont.push_back({"Uses RS2", std::to_string(instr->uses_rs2)});
-    cont.push_back({"Uses RS3", std::to_string(instr->uses_rs3)});
+    cont.push_back({"Uses RS1", std::to_string(instr.uses_rs1)});
+    cont.push_back({"Uses RS2", std::to_string(instr.uses_rs2)});
+    cont.push_back({"Uses RS3", std::to_string(instr.uses_rs3)});
     cont.push_back({"##line##", "##line##"});
-    cont.push_back({"RS1 from GPR", std::to_string(!instr->rs1_from_fprf)});
-    cont.push_back({"RS2 from GPR", std::to_string(!instr->rs2_from_fprf)});
+    cont.push_back({"RS1 from GPR", std::to_string(!instr.rs1_from_fprf)});
+    cont.push_back({"RS2 from GPR", std::to_string(!instr.rs2_from_fprf)});
     cont.push_back({"##line##", "##line##"});
-    cont.push_back({"RS1 value (GPR)", std::to_string(instr->rs1_value)});
-    cont.push_back({"RS2 value (GPR)", std::to_string(instr->rs2_value)});
-    cont.push_back({"RS1 value (FPR)", std::to_string(instr->frs1_value)});
-    cont.push_back({"RS2 value (FPR)", std::to_string(instr->frs2_value)});
-    cont.push_back({"RS3 value (FPR)", std::to_string(instr->frs3_value)});
+    cont.push_back({"RS1 value (GPR)", std::to_string(instr.rs1_value)});
+    cont.push_back({"RS2 value (GPR)", std::to_string(instr.rs2_value)});
+    cont.push_back({"RS1 value (FPR)", std::to_string(instr.frs1_value)});
+    cont.push_back({"RS2 value (FPR)", std::to_string(instr.frs2_value)});
+    cont.push_back({"RS3 value (FPR)", std::to_string(instr.frs3_value)});
     cont.push_back({"##separate##", "##separate##"});
 
-    cont.push_back({"Uses Immediate", std::to_string(instr->imm_to_alu)});
-    if(instr->imm_to_alu)
-        cont.push_back({"   Immediate", std::to_string(instr->immediate)});
+    cont.push_back({"Uses Immediate", std::to_string(instr.imm_to_alu)});
+    if(instr.imm_to_alu)
+        cont.push_back({"   Immediate", std::to_string(instr.immediate)});
     cont.push_back({"##separate##", "##separate##"});
     
     
-    cont.push_back({"Nopped", std::to_string(instr->nopped)});
-    cont.push_back({"Bubbled", std::to_string(instr->bubbled)});
+    cont.push_back({"Nopped", std::to_string(instr.nopped)});
+    cont.push_back({"Bubbled", std::to_string(instr.bubbled)});
     cont.push_back({"##separate##", "##separate##"});
     
-    cont.push_back({"Memory Access", std::to_string(instr->mem_read || instr->mem_write)});
-    if(instr->mem_read || instr->mem_write){
-        cont.push_back({"   Memory Access Bytes", std::to_string(instr->mem_access_bytes)});
-        cont.push_back({"   Sign Extend", std::to_string(instr->sign_extend)});
-        cont.push_back({"   Memory Read", std::to_string(instr->mem_read)});
-        cont.push_back({"   Memory Write", std::to_string(instr->mem_write)});
-        if(instr->mem_write){
-            cont.push_back({"       Memory Write Data", std::to_string(instr->rs2_value)});
-            cont.push_back({"       Memory Write Data From GPR", std::to_string(instr->mem_write_data_from_gpr)});
+    cont.push_back({"Memory Access", std::to_string(instr.mem_read || instr.mem_write)});
+    if(instr.mem_read || instr.mem_write){
+        cont.push_back({"   Memory Access Bytes", std::to_string(instr.mem_access_bytes)});
+        cont.push_back({"   Sign Extend", std::to_string(instr.sign_extend)});
+        cont.push_back({"   Memory Read", std::to_string(instr.mem_read)});
+        cont.push_back({"   Memory Write", std::to_string(instr.mem_write)});
+        if(instr.mem_write){
+            cont.push_back({"       Memory Write Data", std::to_string(instr.rs2_value)});
+            cont.push_back({"       Memory Write Data From GPR", std::to_string(instr.mem_write_data_from_gpr)});
         }
     }
 
@@ -985,13 +985,13 @@ std::vector<std::pair<std::string, std::string>> decode_stage_instr_fields(const
 }
 
 
-std::vector<std::pair<std::string, std::string>> get_instr_context(const rv5s::PipelinedInstrContext* instr, int stage){
+std::vector<std::pair<std::string, std::string>> get_instr_context(const InstrSlot& instr, int stage){
     std::vector<std::pair<std::string, std::string>> cont;
 
     switch(stage){
         case 0 : {
-            cont.push_back({"PC", std::to_string(instr->pc)});
-            cont.push_back({"Instruction", std::to_string(instr->instruction)});
+            cont.push_back({"PC", std::to_string(instr.pc)});
+            cont.push_back({"Instruction", std::to_string(instr.instruction)});
             break;
         }
         case 1 : {
@@ -1001,21 +1001,21 @@ std::vector<std::pair<std::string, std::string>> get_instr_context(const rv5s::P
         case 2 : {
             cont = decode_stage_instr_fields(instr);
             cont.push_back({"##separate##", "##separate##"});
-            cont.push_back({"ALU output", std::to_string(instr->alu_out)});
+            cont.push_back({"ALU output", std::to_string(instr.alu_out)});
             break;
         }
         case 3 : {
             cont = decode_stage_instr_fields(instr);
             cont.push_back({"##separate##", "##separate##"});
-            cont.push_back({"ALU output", std::to_string(instr->alu_out)});
-            cont.push_back({"Memory output", std::to_string(instr->mem_out)});
+            cont.push_back({"ALU output", std::to_string(instr.alu_out)});
+            cont.push_back({"Memory output", std::to_string(instr.mem_out)});
             break;
         }
         case 4 : {
             cont = decode_stage_instr_fields(instr);
             cont.push_back({"##separate##", "##separate##"});
-            cont.push_back({"ALU output", std::to_string(instr->alu_out)});
-            cont.push_back({"Memory output", std::to_string(instr->mem_out)});
+            cont.push_back({"ALU output", std::to_string(instr.alu_out)});
+            cont.push_back({"Memory output", std::to_string(instr.mem_out)});
             break;
         }
     }
@@ -1025,9 +1025,12 @@ std::vector<std::pair<std::string, std::string>> get_instr_context(const rv5s::P
 
 
 void draw_instructions(WindowConfig& window_config){
-    std::vector<std::unique_ptr<const InstrContext>> instructions = vm.GetInstructions().pipeline;
+    std::span<const InstrSlot> instructions = vm_snapshot->pipeline.Pipeline();
+    if(instructions.empty()){
+        return;
+    }
     
-    if(vm.PipeliningEnabled()){
+    if(vm_snapshot->pipelining_enabled){
         float if_stage_start = window_config.WINDOW_POS.x;
         float id_stage_start = if_stage_start + window_config.IF_STAGE_WIDTH_FRAC * window_config.WINDOW_SIZE.x;
         float ex_stage_start = id_stage_start + window_config.ID_STAGE_WIDTH_FRAC * window_config.WINDOW_SIZE.x;
@@ -1039,24 +1042,20 @@ void draw_instructions(WindowConfig& window_config){
 
         for(size_t i=0;i<instructions.size();i++){
             std::string instr_dissassembled;
-            const rv5s::PipelinedInstrContext* instruction = dynamic_cast<const rv5s::PipelinedInstrContext*>(instructions[i].get());
-            if(!instruction){
-                std::cerr << "Tried to downcast InstrContext to PipelinedInstrContext while setting debug lines" << std::endl;
-                continue;
-            }
-            uint64_t instr_pc = instruction->pc;
-            if(vm.program_.intermediate_code.size()>instr_pc/4){
-                ICUnit& t = vm.program_.intermediate_code[instr_pc/4].first;
+            const InstrSlot& instruction = instructions[i];
+            uint64_t instr_pc = instruction.pc;
+            if(vm_snapshot->program->intermediate_code.size()>instr_pc/4){
+                ICUnit& t = vm_snapshot->program->intermediate_code[instr_pc/4].first;
                 instr_dissassembled += t.to_string();
             }
-            else if(!instruction->bubbled)
+            else if(!instruction.bubbled)
                 continue;
 
-            if(instruction->bubbled){
+            if(instruction.bubbled){
                 instr_dissassembled = "BUBBLE";
             }
 
-            if(instruction->nopped || instruction->bubbled){
+            if(instruction.nopped || instruction.bubbled){
                 window_config.col = window_config.red_col;
             }
     
@@ -1070,7 +1069,7 @@ void draw_instructions(WindowConfig& window_config){
             ImDrawList* drawlist = ImGui::GetWindowDrawList();
             drawlist->AddText(text_start, window_config.col, instr_dissassembled.c_str());
 
-            if(instruction->nopped || instruction->bubbled){
+            if(instruction.nopped || instruction.bubbled){
                 window_config.col = ImGui::ColorConvertFloat4ToU32({1.0f, 1.0f, 1.0f, 1.0f});
             }
 
@@ -1136,10 +1135,10 @@ void draw_instructions(WindowConfig& window_config){
     }
     else{
         std::string instr_dissassembled;
-        const InstrContext& instruction = *instructions[0].get();
+        const InstrSlot& instruction = instructions[0];
         uint64_t instr_pc = instruction.pc;
-        if(vm.program_.intermediate_code.size()>instr_pc/4){
-            ICUnit& t = vm.program_.intermediate_code[instr_pc/4].first;
+        if(vm_snapshot->program->intermediate_code.size()>instr_pc/4){
+            ICUnit& t = vm_snapshot->program->intermediate_code[instr_pc/4].first;
             instr_dissassembled += t.to_string();
         }
         else
@@ -1177,19 +1176,19 @@ void pipelined_single_cycle_main() {
         
 
         // Pipelining:
-        if(vm.PipeliningEnabled()){
-            if(vm.HazardEnabled() || vm.ForwardingEnabled()){
-                if(vm.HazardEnabled() && vm.ForwardingEnabled()){
+        if(vm_snapshot->pipelining_enabled){
+            if(vm_snapshot->hazard_enabled || vm_snapshot->forwarding_enabled){
+                if(vm_snapshot->hazard_enabled && vm_snapshot->forwarding_enabled){
                     window_config.stage_height -= 3.0f * window_config.hardware_buffer;
                 }
                 else{
                     window_config.stage_height -= 2.0f * window_config.hardware_buffer;
                 }
 
-                if(vm.HazardEnabled()){
+                if(vm_snapshot->hazard_enabled){
                     window_config.stage_height -= window_config.hazard_detector_height;
                 }
-                if(vm.ForwardingEnabled()){
+                if(vm_snapshot->forwarding_enabled){
                     window_config.stage_height -= window_config.data_forwarding_unit_height;
                 }
             }
@@ -1211,9 +1210,9 @@ void pipelined_single_cycle_main() {
 
         // change color to yellow for 60 frames
         static int frame_count = 0;
-        if(SimState_.LIT_UP){
+        if(vm_snapshot->sim_state.LIT_UP){
             frame_count = 30;
-            SimState_.LIT_UP = false;
+            vm_snapshot->sim_state.LIT_UP = false;
         }
 
         if(frame_count>0){
@@ -1231,11 +1230,11 @@ void pipelined_single_cycle_main() {
         window_config.col = window_config.white_col;
 
         // Pipelining:
-        if(vm.PipeliningEnabled()){
-            if(vm.ForwardingEnabled()){
+        if(vm_snapshot->pipelining_enabled){
+            if(vm_snapshot->forwarding_enabled){
                 draw_data_forwarding_unit(window_config);
             }
-            if(vm.HazardEnabled()){
+            if(vm_snapshot->hazard_enabled){
                 draw_hazard_detector(window_config);
             }
             draw_pipeline_registers(window_config);
@@ -1366,19 +1365,12 @@ void draw_headings(DualIssueWindowVars& window_config){
 }
 
 
-void dual_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrContext& instr1__, const InstrContext& instr2__, Rectangle& pipeline, ImVec4& default_col){
+void dual_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrSlot& instr1_, const InstrSlot& instr2_, Rectangle& pipeline, ImVec4& default_col){
     ImDrawList* drawlist = ImGui::GetWindowDrawList();
 
-    const dual_issue::DualIssueInstrContext* instr1_ = dynamic_cast<const dual_issue::DualIssueInstrContext*>(&instr1__);
-    const dual_issue::DualIssueInstrContext* instr2_ = dynamic_cast<const dual_issue::DualIssueInstrContext*>(&instr2__);
-    if(!instr1_ || !instr2_){
-        std::cerr << "Tried downcasting InstrContext into DualIssueInstrContext" << std::endl;
-        return;
-    }
-
     std::string instr1;
-    if(vm.program_.intermediate_code.size()>instr1_->pc/4 && !instr1_->illegal){
-        instr1 = vm.program_.intermediate_code[instr1_->pc/4].first.to_string();
+    if(vm_snapshot->program->intermediate_code.size()>instr1_.pc/4 && !instr1_.illegal){
+        instr1 = vm_snapshot->program->intermediate_code[instr1_.pc/4].first.to_string();
         window_config.col = ImGui::ColorConvertFloat4ToU32(default_col);
     }
     else{
@@ -1392,8 +1384,8 @@ void dual_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrContex
     drawlist->AddText({text_top_left_x, text_top_left_y}, window_config.col, instr1.c_str(), NULL);
     
     std::string instr2;
-    if(vm.program_.intermediate_code.size()>instr2_->pc/4 && !instr2_->illegal){
-        instr2 = vm.program_.intermediate_code[instr2_->pc/4].first.to_string();
+    if(vm_snapshot->program->intermediate_code.size()>instr2_.pc/4 && !instr2_.illegal){
+        instr2 = vm_snapshot->program->intermediate_code[instr2_.pc/4].first.to_string();
         window_config.col = ImGui::ColorConvertFloat4ToU32(default_col);
     }
     else{
@@ -1409,7 +1401,7 @@ void dual_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrContex
 }
 
 
-void dual_draw_rsrvstn_que(DualIssueWindowVars& window_config, std::vector<std::unique_ptr<const InstrContext>>& que, Rectangle& station){
+void dual_draw_rsrvstn_que(DualIssueWindowVars& window_config, std::span<const InstrSlot> que, Rectangle& station){
     ImGui::SetNextWindowPos(station.top_left);
     ImGui::BeginChild(("Queue window" + std::to_string(station.top_left.x)).c_str(), window_config.rsrvstn_size);
     {
@@ -1417,16 +1409,12 @@ void dual_draw_rsrvstn_que(DualIssueWindowVars& window_config, std::vector<std::
 
             
             for(int i=static_cast<int>(que.size()-1);i>=0;i--){
-                const dual_issue::DualIssueInstrContext* instr = dynamic_cast<const dual_issue::DualIssueInstrContext*>(que[i].get());
-                if(!instr){
-                    std::cerr << "Tried downcasting InstrContext into DualIssueInstrContext" << std::endl;
-                    return;
-                }
+                const InstrSlot* instr = &que[i];
 
                 std::string dissassembled_instr;
                 int pop_count = 0;
-                if(vm.program_.intermediate_code.size()>instr->pc/4 && !instr->illegal){
-                    dissassembled_instr = vm.program_.intermediate_code[instr->pc/4].first.to_string();
+                if(vm_snapshot->program->intermediate_code.size()>instr->pc/4 && !instr->illegal){
+                    dissassembled_instr = vm_snapshot->program->intermediate_code[instr->pc/4].first.to_string();
                     ImGui::PushStyleColor(ImGuiCol_Text, window_config.default_col);
                     pop_count++;
                 }
@@ -1465,23 +1453,19 @@ void dual_draw_rsrvstn_que(DualIssueWindowVars& window_config, std::vector<std::
 }
 
 
-void dual_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<std::unique_ptr<const InstrContext>>& buffer, Rectangle& rob, std::vector<bool>& buffer_status, std::pair<size_t, size_t> head_tail){
+void dual_draw_reorder_buffer(DualIssueWindowVars& window_config, std::span<const InstrSlot> buffer, Rectangle& rob, std::pair<size_t, size_t> head_tail){
     ImGui::SetNextWindowPos(rob.top_left);
     ImGui::BeginChild("Reorder buffer window", window_config.reorder_buffer_size);
     {
         if(ImGui::BeginTable("Queue", 1, ImGuiTableFlags_Borders)){
     
             for(size_t i=0;i<buffer.size();i++){
-                const dual_issue::DualIssueInstrContext* instr = dynamic_cast<const dual_issue::DualIssueInstrContext*>(buffer[i].get());
-                if(!instr){
-                    std::cerr << "Tried downcasting InstrContext into DualIssueInstrContext" << std::endl;
-                    return;
-                }
+                const InstrSlot* instr = &buffer[i];
 
                 std::string dissassembled_instr;
                 int pop_count = 0;
-                if(vm.program_.intermediate_code.size()>instr->pc/4 && !instr->illegal){
-                    dissassembled_instr = vm.program_.intermediate_code[instr->pc/4].first.to_string();
+                if(vm_snapshot->program->intermediate_code.size()>instr->pc/4 && !instr->illegal){
+                    dissassembled_instr = vm_snapshot->program->intermediate_code[instr->pc/4].first.to_string();
                     ImGui::PushStyleColor(ImGuiCol_Text, window_config.default_col);
                     pop_count++;
                 }
@@ -1497,7 +1481,7 @@ void dual_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<st
                     pop_count++;
                 }
                 
-                if(!instr->illegal && buffer_status[i]){
+                if(!instr->illegal && instr->ready_to_commit){
                     ImGui::PushStyleColor(ImGuiCol_Text, window_config.ready_col);
                     pop_count++;
                 }
@@ -1523,27 +1507,33 @@ void dual_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<st
 }
 
 
-void dual_draw_instrs(DualIssueWindowVars& window_config, VmBase::InstrView& instrs){
-    // if id pipeline
-    dual_draw_in_pipeline(window_config, *instrs.pipeline[0], *instrs.pipeline[1], window_config.if_id_pipeline, window_config.new_col);
+void dual_draw_instrs(DualIssueWindowVars& window_config, const PipelineSnapshot& instrs){
+    std::span<const InstrSlot> pipeline = instrs.Pipeline();
+
+    // the window lays out the preset machine, a core reshaped from the [Execution] config only shows its
+    // reservation stations and ROB
+    if(pipeline.size()==8){
+        // if id pipeline
+        dual_draw_in_pipeline(window_config, pipeline[0], pipeline[1], window_config.if_id_pipeline, window_config.new_col);
 
-    // id issue pipeline
-    dual_draw_in_pipeline(window_config, *instrs.pipeline[2], *instrs.pipeline[3], window_config.id_issue_pipeline, window_config.new_col);
+        // id issue pipeline
+        dual_draw_in_pipeline(window_config, pipeline[2], pipeline[3], window_config.id_issue_pipeline, window_config.new_col);
 
-    // issue fu pipeline
-    dual_draw_in_pipeline(window_config, *instrs.pipeline[4], *instrs.pipeline[5], window_config.issue_fu_pipeline, window_config.ready_col);
+        // issue fu pipeline
+        dual_draw_in_pipeline(window_config, pipeline[4], pipeline[5], window_config.issue_fu_pipeline, window_config.ready_col);
 
-    // fu commit pipeline
-    dual_draw_in_pipeline(window_config, *instrs.pipeline[6], *instrs.pipeline[7], window_config.fu_commit_pipeline, window_config.ready_col);
+        // fu commit pipeline
+        dual_draw_in_pipeline(window_config, pipeline[6], pipeline[7], window_config.fu_commit_pipeline, window_config.ready_col);
+    }
 
     // alu_que_
-    dual_draw_rsrvstn_que(window_config, instrs.reservation_station_alu, window_config.rsrvstn_alu);
+    dual_draw_rsrvstn_que(window_config, instrs.ReservationStationAlu(), window_config.rsrvstn_alu);
 
     // lsu_que_
-    dual_draw_rsrvstn_que(window_config, instrs.reservation_station_lsu, window_config.rsrvstn_lsu);
+    dual_draw_rsrvstn_que(window_config, instrs.ReservationStationLsu(), window_config.rsrvstn_lsu);
 
     // reorder buffer
-    dual_draw_reorder_buffer(window_config, instrs.reorder_buffer, window_config.reorder_buffer, instrs.rob_status, instrs.rob_head_tail);
+    dual_draw_reorder_buffer(window_config, instrs.ReorderBuffer(), window_config.reorder_buffer, instrs.RobHeadTail());
 }
 
 
@@ -1562,7 +1552,7 @@ void dual_issue_main(){
         draw_headings(window_config);
         ImGui::PopFont();
         
-        VmBase::InstrView instrs = vm.GetInstructions();
+        const PipelineSnapshot& instrs = vm_snapshot->pipeline;
         dual_draw_instrs(window_config, instrs);
     }
     ImGui::EndChild();
@@ -1667,20 +1657,12 @@ void triple_draw_headings(TripleIssueWindowVars& window_config){
 }
 
 
-void triple_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrContext& instr1__, const InstrContext& instr2__, const InstrContext& instr3__, Rectangle& pipeline, ImVec4& default_col){
+void triple_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrSlot& instr1_, const InstrSlot& instr2_, const InstrSlot& instr3_, Rectangle& pipeline, ImVec4& default_col){
     ImDrawList* drawlist = ImGui::GetWindowDrawList();
 
-    const dual_issue::DualIssueInstrContext* instr1_ = dynamic_cast<const dual_issue::DualIssueInstrContext*>(&instr1__);
-    const dual_issue::DualIssueInstrContext* instr2_ = dynamic_cast<const dual_issue::DualIssueInstrContext*>(&instr2__);
-    const dual_issue::DualIssueInstrContext* instr3_ = dynamic_cast<const dual_issue::DualIssueInstrContext*>(&instr3__);
-    if(!instr1_ || !instr2_ || !instr3_){
-        std::cerr << "Tried downcasting InstrContext into DualIssueInstrContext" << std::endl;
-        return;
-    }
-
     std::string instr1;
-    if(vm.program_.intermediate_code.size()>instr1_->pc/4 && !instr1_->illegal){
-        instr1 = vm.program_.intermediate_code[instr1_->pc/4].first.to_string();
+    if(vm_snapshot->program->intermediate_code.size()>instr1_.pc/4 && !instr1_.illegal){
+        instr1 = vm_snapshot->program->intermediate_code[instr1_.pc/4].first.to_string();
         window_config.col = ImGui::ColorConvertFloat4ToU32(default_col);
     }
     else{
@@ -1695,8 +1677,8 @@ void triple_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrCont
     drawlist->AddText({text_top_left_x, text_top_left_y}, window_config.col, instr1.c_str(), NULL);
     
     std::string instr2;
-    if(vm.program_.intermediate_code.size()>instr2_->pc/4 && !instr2_->illegal){
-        instr2 = vm.program_.intermediate_code[instr2_->pc/4].first.to_string();
+    if(vm_snapshot->program->intermediate_code.size()>instr2_.pc/4 && !instr2_.illegal){
+        instr2 = vm_snapshot->program->intermediate_code[instr2_.pc/4].first.to_string();
         window_config.col = ImGui::ColorConvertFloat4ToU32(default_col);
     }
     else{
@@ -1711,8 +1693,8 @@ void triple_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrCont
 
 
     std::string instr3;
-    if(vm.program_.intermediate_code.size()>instr3_->pc/4 && !instr3_->illegal){
-        instr3 = vm.program_.intermediate_code[instr3_->pc/4].first.to_string();
+    if(vm_snapshot->program->intermediate_code.size()>instr3_.pc/4 && !instr3_.illegal){
+        instr3 = vm_snapshot->program->intermediate_code[instr3_.pc/4].first.to_string();
         window_config.col = ImGui::ColorConvertFloat4ToU32(default_col);
     }
     else{
@@ -1730,7 +1712,7 @@ void triple_draw_in_pipeline(DualIssueWindowVars& window_config, const InstrCont
 
 
 
-void triple_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<std::unique_ptr<const InstrContext>>& buffer, Rectangle& rob, std::vector<bool>& buffer_status, bool left){
+void triple_draw_reorder_buffer(DualIssueWindowVars& window_config, std::span<const InstrSlot> buffer, Rectangle& rob, bool left){
     ImGui::SetNextWindowPos(rob.top_left);
     ImGui::BeginChild(("Reorder buffer window" + std::to_string(rob.top_left.x)).c_str(), window_config.reorder_buffer_size);
     {
@@ -1745,16 +1727,12 @@ void triple_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<
             }
 
             for(int i=start;i<end;i++){
-                const dual_issue::DualIssueInstrContext* instr = dynamic_cast<const dual_issue::DualIssueInstrContext*>(buffer[i].get());
-                if(!instr){
-                    std::cerr << "Tried downcasting InstrContext into DualIssueInstrContext" << std::endl;
-                    return;
-                }
+                const InstrSlot* instr = &buffer[i];
 
                 std::string dissassembled_instr;
                 int pop_count = 0;
-                if(vm.program_.intermediate_code.size()>instr->pc/4 && !instr->illegal){
-                    dissassembled_instr = vm.program_.intermediate_code[instr->pc/4].first.to_string();
+                if(vm_snapshot->program->intermediate_code.size()>instr->pc/4 && !instr->illegal){
+                    dissassembled_instr = vm_snapshot->program->intermediate_code[instr->pc/4].first.to_string();
                     ImGui::PushStyleColor(ImGuiCol_Text, window_config.default_col);
                     pop_count++;
                 }
@@ -1764,7 +1742,7 @@ void triple_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<
                     pop_count++;
                 }
                 
-                if(!instr->illegal && buffer_status[i]){
+                if(!instr->illegal && instr->ready_to_commit){
                     ImGui::PushStyleColor(ImGuiCol_Text, window_config.ready_col);
                     pop_count++;
                 }
@@ -1791,31 +1769,37 @@ void triple_draw_reorder_buffer(DualIssueWindowVars& window_config, std::vector<
 
 
 
-void triple_draw_instrs(TripleIssueWindowVars& window_config, VmBase::InstrView& instrs){
-    // if id pipeline
-    triple_draw_in_pipeline(window_config, *instrs.pipeline[0], *instrs.pipeline[1], *instrs.pipeline[2], window_config.if_id_pipeline, window_config.new_col);
+void triple_draw_instrs(TripleIssueWindowVars& window_config, const PipelineSnapshot& instrs){
+    std::span<const InstrSlot> pipeline = instrs.Pipeline();
 
-    // id issue pipeline
-    triple_draw_in_pipeline(window_config, *instrs.pipeline[3], *instrs.pipeline[4], *instrs.pipeline[5], window_config.id_issue_pipeline, window_config.new_col);
+    // the window lays out the preset machine, a core reshaped from the [Execution] config only shows its
+    // reservation stations and ROB
+    if(pipeline.size()==12){
+        // if id pipeline
+        triple_draw_in_pipeline(window_config, pipeline[0], pipeline[1], pipeline[2], window_config.if_id_pipeline, window_config.new_col);
 
-    // issue fu pipeline
-    triple_draw_in_pipeline(window_config, *instrs.pipeline[6], *instrs.pipeline[7], *instrs.pipeline[8], window_config.issue_fu_pipeline, window_config.ready_col);
+        // id issue pipeline
+        triple_draw_in_pipeline(window_config, pipeline[3], pipeline[4], pipeline[5], window_config.id_issue_pipeline, window_config.new_col);
 
-    // fu commit pipeline
-    triple_draw_in_pipeline(window_config, *instrs.pipeline[9], *instrs.pipeline[10], *instrs.pipeline[11], window_config.fu_commit_pipeline, window_config.ready_col);
+        // issue fu pipeline
+        triple_draw_in_pipeline(window_config, pipeline[6], pipeline[7], pipeline[8], window_config.issue_fu_pipeline, window_config.ready_col);
+
+        // fu commit pipeline
+        triple_draw_in_pipeline(window_config, pipeline[9], pipeline[10], pipeline[11], window_config.fu_commit_pipeline, window_config.ready_col);
+    }
 
     // alu_que_
-    dual_draw_rsrvstn_que(window_config, instrs.reservation_station_alu, window_config.rsrvstn_alu);
+    dual_draw_rsrvstn_que(window_config, instrs.ReservationStationAlu(), window_config.rsrvstn_alu);
 
     // falu_que_
-    dual_draw_rsrvstn_que(window_config, instrs.reservation_station_falu, window_config.rsrvstn_falu);
+    dual_draw_rsrvstn_que(window_config, instrs.ReservationStationFalu(), window_config.rsrvstn_falu);
 
     // lsu_que_
-    dual_draw_rsrvstn_que(window_config, instrs.reservation_station_lsu, window_config.rsrvstn_lsu);
+    dual_draw_rsrvstn_que(window_config, instrs.ReservationStationLsu(), window_config.rsrvstn_lsu);
 
     // reorder buffer
-    triple_draw_reorder_buffer(window_config, instrs.reorder_buffer, window_config.reorder_buffer_left, instrs.rob_status, true);
-    triple_draw_reorder_buffer(window_config, instrs.reorder_buffer, window_config.reorder_buffer_right, instrs.rob_status, false);
+    triple_draw_reorder_buffer(window_config, instrs.ReorderBuffer(), window_config.reorder_buffer_left, true);
+    triple_draw_reorder_buffer(window_config, instrs.ReorderBuffer(), window_config.reorder_buffer_right, false);
 }
 
 
@@ -1833,7 +1817,7 @@ void triple_issue_main(){
         triple_draw_headings(window_config);
         ImGui::PopFont();
         
-        VmBase::InstrView instrs = vm.GetInstructions();
+        const PipelineSnapshot& instrs = vm_snapshot->pipeline;
         triple_draw_instrs(window_config, instrs);
     }
     ImGui::EndChild();
@@ -1841,10 +1825,10 @@ void triple_issue_main(){
 
 
 void processor_main(){
-    if(vm.GetType() == VM::Which::DualIssue){
+    if(vm_snapshot->type == VM::Which::DualIssue){
         dual_issue_main();
     }
-    else if(vm.GetType() == VM::Which::TripleIssue){
+    else if(vm_snapshot->type == VM::Which::TripleIssue){
         triple_issue_main();
     }
     else{
@@ -25,7 +25,7 @@ void set_processor_type(){
     }
     ImGui::PopStyleColor();
 
-    static const char* BRANCH_TYPES[] = {"No Prediction", "Static Prediction", "Dynamic Prediction (1-bit)"};
+    static const char* BRANCH_TYPES[] = {"No Prediction", "Static Prediction", "Bimodal (2-bit)", "Gshare", "Tournament"};
     static int BRANCH_IDX = 0;
 
     if(PROCESSOR_IDX != 0){
@@ -100,10 +100,23 @@ void set_processor_type(){
             case 2 : {
                 vm_config::config.branch_prediction_enabled = true;
                 vm_config::config.branch_prediction_static = false;
+                vm_config::config.branch_predictor_config.type = branch_predictor::PredictorType::Bimodal;
+                break;
+            }
+            case 3 : {
+                vm_config::config.branch_prediction_enabled = true;
+                vm_config::config.branch_prediction_static = false;
+                vm_config::config.branch_predictor_config.type = branch_predictor::PredictorType::Gshare;
+                break;
+            }
+            case 4 : {
+                vm_config::config.branch_prediction_enabled = true;
+                vm_config::config.branch_prediction_static = false;
+                vm_config::config.branch_predictor_config.type = branch_predictor::PredictorType::Tournament;
                 break;
             }
         }
 
-        vm.LoadVM();
+        vm_worker.Post(command_handler::CommandType::MODIFY_CONFIG);
     }
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "gui/gui_common.h"
 
 void stats_main() {
-    VmBase::Stats& stats = vm.GetStats();
+    const VmBase::Stats& stats = vm_snapshot->stats;
 
     ImVec2 window_size = ImGui::GetWindowSize();
     ImVec2 size = { window_size.x, window_size.y };
@@ -14,7 +14,7 @@ void stats_main() {
 
     std::vector<std::string> lines;
 
-    if(vm.GetType()==VM::Which::SingleCycle){
+    if(vm_snapshot->type==VM::Which::SingleCycle){
         char buf[128];
         snprintf(buf, sizeof(buf), "Number of cycles: %zu", stats.cycles);
         lines.emplace_back(buf);
@@ -45,6 +45,15 @@ void stats_main() {
         snprintf(buf, sizeof(buf), "Branch Prediction Accuracy: %.2f%%",(1.0f - static_cast<float>(stats.branch_mispredicts) / stats.branch_instrs) * 100.0f);
         lines.emplace_back(buf);
 
+        const branch_predictor::MispredictBreakdown& mispredicts = stats.mispredicts;
+        snprintf(buf, sizeof(buf), "  direction (static/bimodal/gshare): %zu/%zu/%zu",
+            mispredicts.static_rule, mispredicts.bimodal, mispredicts.gshare);
+        lines.emplace_back(buf);
+
+        snprintf(buf, sizeof(buf), "  target (BTB/RAS): %zu/%zu, unpredicted: %zu",
+            mispredicts.btb, mispredicts.ras, mispredicts.unpredicted);
+        lines.emplace_back(buf);
+
         snprintf(buf, sizeof(buf), "Cycles Per Instruction (CPI): %.3f",static_cast<float>(stats.cycles) / stats.instrs_retired);
         lines.emplace_back(buf);
 
@@ -52,6 +61,36 @@ void stats_main() {
         lines.emplace_back(buf);
     }
 
+    const VmBase::TopDown& top_down = stats.top_down;
+    if(top_down.Slots()>0){
+        auto percent = [&](size_t slots){ return static_cast<float>(slots) / top_down.Slots() * 100.0f; };
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Issue slots (top-down): %zu", top_down.Slots());
+        lines.emplace_back(buf);
+
+        snprintf(buf, sizeof(buf), "  retiring: %.1f%%, bad speculation: %.1f%%",
+            percent(top_down.retiring), percent(top_down.bad_speculation));
+        lines.emplace_back(buf);
+
+        snprintf(buf, sizeof(buf), "  frontend bound: %.1f%%, backend bound: %.1f%%",
+            percent(top_down.frontend_bound), percent(top_down.backend_bound));
+        lines.emplace_back(buf);
+    }
+
+    const auto& [icache, dcache] = vm_snapshot->cache_stats;
+    if(vm_config::config.icache_config.enabled){
+        char buf[128];
+        snprintf(buf, sizeof(buf), "I-Cache hit rate: %.2f%% (%llu misses / %llu accesses)", icache.HitRate() * 100.0,
+            static_cast<unsigned long long>(icache.misses), static_cast<unsigned long long>(icache.accesses));
+        lines.emplace_back(buf);
+    }
+    if(vm_config::config.dcache_config.enabled){
+        char buf[128];
+        snprintf(buf, sizeof(buf), "D-Cache hit rate: %.2f%% (%llu misses / %llu accesses)", dcache.HitRate() * 100.0,
+            static_cast<unsigned long long>(dcache.misses), static_cast<unsigned long long>(dcache.accesses));
+        lines.emplace_back(buf);
+    }
+
     float line_height = ImGui::GetTextLineHeight();
     float line_spacing = 10.0f; // buffer between lines
     float total_text_height = static_cast<float>(lines.size()) * (line_height + line_spacing);
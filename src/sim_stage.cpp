@@ -1,3 +0,0 @@
-#include "sim_state.h"
-
-SimState SimState_;
\ No newline at end of file
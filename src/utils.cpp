@@ -331,25 +331,53 @@ void SetupConfigFile() {
   config_file << "processor_type=single_stage\n";
   config_file << "hazard_detection=false\n";
   config_file << "forwarding=false\n";
-  config_file << "branch_prediction=none\n\n";
+  config_file << "branch_prediction=none\n";
+  config_file << "reservation_station_size=4\n";
+  config_file << "rob_size=0   ; 0 keeps the model's default\n";
+  config_file << "load_queue_size=0   ; 0 keeps the model's default\n";
+  config_file << "store_queue_size=0   ; 0 keeps the model's default\n";
+  config_file << "cdb_width=0   ; results per cycle, 0 for unlimited\n";
+  config_file << "issue_width=0   ; 0 keeps the model's default\n";
+  config_file << "commit_width=0   ; 0 for the issue width\n\n";
 
   config_file << "[Memory]\n";
   config_file << "memory_size=0xffffffffffffffff\n";
-  config_file << "block_size=1024\n\n";
+  config_file << "memory_block_size=4096\n\n";
 
   config_file << "[Cache]\n";
   config_file << "cache_enabled=false\n";
-  config_file << "cache_size=0\n";
-  config_file << "cache_block_size=0\n";
-  config_file << "cache_associativity=0\n";
+  config_file << "cache_size=16384\n";
+  config_file << "cache_block_size=64\n";
+  config_file << "cache_associativity=4\n";
   config_file << "cache_read_miss_policy=read_allocate\n";
   config_file << "cache_replacement_policy=LRU\n";
   config_file << "cache_write_hit_policy=write_back\n";
-  config_file << "cache_write_miss_policy=write_allocate\n\n";
-
+  config_file << "cache_write_miss_policy=write_allocate\n";
+  config_file << "cache_hit_latency=1\n";
+  config_file << "cache_miss_latency=20\n\n";
   config_file << "[BranchPrediction]\n";
-  config_file << "branch_prediction_type=always_not_taken\n";
-  config_file << "branch_prediction_table_size=0\n";
-  config_file << "branch_prediction_table_associativity=0\n";
+  config_file << "branch_prediction_type=bimodal   ; bimodal, gshare or tournament, used by dynamic prediction\n";
+  config_file << "branch_prediction_table_size=256   ; BTB entries\n";
+  config_file << "branch_prediction_table_associativity=1\n";
+  config_file << "branch_prediction_counter_table_size=1024\n";
+  config_file << "branch_prediction_history_bits=10\n";
+  config_file << "branch_prediction_ras_size=8   ; 0 disables the return address stack\n\n";
+  config_file << "[Latency]   ; <class>_latency and <class>_interval, interval 1 for a pipelined unit\n";
+  config_file << "int_mul_latency=1\n";
+  config_file << "int_div_latency=1\n";
+  config_file << "int_div_interval=1   ; the divider blocks when this equals the latency\n";
+  config_file << "fp_add_latency=1\n";
+  config_file << "fp_mul_latency=1\n";
+  config_file << "fp_fma_latency=1\n";
+  config_file << "fp_div_latency=1\n";
+  config_file << "fp_div_interval=1\n";
+  config_file << "fp_sqrt_latency=1\n";
+  config_file << "fp_sqrt_interval=1\n\n";
+  config_file << "[Trace]   ; per instruction stage timestamps into vm_state/trace.bin, see vm_trace\n";
+  config_file << "trace_enabled=false\n";
+  config_file << "trace_start_cycle=0\n";
+  config_file << "trace_end_cycle=0   ; first cycle not traced, 0 for no end\n";
+  config_file << "trace_buffer_records=16384\n";
+  config_file << "trace_file=   ; empty for vm_state/trace.bin\n";
   config_file.close();
 }
\ No newline at end of file
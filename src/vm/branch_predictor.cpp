@@ -0,0 +1,291 @@
+#include "vm/branch_predictor.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace branch_predictor {
+
+namespace {
+
+constexpr uint8_t kOpcodeBranch = 0b1100011;
+constexpr uint8_t kOpcodeJal = 0b1101111;
+constexpr uint8_t kOpcodeJalr = 0b1100111;
+
+constexpr int sll_pc = 2; // last 2 bits of pc is always 0
+
+// x1 (ra) and x5 (t0) are the link registers of the calling convention
+bool IsLink(uint32_t reg) {
+    return reg==1 || reg==5;
+}
+
+void Train(uint8_t& counter, bool taken) {
+    if (taken && counter<3) {
+        counter++;
+    }
+    else if (!taken && counter>0) {
+        counter--;
+    }
+}
+
+} // namespace
+
+
+void MispredictBreakdown::Count(PredictorComponent component) {
+    switch (component) {
+        case PredictorComponent::None: unpredicted++; break;
+        case PredictorComponent::Static: static_rule++; break;
+        case PredictorComponent::Bimodal: bimodal++; break;
+        case PredictorComponent::Gshare: gshare++; break;
+        case PredictorComponent::Btb: btb++; break;
+        case PredictorComponent::Ras: ras++; break;
+    }
+}
+
+
+BranchPredictor::BranchPredictor() {
+    Configure(BranchPredictorConfig{});
+}
+
+void BranchPredictor::Configure(const BranchPredictorConfig& config) {
+    if (!std::has_single_bit(config.btb_size) || !std::has_single_bit(config.btb_associativity)
+        || !std::has_single_bit(config.counter_table_size)) {
+        throw std::invalid_argument("BTB size, BTB associativity and counter table size must be powers of two");
+    }
+    if (config.btb_associativity > config.btb_size) {
+        throw std::invalid_argument("BTB associativity larger than the BTB");
+    }
+    if (config.history_bits > 32) {
+        throw std::invalid_argument("Global history longer than 32 bits");
+    }
+
+    config_ = config;
+    btb_sets_ = config_.btb_size/config_.btb_associativity;
+    btb_.assign(config_.btb_size, BTBEntry{});
+    bimodal_.assign(config_.counter_table_size, 1);
+    gshare_.assign(config_.counter_table_size, 1);
+    chooser_.assign(config_.counter_table_size, 1);
+    history_mask_ = config_.history_bits==32 ? ~0u : (1u << config_.history_bits) - 1;
+    ras_.assign(config_.ras_size, 0);
+
+    Reset();
+}
+
+void BranchPredictor::Reset() {
+    for (BTBEntry& entry : btb_) {
+        entry = BTBEntry{};
+    }
+    btb_access_counter_ = 0;
+
+    std::fill(bimodal_.begin(), bimodal_.end(), 1);
+    std::fill(gshare_.begin(), gshare_.end(), 1);
+    std::fill(chooser_.begin(), chooser_.end(), 1);
+    history_ = 0;
+
+    ras_top_ = 0;
+    ras_depth_ = 0;
+}
+
+
+size_t BranchPredictor::CounterIndex(uint64_t pc) const {
+    return (pc >> sll_pc) & (config_.counter_table_size - 1);
+}
+
+size_t BranchPredictor::GshareIndex(uint64_t pc, uint32_t history) const {
+    return ((pc >> sll_pc) ^ history) & (config_.counter_table_size - 1);
+}
+
+
+BranchPredictor::BTBEntry* BranchPredictor::LookupBtb(uint64_t pc) {
+    size_t set = (pc >> sll_pc) & (btb_sets_ - 1);
+    BTBEntry* ways = &btb_[set*config_.btb_associativity];
+
+    for (size_t i = 0; i < config_.btb_associativity; i++) {
+        if (ways[i].valid && ways[i].tag==pc) {
+            ways[i].last_used = ++btb_access_counter_;
+            return &ways[i];
+        }
+    }
+    return nullptr;
+}
+
+void BranchPredictor::InsertBtb(uint64_t pc, uint64_t target) {
+    if (BTBEntry* entry = LookupBtb(pc)) {
+        entry->target_address = target;
+        return;
+    }
+
+    size_t set = (pc >> sll_pc) & (btb_sets_ - 1);
+    BTBEntry* ways = &btb_[set*config_.btb_associativity];
+
+    // an invalid way if there is one, the least recently used otherwise
+    BTBEntry* victim = &ways[0];
+    for (size_t i = 0; i < config_.btb_associativity; i++) {
+        if (!ways[i].valid) {
+            victim = &ways[i];
+            break;
+        }
+        if (ways[i].last_used < victim->last_used) {
+            victim = &ways[i];
+        }
+    }
+
+    victim->valid = true;
+    victim->tag = pc;
+    victim->target_address = target;
+    victim->last_used = ++btb_access_counter_;
+}
+
+
+bool BranchPredictor::PredictDirection(uint64_t pc, uint64_t target, BranchPrediction& prediction) {
+    prediction.bimodal_taken = bimodal_[CounterIndex(pc)] >= 2;
+    prediction.gshare_taken = gshare_[GshareIndex(pc, history_)] >= 2;
+
+    switch (config_.type) {
+        case PredictorType::Static: {
+            prediction.component = PredictorComponent::Static;
+            // target_address is less than current address, branch backward (loops)
+            return target < pc;
+        }
+        case PredictorType::Bimodal: {
+            prediction.component = PredictorComponent::Bimodal;
+            return prediction.bimodal_taken;
+        }
+        case PredictorType::Gshare: {
+            prediction.component = PredictorComponent::Gshare;
+            return prediction.gshare_taken;
+        }
+        case PredictorType::Tournament: {
+            if (chooser_[CounterIndex(pc)] >= 2) {
+                prediction.component = PredictorComponent::Gshare;
+                return prediction.gshare_taken;
+            }
+            prediction.component = PredictorComponent::Bimodal;
+            return prediction.bimodal_taken;
+        }
+    }
+    return false;
+}
+
+
+bool BranchPredictor::ApplyRas(uint64_t pc, uint32_t instruction, uint64_t& return_address) {
+    if (ras_.empty()) {
+        return false;
+    }
+
+    uint8_t opcode = instruction & 0x7F;
+    uint32_t rd = (instruction >> 7) & 0x1F;
+    uint32_t rs1 = (instruction >> 15) & 0x1F;
+
+    // the RISC-V hint table: a jalr reading a link register returns, a jal/jalr writing one calls. jalr ra, 0(t0)
+    // style coroutine swaps do both.
+    bool call = (opcode==kOpcodeJal || opcode==kOpcodeJalr) && IsLink(rd);
+    bool ret = opcode==kOpcodeJalr && IsLink(rs1) && (!IsLink(rd) || rd!=rs1);
+
+    bool popped = false;
+    if (ret && ras_depth_ > 0) {
+        ras_top_ = static_cast<uint32_t>((ras_top_ + ras_.size() - 1) % ras_.size());
+        ras_depth_--;
+        return_address = ras_[ras_top_];
+        popped = true;
+    }
+    if (call) {
+        ras_[ras_top_] = pc + 4;
+        ras_top_ = static_cast<uint32_t>((ras_top_ + 1) % ras_.size());
+        // a full stack overwrites its oldest entry
+        if (ras_depth_ < ras_.size()) {
+            ras_depth_++;
+        }
+    }
+    return popped;
+}
+
+
+BranchPrediction BranchPredictor::Predict(uint64_t pc, uint32_t instruction) {
+    BranchPrediction prediction;
+    prediction.target = pc + 4;
+    prediction.history = history_;
+    prediction.ras_top = ras_top_;
+    prediction.ras_depth = ras_depth_;
+
+    uint8_t opcode = instruction & 0x7F;
+
+    if (opcode==kOpcodeBranch) {
+        BTBEntry* entry = LookupBtb(pc);
+        bool taken = PredictDirection(pc, entry ? entry->target_address : pc + 4, prediction);
+        if (taken && !entry) {
+            // nowhere to go, fall through
+            prediction.component = PredictorComponent::Btb;
+            return prediction;
+        }
+        if (taken) {
+            prediction.taken = true;
+            prediction.target = entry->target_address;
+        }
+        return prediction;
+    }
+
+    if (opcode==kOpcodeJal || opcode==kOpcodeJalr) {
+        uint64_t return_address = 0;
+        if (ApplyRas(pc, instruction, return_address)) {
+            prediction.component = PredictorComponent::Ras;
+            prediction.taken = true;
+            prediction.target = return_address;
+            return prediction;
+        }
+
+        prediction.component = PredictorComponent::Btb;
+        if (BTBEntry* entry = LookupBtb(pc)) {
+            prediction.taken = true;
+            prediction.target = entry->target_address;
+        }
+        return prediction;
+    }
+
+    return prediction;
+}
+
+
+void BranchPredictor::Update(uint64_t pc, uint32_t instruction, bool taken, uint64_t target,
+                             const BranchPrediction& prediction) {
+    uint8_t opcode = instruction & 0x7F;
+
+    // only taken transfers are worth a BTB entry, a not taken branch falls through without one
+    if (taken) {
+        InsertBtb(pc, target);
+    }
+
+    if (opcode!=kOpcodeBranch) {
+        return;
+    }
+
+    if (config_.type==PredictorType::Bimodal || config_.type==PredictorType::Tournament) {
+        Train(bimodal_[CounterIndex(pc)], taken);
+    }
+    if (config_.type==PredictorType::Gshare || config_.type==PredictorType::Tournament) {
+        Train(gshare_[GshareIndex(pc, prediction.history)], taken);
+    }
+    if (config_.type==PredictorType::Tournament && prediction.bimodal_taken!=prediction.gshare_taken) {
+        Train(chooser_[CounterIndex(pc)], prediction.gshare_taken==taken);
+    }
+
+    history_ = ((history_ << 1) | (taken ? 1u : 0u)) & history_mask_;
+}
+
+
+void BranchPredictor::Recover(uint64_t pc, uint32_t instruction, const BranchPrediction& prediction) {
+    Restore(prediction);
+
+    uint64_t return_address = 0;
+    ApplyRas(pc, instruction, return_address);
+}
+
+void BranchPredictor::Restore(const BranchPrediction& prediction) {
+    if (ras_.empty()) {
+        return;
+    }
+    ras_top_ = prediction.ras_top;
+    ras_depth_ = prediction.ras_depth;
+}
+
+} // namespace branch_predictor
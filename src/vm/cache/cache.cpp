@@ -0,0 +1,210 @@
+/**
+ * @file cache.cpp
+ * @brief Contains the implementation of the set associative cache model.
+ * @author Vishank Singh, https://github.com/VishankSingh
+ */
+
+#include "vm/cache/cache.h"
+
+#include <bit>
+#include <stdexcept>
+#include <iomanip>
+
+namespace cache {
+
+void Cache::Configure(const CacheConfig &config) {
+  if (config.enabled) {
+    if (!std::has_single_bit(config.size) || !std::has_single_bit(config.block_size)
+        || !std::has_single_bit(config.associativity)) {
+      throw std::invalid_argument("Cache size, block size and associativity must be powers of two");
+    }
+    if (config.block_size*config.associativity > config.size) {
+      throw std::invalid_argument("Cache too small for its block size and associativity");
+    }
+  }
+
+  config_ = config;
+  sets_.clear();
+  offset_bits_ = 0;
+  index_bits_ = 0;
+
+  if (config_.enabled) {
+    sets_.assign(config_.Sets(), CacheSet(config_.associativity));
+    offset_bits_ = static_cast<unsigned int>(std::countr_zero(config_.block_size));
+    index_bits_ = static_cast<unsigned int>(std::countr_zero(config_.Sets()));
+  }
+
+  Reset();
+}
+
+void Cache::Reset() {
+  for (auto &set : sets_) {
+    for (auto &line : set.lines) {
+      line = CacheLine{};
+    }
+  }
+  stats_ = CacheStats{};
+  access_counter_ = 0;
+  rng_.seed(0);
+}
+
+CacheLine &Cache::ChooseVictim(CacheSet &set) {
+  for (auto &line : set.lines) {
+    if (line.state==CacheLineState::Invalid) {
+      return line;
+    }
+  }
+
+  switch (config_.replacement_policy) {
+    case ReplacementPolicy::LRU: {
+      CacheLine *victim = &set.lines[0];
+      for (auto &line : set.lines) {
+        if (line.last_used < victim->last_used) victim = &line;
+      }
+      return *victim;
+    }
+    case ReplacementPolicy::FIFO: {
+      CacheLine *victim = &set.lines[0];
+      for (auto &line : set.lines) {
+        if (line.filled_at < victim->filled_at) victim = &line;
+      }
+      return *victim;
+    }
+    case ReplacementPolicy::Random:
+    default: {
+      std::uniform_int_distribution<size_t> pick(0, set.lines.size() - 1);
+      return set.lines[pick(rng_)];
+    }
+  }
+}
+
+unsigned int Cache::Access(uint64_t address, bool is_write) {
+  if (!config_.enabled) {
+    return 0;
+  }
+
+  access_counter_++;
+  stats_.accesses++;
+  if (is_write) {
+    stats_.writes++;
+  } else {
+    stats_.reads++;
+  }
+
+  uint64_t index = (address >> offset_bits_) & ((1ULL << index_bits_) - 1);
+  uint64_t tag = address >> (offset_bits_ + index_bits_);
+  CacheSet &set = sets_[index];
+
+  for (auto &line : set.lines) {
+    if (line.state!=CacheLineState::Invalid && line.tag==tag) {
+      stats_.hits++;
+      line.last_used = access_counter_;
+      if (is_write && config_.write_hit_policy==WriteHitPolicy::WriteBack) {
+        line.state = CacheLineState::Dirty;
+      }
+      return config_.hit_latency;
+    }
+  }
+
+  stats_.misses++;
+
+  // the store goes straight to memory, nothing is filled
+  if (is_write && config_.write_miss_policy==WriteMissPolicy::NoWriteAllocate) {
+    return config_.miss_latency;
+  }
+
+  CacheLine &victim = ChooseVictim(set);
+  if (victim.state!=CacheLineState::Invalid) {
+    stats_.evictions++;
+    if (victim.state==CacheLineState::Dirty) {
+      stats_.writebacks++;
+    }
+  }
+
+  victim.tag = tag;
+  victim.last_used = access_counter_;
+  victim.filled_at = access_counter_;
+  victim.state = (is_write && config_.write_hit_policy==WriteHitPolicy::WriteBack)
+                 ? CacheLineState::Dirty
+                 : CacheLineState::Valid;
+
+  return config_.miss_latency;
+}
+
+const char *ToString(ReplacementPolicy policy) {
+  switch (policy) {
+    case ReplacementPolicy::LRU: return "LRU";
+    case ReplacementPolicy::FIFO: return "FIFO";
+    case ReplacementPolicy::Random: return "Random";
+  }
+  return "unknown";
+}
+
+const char *ToString(WriteHitPolicy policy) {
+  switch (policy) {
+    case WriteHitPolicy::WriteThrough: return "write_through";
+    case WriteHitPolicy::WriteBack: return "write_back";
+  }
+  return "unknown";
+}
+
+const char *ToString(WriteMissPolicy policy) {
+  switch (policy) {
+    case WriteMissPolicy::NoWriteAllocate: return "no_write_allocate";
+    case WriteMissPolicy::WriteAllocate: return "write_allocate";
+  }
+  return "unknown";
+}
+
+void Cache::PrintStatus(std::ostream &os) const {
+  const char *name = config_.cache_type==CacheType::Instruction ? "I-Cache" : "D-Cache";
+  if (!config_.enabled) {
+    os << name << ": disabled\n";
+    return;
+  }
+
+  os << name << ": " << config_.size << " B, " << config_.block_size << " B lines, "
+     << config_.associativity << "-way, " << config_.Sets() << " sets, "
+     << ToString(config_.replacement_policy) << ", " << ToString(config_.write_hit_policy) << ", "
+     << ToString(config_.write_miss_policy) << "\n";
+  os << "  accesses: " << stats_.accesses << " hits: " << stats_.hits << " misses: " << stats_.misses
+     << " hit rate: " << std::fixed << std::setprecision(2) << stats_.HitRate()*100.0 << "%"
+     << std::defaultfloat << "\n";
+  os << "  evictions: " << stats_.evictions << " writebacks: " << stats_.writebacks << "\n";
+
+  for (size_t i = 0; i < sets_.size(); ++i) {
+    for (size_t way = 0; way < sets_[i].lines.size(); ++way) {
+      const CacheLine &line = sets_[i].lines[way];
+      if (line.state==CacheLineState::Invalid) {
+        continue;
+      }
+      uint64_t base = ((line.tag << index_bits_) | i) << offset_bits_;
+      os << "  set " << i << " way " << way << ": 0x" << std::hex << base << std::dec
+         << (line.state==CacheLineState::Dirty ? " (dirty)" : "") << "\n";
+    }
+  }
+}
+
+void Cache::DumpJson(std::ostream &os, const std::string &indent) const {
+  os << "{\n";
+  os << indent << "\"enabled\": " << (config_.enabled ? "true" : "false") << ",\n";
+  os << indent << "\"size\": " << config_.size << ",\n";
+  os << indent << "\"block_size\": " << config_.block_size << ",\n";
+  os << indent << "\"associativity\": " << config_.associativity << ",\n";
+  os << indent << "\"replacement_policy\": \"" << ToString(config_.replacement_policy) << "\",\n";
+  os << indent << "\"write_hit_policy\": \"" << ToString(config_.write_hit_policy) << "\",\n";
+  os << indent << "\"write_miss_policy\": \"" << ToString(config_.write_miss_policy) << "\",\n";
+  os << indent << "\"hit_latency\": " << config_.hit_latency << ",\n";
+  os << indent << "\"miss_latency\": " << config_.miss_latency << ",\n";
+  os << indent << "\"accesses\": " << stats_.accesses << ",\n";
+  os << indent << "\"hits\": " << stats_.hits << ",\n";
+  os << indent << "\"misses\": " << stats_.misses << ",\n";
+  os << indent << "\"reads\": " << stats_.reads << ",\n";
+  os << indent << "\"writes\": " << stats_.writes << ",\n";
+  os << indent << "\"evictions\": " << stats_.evictions << ",\n";
+  os << indent << "\"writebacks\": " << stats_.writebacks << ",\n";
+  os << indent << "\"hit_rate\": " << stats_.HitRate() << "\n";
+  os << indent.substr(0, indent.size() >= 4 ? indent.size() - 4 : 0) << "}";
+}
+
+} // namespace cache
@@ -0,0 +1,494 @@
+#include "vm/fast_forward/engine.h"
+#include "vm/rv5s/single_cycle/hardware/decode_unit.h"
+#include "common/instructions.h"
+
+namespace fast_forward {
+
+using Op = FastForwardOp;
+using State = FastForwardState;
+
+namespace {
+
+uint64_t SignExtend(uint64_t value, unsigned int bits) {
+    if (bits >= 64) {
+        return value;
+    }
+    unsigned int shift = 64 - bits;
+    return static_cast<uint64_t>(static_cast<int64_t>(value << shift) >> shift);
+}
+
+// Same results as alu::Alu::execute for the ops that get their own handler
+template <alu::AluOp Operation>
+inline uint64_t Compute(uint64_t a, uint64_t b) {
+    using alu::AluOp;
+    if constexpr (Operation==AluOp::kAdd) return a + b;
+    else if constexpr (Operation==AluOp::kAddw) return static_cast<uint64_t>(static_cast<int32_t>(static_cast<uint32_t>(a + b)));
+    else if constexpr (Operation==AluOp::kSub) return a - b;
+    else if constexpr (Operation==AluOp::kSubw) return static_cast<uint64_t>(static_cast<int32_t>(static_cast<uint32_t>(a - b)));
+    else if constexpr (Operation==AluOp::kAnd) return a & b;
+    else if constexpr (Operation==AluOp::kOr) return a | b;
+    else if constexpr (Operation==AluOp::kXor) return a ^ b;
+    else if constexpr (Operation==AluOp::kSll) return a << (b & 63);
+    else if constexpr (Operation==AluOp::kSllw) return static_cast<uint64_t>(static_cast<int32_t>(static_cast<uint32_t>(a) << (b & 31)));
+    else if constexpr (Operation==AluOp::kSrl) return a >> (b & 63);
+    else if constexpr (Operation==AluOp::kSrlw) return static_cast<uint64_t>(static_cast<int32_t>(static_cast<uint32_t>(a) >> (b & 31)));
+    else if constexpr (Operation==AluOp::kSra) return static_cast<uint64_t>(static_cast<int64_t>(a) >> (b & 63));
+    else if constexpr (Operation==AluOp::kSraw) return static_cast<uint64_t>(static_cast<int32_t>(a) >> (b & 31));
+    else if constexpr (Operation==AluOp::kSlt) return static_cast<int64_t>(a) < static_cast<int64_t>(b);
+    else if constexpr (Operation==AluOp::kSltu) return a < b;
+    else static_assert(Operation==AluOp::kAdd, "no fast path for this op");
+}
+
+const Op* Exit(const Op* op, State& state, uint64_t next_pc) {
+    state.pc = next_pc;
+    state.exit_op = op;
+    return nullptr;
+}
+
+template <alu::AluOp Operation>
+const Op* AluReg(const Op* op, State& state) {
+    state.gpr[op->rd] = Compute<Operation>(state.gpr[op->rs1], state.gpr[op->rs2]);
+    return op + 1;
+}
+
+template <alu::AluOp Operation>
+const Op* AluImm(const Op* op, State& state) {
+    state.gpr[op->rd] = Compute<Operation>(state.gpr[op->rs1], op->imm);
+    return op + 1;
+}
+
+// lui, auipc: the result only depends on the pc and the immediate
+const Op* LoadConstant(const Op* op, State& state) {
+    state.gpr[op->rd] = op->imm;
+    return op + 1;
+}
+
+template <size_t Bytes, bool Signed>
+const Op* Load(const Op* op, State& state) {
+    uint64_t value = state.memory_controller->ReadSized(state.gpr[op->rs1] + op->imm, Bytes);
+    if constexpr (Signed) {
+        value = SignExtend(value, Bytes*8);
+    }
+    state.gpr[op->rd] = value;
+    return op + 1;
+}
+
+template <size_t Bytes>
+const Op* Store(const Op* op, State& state) {
+    uint64_t address = state.gpr[op->rs1] + op->imm;
+    state.memory_controller->WriteSized(address, Bytes, state.gpr[op->rs2]);
+    if (address < state.text_size) {
+        // the blocks are stale, leave so that they get rebuilt
+        return Exit(op, state, op->pc + 4);
+    }
+    return op + 1;
+}
+
+template <uint8_t Funct3>
+const Op* Branch(const Op* op, State& state) {
+    uint64_t a = state.gpr[op->rs1];
+    uint64_t b = state.gpr[op->rs2];
+    bool taken;
+    if constexpr (Funct3==0b000) taken = a==b;
+    else if constexpr (Funct3==0b001) taken = a!=b;
+    else if constexpr (Funct3==0b100) taken = static_cast<int64_t>(a) < static_cast<int64_t>(b);
+    else if constexpr (Funct3==0b101) taken = static_cast<int64_t>(a) >= static_cast<int64_t>(b);
+    else if constexpr (Funct3==0b110) taken = a < b;
+    else taken = a >= b;
+    return Exit(op, state, taken ? op->imm : op->pc + 4);
+}
+
+const Op* Jal(const Op* op, State& state) {
+    state.gpr[op->rd] = op->pc + 4;
+    return Exit(op, state, op->imm);
+}
+
+const Op* Jalr(const Op* op, State& state) {
+    uint64_t target = state.gpr[op->rs1] + op->imm;
+    state.gpr[op->rd] = op->pc + 4;
+    return Exit(op, state, target);
+}
+
+// ends a block that was cut by its length or by the end of the text section
+const Op* FallThrough(const Op* op, State& state) {
+    return Exit(op, state, op->pc);
+}
+
+const Op* Csr(const Op* op, State& state) {
+    register_file::RegisterFile& rf = *state.register_file;
+    uint64_t old_value = rf.ReadCsr(op->csr_rd);
+    uint64_t write_value = state.gpr[op->rs1];
+    uint64_t uimm = op->rs1;
+
+    state.gpr[op->rd] = old_value;
+    switch (op->funct3) {
+        case 0b001: rf.WriteCsr(op->csr_rd, write_value); break; // CSRRW
+        case 0b010: if (write_value!=0) rf.WriteCsr(op->csr_rd, old_value | write_value); break; // CSRRS
+        case 0b011: if (write_value!=0) rf.WriteCsr(op->csr_rd, old_value & ~write_value); break; // CSRRC
+        case 0b101: rf.WriteCsr(op->csr_rd, uimm); break; // CSRRWI
+        case 0b110: if (uimm!=0) rf.WriteCsr(op->csr_rd, old_value | uimm); break; // CSRRSI
+        case 0b111: if (uimm!=0) rf.WriteCsr(op->csr_rd, old_value & ~uimm); break; // CSRRCI
+    }
+    return op + 1;
+}
+
+const Op* Ecall(const Op* op, State& state) {
+    *state.log << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
+    return Exit(op, state, op->pc + 4);
+}
+
+// Everything without a fast path (M extension, F/D, fence...): the single cycle datapath without the context
+const Op* Generic(const Op* op, State& state) {
+    uint64_t rs1_value = state.gpr[op->rs1];
+    uint64_t rs2_value = state.gpr[op->rs2];
+    uint64_t alu_out = 0;
+    bool fcsr_update = false;
+    uint64_t fcsr_status = 0;
+
+    if (op->is_float || op->is_double) {
+        uint8_t rm = op->funct3;
+        uint64_t reg1_value = state.fpr[op->rs1];
+        uint64_t reg2_value = state.fpr[op->rs2];
+        uint64_t reg3_value = state.fpr[op->rs3];
+
+        if (rm==0b111) {
+            rm = state.register_file->ReadCsr(0x002);
+        }
+        if (op->is_float) {
+            if (!op->rs1_from_fprf) {
+                reg1_value = rs1_value;
+            }
+        }
+        else if (op->funct7==0b1101001 || op->funct7==0b1111001 || op->opcode==0b0000111 || op->opcode==0b0100111) {
+            reg1_value = rs1_value;
+        }
+        if (op->imm_to_alu) {
+            reg2_value = op->imm;
+        }
+
+        if (op->is_float) {
+            auto [result, status] = alu::Alu::fpexecute(op->alu_op, reg1_value, reg2_value, reg3_value, rm);
+            alu_out = result;
+            fcsr_status = status;
+        }
+        else {
+            auto [result, status] = alu::Alu::dfpexecute(op->alu_op, reg1_value, reg2_value, reg3_value, rm);
+            alu_out = result;
+            fcsr_status = status;
+        }
+        fcsr_update = true;
+    }
+    else {
+        uint64_t reg2_value = op->imm_to_alu ? op->imm : rs2_value;
+        alu_out = alu::Alu::execute(op->alu_op, rs1_value, reg2_value).first;
+    }
+
+    uint64_t mem_out = 0;
+    bool text_written = false;
+    if (op->mem_read) {
+        mem_out = state.memory_controller->ReadSized(alu_out, op->mem_access_bytes);
+        if (op->sign_extend) {
+            mem_out = SignExtend(mem_out, op->mem_access_bytes*8);
+        }
+    }
+    else if (op->mem_write) {
+        uint64_t write_data = op->mem_write_data_from_gpr ? rs2_value : state.fpr[op->rs2];
+        state.memory_controller->WriteSized(alu_out, op->mem_access_bytes, write_data);
+        text_written = alu_out < state.text_size;
+    }
+
+    if (fcsr_update) {
+        state.register_file->WriteCsr(0x003, fcsr_status);
+    }
+
+    if (op->reg_write) {
+        uint64_t write_data = op->mem_to_reg ? mem_out : alu_out;
+        if (op->reg_write_to_fpr) {
+            state.fpr[op->rd] = write_data;
+        }
+        else {
+            state.gpr[op->rd] = write_data;
+        }
+    }
+
+    // the blocks are stale, leave so that they get rebuilt
+    if (text_written) {
+        return Exit(op, state, op->pc + 4);
+    }
+    return op + 1;
+}
+
+template <alu::AluOp Operation>
+OpHandler PickAlu(bool imm) {
+    return imm ? &AluImm<Operation> : &AluReg<Operation>;
+}
+
+OpHandler PickAluHandler(alu::AluOp alu_op, bool imm) {
+    using alu::AluOp;
+    switch (alu_op) {
+        case AluOp::kAdd: return PickAlu<AluOp::kAdd>(imm);
+        case AluOp::kAddw: return PickAlu<AluOp::kAddw>(imm);
+        case AluOp::kSub: return PickAlu<AluOp::kSub>(imm);
+        case AluOp::kSubw: return PickAlu<AluOp::kSubw>(imm);
+        case AluOp::kAnd: return PickAlu<AluOp::kAnd>(imm);
+        case AluOp::kOr: return PickAlu<AluOp::kOr>(imm);
+        case AluOp::kXor: return PickAlu<AluOp::kXor>(imm);
+        case AluOp::kSll: return PickAlu<AluOp::kSll>(imm);
+        case AluOp::kSllw: return PickAlu<AluOp::kSllw>(imm);
+        case AluOp::kSrl: return PickAlu<AluOp::kSrl>(imm);
+        case AluOp::kSrlw: return PickAlu<AluOp::kSrlw>(imm);
+        case AluOp::kSra: return PickAlu<AluOp::kSra>(imm);
+        case AluOp::kSraw: return PickAlu<AluOp::kSraw>(imm);
+        case AluOp::kSlt: return PickAlu<AluOp::kSlt>(imm);
+        case AluOp::kSltu: return PickAlu<AluOp::kSltu>(imm);
+        default: return nullptr;
+    }
+}
+
+OpHandler PickLoadHandler(size_t bytes, bool sign_extend) {
+    switch (bytes) {
+        case 1: return sign_extend ? &Load<1, true> : &Load<1, false>;
+        case 2: return sign_extend ? &Load<2, true> : &Load<2, false>;
+        case 4: return sign_extend ? &Load<4, true> : &Load<4, false>;
+        case 8: return &Load<8, false>;
+        default: return nullptr;
+    }
+}
+
+OpHandler PickStoreHandler(size_t bytes) {
+    switch (bytes) {
+        case 1: return &Store<1>;
+        case 2: return &Store<2>;
+        case 4: return &Store<4>;
+        case 8: return &Store<8>;
+        default: return nullptr;
+    }
+}
+
+OpHandler PickBranchHandler(uint8_t funct3) {
+    switch (funct3) {
+        case 0b000: return &Branch<0b000>;
+        case 0b001: return &Branch<0b001>;
+        case 0b100: return &Branch<0b100>;
+        case 0b101: return &Branch<0b101>;
+        case 0b110: return &Branch<0b110>;
+        case 0b111: return &Branch<0b111>;
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+
+FastForwardOp FastForwardEngine::BuildOp(uint64_t pc, State& state) {
+    using instruction_set::Instruction;
+    using instruction_set::get_instr_encoding;
+
+    rv5s::SingleCycleInstrContext instr(pc);
+    instr.instruction = state.memory_controller->ReadWord(pc);
+
+    // not the core's predecode table: its entries also carry fields (uses_rs1...) the single cycle decode leaves unset
+    rv5s::SingleCycleDecodeUnit decode_unit;
+    predecode::PredecodeTable no_predecode;
+    decode_unit.DecodeInstruction(instr, *state.register_file, no_predecode);
+
+    Op op;
+    op.pc = pc;
+    op.imm = static_cast<uint64_t>(static_cast<int64_t>(instr.immediate));
+    op.alu_op = instr.alu_op;
+    op.opcode = instr.opcode;
+    op.funct3 = instr.funct3;
+    op.funct7 = instr.funct7;
+    op.rd = instr.rd;
+    op.rs1 = instr.rs1;
+    op.rs2 = instr.rs2;
+    op.rs3 = instr.frs3;
+    op.mem_access_bytes = static_cast<uint8_t>(instr.mem_access_bytes);
+    op.imm_to_alu = instr.imm_to_alu;
+    op.mem_read = instr.mem_read;
+    op.mem_write = instr.mem_write;
+    op.mem_to_reg = instr.mem_to_reg;
+    op.mem_write_data_from_gpr = instr.mem_write_data_from_gpr;
+    op.sign_extend = instr.sign_extend;
+    op.reg_write = instr.reg_write;
+    op.reg_write_to_fpr = instr.reg_write_to_fpr;
+    op.rs1_from_fprf = instr.rs1_from_fprf;
+    op.is_float = instruction_set::isFInstruction(instr.instruction);
+    op.is_double = !op.is_float && instruction_set::isDInstruction(instr.instruction);
+    op.csr_rd = instr.csr_rd;
+
+    // x0 has to keep reading 0
+    if (!op.reg_write_to_fpr && op.rd==0) {
+        op.rd = FastForwardState::kScratchGpr;
+    }
+
+    if (op.opcode==0b1110011) {
+        if (op.funct3==get_instr_encoding(Instruction::kecall).funct3) {
+            op.handler = &Ecall;
+            op.ends_block = true;
+        }
+        else {
+            op.handler = &Csr;
+        }
+        return op;
+    }
+
+    if (op.is_float || op.is_double) {
+        op.handler = &Generic;
+        return op;
+    }
+
+    if (op.opcode==get_instr_encoding(Instruction::kjal).opcode) {
+        op.imm = pc + op.imm;
+        op.handler = &Jal;
+        op.ends_block = true;
+        return op;
+    }
+    if (op.opcode==get_instr_encoding(Instruction::kjalr).opcode) {
+        op.handler = &Jalr;
+        op.ends_block = true;
+        return op;
+    }
+    if (op.opcode==get_instr_encoding(Instruction::kbeq).opcode) {
+        op.imm = pc + op.imm;
+        op.handler = PickBranchHandler(op.funct3);
+        op.ends_block = true;
+        if (op.handler==nullptr) {
+            // not a branch the detailed models know, it falls through
+            op.handler = &Generic;
+            op.ends_block = false;
+        }
+        return op;
+    }
+
+    if (op.alu_op==alu::AluOp::kLui || op.alu_op==alu::AluOp::kAuipc) {
+        op.imm = alu::Alu::execute(op.alu_op, pc, op.imm).first;
+        op.handler = op.reg_write ? &LoadConstant : &Generic;
+        return op;
+    }
+
+    if (op.alu_op==alu::AluOp::kAdd && op.imm_to_alu && op.mem_read && op.mem_to_reg && op.reg_write) {
+        op.handler = PickLoadHandler(op.mem_access_bytes, op.sign_extend);
+    }
+    else if (op.alu_op==alu::AluOp::kAdd && op.imm_to_alu && op.mem_write && op.mem_write_data_from_gpr) {
+        op.handler = PickStoreHandler(op.mem_access_bytes);
+    }
+    else if (!op.mem_read && !op.mem_write && op.reg_write) {
+        op.handler = PickAluHandler(op.alu_op, op.imm_to_alu);
+    }
+
+    if (op.handler==nullptr) {
+        op.handler = &Generic;
+    }
+    return op;
+}
+
+
+const FastForwardEngine::Block& FastForwardEngine::GetBlock(State& state) {
+    uint64_t start = state.pc;
+    uint32_t& slot = block_at_[start >> 2];
+    if (slot!=0) {
+        return blocks_[slot - 1];
+    }
+
+    Block block;
+    uint64_t pc = start;
+    while (pc < state.text_size && block.ops.size() < kMaxBlockLength) {
+        Op op = BuildOp(pc, state);
+        op.retired = static_cast<uint32_t>(block.ops.size() + 1);
+        block.ops.push_back(op);
+        pc += 4;
+
+        if (op.ends_block) {
+            break;
+        }
+    }
+    block.length = static_cast<uint32_t>(block.ops.size());
+
+    if (!block.ops.back().ends_block) {
+        Op fall_through;
+        fall_through.handler = &FallThrough;
+        fall_through.pc = pc;
+        fall_through.retired = block.length;
+        block.ops.push_back(fall_through);
+    }
+
+    blocks_.push_back(std::move(block));
+    slot = static_cast<uint32_t>(blocks_.size());
+    return blocks_.back();
+}
+
+
+void FastForwardEngine::Reset() {
+    blocks_.clear();
+    block_at_.clear();
+}
+
+
+uint64_t FastForwardEngine::Run(uint64_t& pc, uint64_t num_instrs, uint64_t text_size,
+                                register_file::RegisterFile& register_file,
+                                memory_controller::MemoryController& memory_controller,
+                                const std::atomic<bool>& stop_requested,
+                                std::vector<uint64_t>* retired_at) {
+    State state;
+    state.pc = pc;
+    state.register_file = &register_file;
+    state.memory_controller = &memory_controller;
+    state.text_size = text_size & ~uint64_t{0b11};
+    state.log = log_;
+    for (size_t i = 0; i < 32; i++) {
+        state.gpr[i] = register_file.ReadGpr(i);
+        state.fpr[i] = register_file.ReadFpr(i);
+    }
+
+    uint64_t retired = 0;
+    while (!stop_requested.load(std::memory_order_relaxed) && retired < num_instrs && state.pc < state.text_size && !(state.pc & 0b11)) {
+        // a write to the text section (by this engine, a detailed model or a reload) drops every block
+        uint64_t generation = memory_controller.GetPredecodeTable().Generation();
+        if (generation!=generation_ || block_at_.size()!=state.text_size/4) {
+            Reset();
+            block_at_.assign(state.text_size/4, 0);
+            generation_ = generation;
+        }
+
+        const Block& block = GetBlock(state);
+        uint64_t block_word = state.pc >> 2;
+
+        const Op* op = block.ops.data();
+        uint64_t remaining = num_instrs - retired;
+        uint64_t executed = 0;
+        if (block.length <= remaining) {
+            while ((op = op->handler(op, state))) {}
+            executed = state.exit_op->retired;
+        }
+        else {
+            // the limit falls inside this block, step it op by op
+            while (executed < remaining && op) {
+                op = op->handler(op, state);
+                executed++;
+            }
+            if (op) {
+                state.pc = op->pc;
+            }
+        }
+        retired += executed;
+
+        // the ops of a block are consecutive words, the first executed ones retired
+        if (retired_at) {
+            for (uint64_t i = 0; i < executed; i++) {
+                (*retired_at)[block_word + i]++;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < 32; i++) {
+        register_file.WriteGpr(i, state.gpr[i]);
+    }
+    for (size_t i = 0; i < 32; i++) {
+        register_file.WriteFpr(i, state.fpr[i]);
+    }
+    pc = state.pc;
+    return retired;
+}
+
+} // namespace fast_forward
@@ -0,0 +1,77 @@
+#include "vm/fu_latency.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace fu_latency {
+
+namespace {
+
+constexpr std::array<const char*, static_cast<size_t>(OpClass::Count)> kClassNames = {
+    "int_alu", "int_mul", "int_div", "fp_add", "fp_mul", "fp_fma", "fp_div", "fp_sqrt", "fp_misc",
+};
+
+}
+
+void LatencyConfig::Modify(const std::string& key, const std::string& value) {
+    for (size_t i = 0; i < kClassNames.size(); i++) {
+        std::string name = kClassNames[i];
+        bool latency = key == name + "_latency";
+        bool interval = key == name + "_interval";
+        if (!latency && !interval)
+            continue;
+
+        unsigned long cycles = std::stoul(value);
+        if (cycles == 0 || cycles > 255) {
+            throw std::invalid_argument("Latencies and intervals must be 1 to 255 cycles: " + value);
+        }
+        (latency ? timings[i].latency : timings[i].interval) = static_cast<unsigned int>(cycles);
+        return;
+    }
+    throw std::invalid_argument("Unknown key: " + key);
+}
+
+OpClass ClassOf(alu::AluOp op) {
+    using alu::AluOp;
+    switch (op) {
+        case AluOp::kMul: case AluOp::kMulh: case AluOp::kMulhsu: case AluOp::kMulhu: case AluOp::kMulw:
+            return OpClass::IntMul;
+        case AluOp::kDiv: case AluOp::kDivw: case AluOp::kDivu: case AluOp::kDivuw:
+        case AluOp::kRem: case AluOp::kRemw: case AluOp::kRemu: case AluOp::kRemuw:
+            return OpClass::IntDiv;
+
+        case AluOp::FADD_S: case AluOp::FSUB_S: case AluOp::FADD_D: case AluOp::FSUB_D:
+            return OpClass::FpAdd;
+        case AluOp::FMUL_S: case AluOp::FMUL_D:
+            return OpClass::FpMul;
+        case AluOp::kFmadd_s: case AluOp::kFmsub_s: case AluOp::kFnmadd_s: case AluOp::kFnmsub_s:
+        case AluOp::FMADD_D: case AluOp::FMSUB_D: case AluOp::FNMADD_D: case AluOp::FNMSUB_D:
+            return OpClass::FpFma;
+        case AluOp::FDIV_S: case AluOp::FDIV_D:
+            return OpClass::FpDiv;
+        case AluOp::FSQRT_S: case AluOp::FSQRT_D:
+            return OpClass::FpSqrt;
+
+        default:
+            return op >= AluOp::kFmadd_s ? OpClass::FpMisc : OpClass::IntAlu;
+    }
+}
+
+LatencyTable::LatencyTable() {
+    Configure(LatencyConfig{});
+}
+
+void LatencyTable::Configure(const LatencyConfig& config) {
+    for (size_t op = 0; op < kNumOps; op++) {
+        table_[op] = config.timings[static_cast<size_t>(ClassOf(static_cast<alu::AluOp>(op)))];
+    }
+}
+
+unsigned int LatencyTable::MaxLatency() const {
+    unsigned int max_latency = 1;
+    for (const OpTiming& timing : table_) {
+        max_latency = std::max(max_latency, timing.latency);
+    }
+    return max_latency;
+}
+
+} // namespace fu_latency
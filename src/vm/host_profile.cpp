@@ -0,0 +1,102 @@
+#include "vm/host_profile.h"
+#include <iomanip>
+#include <sstream>
+
+namespace host_profile {
+
+namespace {
+
+constexpr std::array<const char*, kNumTimers> kNames = {
+    "cycle", "fetch", "decode", "issue", "select", "execute", "memory", "writeback", "commit", "broadcast",
+};
+
+double Per(double value, uint64_t count) {
+    return count!=0 ? value / static_cast<double>(count) : 0.0;
+}
+
+}
+
+const char* Name(Timer timer) {
+    return kNames[static_cast<size_t>(timer)];
+}
+
+double NsPerTick() {
+    static const double ns_per_tick = [] {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        // a couple of milliseconds is plenty to pin down the TSC frequency to the precision a profile needs
+        auto start = std::chrono::steady_clock::now();
+        uint64_t start_ticks = Now();
+        std::chrono::steady_clock::duration elapsed;
+        do {
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < std::chrono::milliseconds(2));
+        uint64_t ticks = Now() - start_ticks;
+        return Per(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), ticks);
+#else
+        return 1.0;
+#endif
+    }();
+    return ns_per_tick;
+}
+
+void HostProfile::AddRun(uint64_t ns, uint64_t cycles, uint64_t instrs) {
+    run_ns_ += ns;
+    run_cycles_ += cycles;
+    run_instrs_ += instrs;
+}
+
+void HostProfile::Reset() {
+    *this = HostProfile{};
+}
+
+double HostProfile::Mips() const {
+    // instructions per microsecond
+    return Per(static_cast<double>(run_instrs_) * 1e3, run_ns_);
+}
+
+double HostProfile::NsPerCycle() const {
+    return Per(static_cast<double>(run_ns_), run_cycles_);
+}
+
+double HostProfile::StageNs(Timer timer) const {
+    return static_cast<double>(Totals(timer).ticks) * NsPerTick();
+}
+
+double HostProfile::StageNsPerCycle(Timer timer) const {
+    return Per(StageNs(timer), Totals(Timer::Cycle).calls);
+}
+
+RunTimer::RunTimer(uint64_t cycles, uint64_t instrs)
+    : start_(std::chrono::steady_clock::now()), cycles_(cycles), instrs_(instrs) {}
+
+void RunTimer::Stop(HostProfile& profile, uint64_t cycles, uint64_t instrs, std::ostream& log) {
+    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+    HostProfile run;
+    run.AddRun(ns, cycles - cycles_, instrs - instrs_);
+    profile.AddRun(run.RunNs(), run.RunCycles(), run.RunInstrs());
+
+    // below a million a second KIPS reads better. Formatted aside, so that log keeps its own precision
+    std::ostringstream line;
+    line << std::fixed << "VM : " << run.RunInstrs() << " instructions, " << run.RunCycles() << " cycles in "
+         << std::setprecision(6) << static_cast<double>(ns) / 1e9 << " s host time (" << std::setprecision(2);
+    if (run.Mips() >= 1.0) {
+        line << run.Mips() << " MIPS";
+    } else {
+        line << run.Mips() * 1e3 << " KIPS";
+    }
+    line << ", " << std::setprecision(1) << run.NsPerCycle() << " ns per cycle)\n";
+
+    if constexpr (kStageTimers) {
+        line << "VM : host ns per cycle by stage, since load:";
+        for (size_t timer = 1; timer < kNumTimers; timer++) {
+            if (profile.Totals(static_cast<Timer>(timer)).calls!=0) {
+                line << " " << Name(static_cast<Timer>(timer)) << " " << profile.StageNsPerCycle(static_cast<Timer>(timer));
+            }
+        }
+        line << "\n";
+    }
+    log << line.str() << std::flush;
+}
+
+} // namespace host_profile
@@ -17,51 +17,152 @@
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
-#include "sim_state.h"
+#include <bit>
+#include <cstdlib>
+
+uint8_t* PageArena::Allocate() {
+  uint8_t* page;
+  if (!free_list_.empty()) {
+    page = free_list_.back();
+    free_list_.pop_back();
+  } else {
+    if (next_in_chunk_==kPagesPerChunk) {
+      chunks_.emplace_back(new uint8_t[kPagesPerChunk*page_size_]);
+      next_in_chunk_ = 0;
+    }
+    page = chunks_.back().get() + next_in_chunk_*page_size_;
+    next_in_chunk_++;
+  }
+  std::memset(page, 0, page_size_);
+  pages_in_use_++;
+  return page;
+}
 
-uint8_t Memory::Read(uint64_t address) {
-  if (address >= memory_size_) {
-    throw std::out_of_range("Memory address out of range: " + std::to_string(address));
+void PageArena::Release(uint8_t* page) {
+  free_list_.push_back(page);
+  pages_in_use_--;
+}
+
+Memory::Memory()
+    : page_size_(static_cast<unsigned int>(vm_config::config.getMemoryBlockSize())),
+      page_shift_(static_cast<unsigned int>(std::countr_zero(page_size_))),
+      leaf_bits_((kVirtualAddressBits - page_shift_)/2),
+      root_bits_(kVirtualAddressBits - page_shift_ - leaf_bits_),
+      arena_(page_size_) {
+  // calloc so the untouched parts of the (large, sparse) tables never get backed by host memory
+  root_ = static_cast<uint8_t***>(std::calloc(size_t{1} << root_bits_, sizeof(uint8_t**)));
+  if (root_==nullptr) {
+    throw std::bad_alloc();
   }
-  uint64_t block_index = GetBlockIndex(address);
-  uint64_t offset = GetBlockOffset(address);
-  if (!IsBlockPresent(block_index)) {
-    return 0;
+}
+
+Memory::~Memory() {
+  for (size_t i = 0; i < (size_t{1} << root_bits_); ++i) {
+    std::free(root_[i]);
   }
-  return blocks_[block_index].data[offset];
+  std::free(root_);
 }
 
-void Memory::Write(uint64_t address, uint8_t value) {
-  if (address >= memory_size_) {
-    throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));
+void Memory::Reset() {
+  for (auto &[page_number, slot] : mapped_pages_) {
+    arena_.Release(*slot);
+    *slot = nullptr;
   }
-  uint64_t block_index = GetBlockIndex(address);
-  uint64_t offset = GetBlockOffset(address);
-  EnsureBlockExists(block_index);
-  SimState_.MEMORY_DIRTY = true;
-  blocks_[block_index].data[offset] = value;
+  mapped_pages_.clear();
+  far_pages_.clear();
+
+  last_page_number_ = ~0ULL;
+  last_page_ = nullptr;
 }
 
-uint64_t Memory::GetBlockIndex(uint64_t address) const {
-  return address/block_size_;
+uint8_t* Memory::MapPage(uint64_t page_number, uint8_t** slot) {
+  *slot = arena_.Allocate();
+  mapped_pages_.emplace_back(page_number, slot);
+  return *slot;
 }
 
-uint64_t Memory::GetBlockOffset(uint64_t address) const {
-  return address%block_size_;
+uint8_t* Memory::WalkPageTable(uint64_t address, bool allocate) {
+  uint64_t page_number = GetPageNumber(address);
+  uint8_t** slot;
+
+  bool canonical = (static_cast<int64_t>(address << (64 - kVirtualAddressBits)) >> (64 - kVirtualAddressBits))
+                   ==static_cast<int64_t>(address);
+  if (canonical) {
+    uint64_t vpn = (address & ((1ULL << kVirtualAddressBits) - 1)) >> page_shift_;
+    uint64_t root_index = vpn >> leaf_bits_;
+    uint64_t leaf_index = vpn & ((1ULL << leaf_bits_) - 1);
+
+    uint8_t** leaf = root_[root_index];
+    if (leaf==nullptr) {
+      if (!allocate) {
+        return nullptr;
+      }
+      leaf = static_cast<uint8_t**>(std::calloc(size_t{1} << leaf_bits_, sizeof(uint8_t*)));
+      if (leaf==nullptr) {
+        throw std::bad_alloc();
+      }
+      root_[root_index] = leaf;
+    }
+    slot = &leaf[leaf_index];
+  } else {
+    auto it = far_pages_.find(page_number);
+    if (it==far_pages_.end()) {
+      if (!allocate) {
+        return nullptr;
+      }
+      it = far_pages_.emplace(page_number, nullptr).first;
+    }
+    slot = &it->second;
+  }
+
+  if (*slot==nullptr) {
+    if (!allocate) {
+      return nullptr;
+    }
+    MapPage(page_number, slot);
+  }
+
+  last_page_number_ = page_number;
+  last_page_ = *slot;
+  return last_page_;
 }
 
-bool Memory::IsBlockPresent(uint64_t block_index) const {
-  return blocks_.find(block_index)!=blocks_.end();
+uint8_t Memory::Read(uint64_t address) {
+  if (address >= memory_size_) {
+    throw std::out_of_range("Memory address out of range: " + std::to_string(address));
+  }
+  uint8_t* page = GetPage(address, false);
+  if (page==nullptr) {
+    return 0;
+  }
+  return page[GetPageOffset(address)];
 }
 
-void Memory::EnsureBlockExists(uint64_t block_index) {
-  if (blocks_.find(block_index)==blocks_.end()) {
-    blocks_.emplace(block_index, MemoryBlock());
+void Memory::Write(uint64_t address, uint8_t value) {
+  if (address >= memory_size_) {
+    throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));
   }
+  uint8_t* page = GetPage(address, true);
+  page[GetPageOffset(address)] = value;
 }
 
+// The fast path copies the guest bytes straight into the host value
+static_assert(std::endian::native==std::endian::little, "Memory assumes a little endian host");
+
 template<typename T>
 T Memory::ReadGeneric(uint64_t address) {
+  uint64_t offset = GetPageOffset(address);
+  if (offset + sizeof(T) <= page_size_) {
+    const uint8_t* page = GetPage(address, false);
+    if (page==nullptr) {
+      return 0;
+    }
+    T value;
+    std::memcpy(&value, page + offset, sizeof(T));
+    return value;
+  }
+
+  // access crosses a page boundary
   T value = 0;
   for (size_t i = 0; i < sizeof(T); ++i) {
     value |= static_cast<T>(Read(address + i)) << (8*i);
@@ -71,6 +172,14 @@ T Memory::ReadGeneric(uint64_t address) {
 
 template<typename T>
 void Memory::WriteGeneric(uint64_t address, T value) {
+  uint64_t offset = GetPageOffset(address);
+  if (offset + sizeof(T) <= page_size_) {
+    uint8_t* page = GetPage(address, true);
+    std::memcpy(page + offset, &value, sizeof(T));
+    return;
+  }
+
+  // access crosses a page boundary
   for (size_t i = 0; i < sizeof(T); ++i) {
     Write(address + i, static_cast<uint8_t>(value >> (8*i)));
   }
@@ -108,26 +217,14 @@ float Memory::ReadFloat(uint64_t address) {
   if (address >= memory_size_ - (sizeof(float) - 1)) {
     throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));;
   }
-  uint32_t value = 0;
-  for (size_t i = 0; i < sizeof(float); ++i) {
-    value |= static_cast<uint32_t>(Read(address + i)) << (8*i);
-  }
-  float result;
-  std::memcpy(&result, &value, sizeof(float));
-  return result;
+  return std::bit_cast<float>(ReadGeneric<uint32_t>(address));
 }
 
 double Memory::ReadDouble(uint64_t address) {
   if (address >= memory_size_ - (sizeof(double) - 1)) {
     throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));
   }
-  uint64_t value = 0;
-  for (size_t i = 0; i < sizeof(double); ++i) {
-    value |= static_cast<uint64_t>(Read(address + i)) << (8*i);
-  }
-  double result;
-  std::memcpy(&result, &value, sizeof(double));
-  return result;
+  return std::bit_cast<double>(ReadGeneric<uint64_t>(address));
 }
 
 void Memory::WriteByte(uint64_t address, uint8_t value) {
@@ -162,22 +259,14 @@ void Memory::WriteFloat(uint64_t address, float value) {
   if (address >= memory_size_ - (sizeof(float) - 1)) {
     throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));
   }
-  uint32_t value_bits;
-  std::memcpy(&value_bits, &value, sizeof(float));
-  for (size_t i = 0; i < sizeof(float); ++i) {
-    Write(address + i, static_cast<uint8_t>((value_bits >> (8*i)) & 0xFF));
-  }
+  WriteGeneric<uint32_t>(address, std::bit_cast<uint32_t>(value));
 }
 
 void Memory::WriteDouble(uint64_t address, double value) {
   if (address >= memory_size_ - (sizeof(double) - 1)) {
     throw std::out_of_range(std::string("Memory address out of range: ") + std::to_string(address));
   }
-  uint64_t value_bits;
-  std::memcpy(&value_bits, &value, sizeof(double));
-  for (size_t i = 0; i < sizeof(double); ++i) {
-    Write(address + i, static_cast<uint8_t>((value_bits >> (8*i)) & 0xFF));
-  }
+  WriteGeneric<uint64_t>(address, std::bit_cast<uint64_t>(value));
 }
 
 void Memory::PrintMemory(const uint64_t address, unsigned int rows) {
@@ -274,13 +363,15 @@ void Memory::GetMemoryPoint(std::string addr_str) {
 void Memory::printMemoryUsage() const {
   globals::vm_cout_file << "Memory Usage Report:\n";
   globals::vm_cout_file << "---------------------\n";
-  globals::vm_cout_file << "Block Count: " << blocks_.size() << "\n";
-  for (const auto &[block_index, block] : blocks_) {
-    size_t used_bytes = std::count_if(block.data.begin(), block.data.end(),
+  globals::vm_cout_file << "Page Size: " << page_size_ << " bytes\n";
+  globals::vm_cout_file << "Page Count: " << arena_.PagesInUse() << "\n";
+  for (const auto &[page_number, slot] : mapped_pages_) {
+    const uint8_t* page = *slot;
+    size_t used_bytes = std::count_if(page, page + page_size_,
                                       [](uint8_t byte) { return byte!=0; });
     if (used_bytes > 0) {
-      globals::vm_cout_file << "Block " << block_index << ": " << used_bytes
-                << " / " << block_size_ << " bytes used\n";
+      globals::vm_cout_file << "Page " << page_number << ": " << used_bytes
+                << " / " << page_size_ << " bytes used\n";
     }
   }
 
@@ -0,0 +1,376 @@
+#include "vm/ooo/core/core.h"
+
+#include <algorithm>
+
+namespace ooo
+{
+
+OooCore::OooCore(const Shape& default_shape) : default_shape_{default_shape}, shape_{default_shape}{
+	BuildLatches();
+}
+
+
+void OooCore::BuildLatches(){
+	if_id_.assign(shape_.width, OooInstrContext{});
+	id_issue_.assign(shape_.width, OooInstrContext{});
+
+	functional_units_.clear();
+	for(size_t kind=0;kind<static_cast<size_t>(FuKind::kCount);kind++){
+		for(size_t i=0;i<shape_.units[kind];i++){
+			functional_units_.push_back(FunctionalUnit{static_cast<FuKind>(kind), {}, {}, {},
+				FixedQueue<InProgress>(latency_table_.MaxLatency()), 0});
+		}
+	}
+	ResetLatches();
+}
+
+
+void OooCore::ResetLatches(){
+	for(OooInstrContext& instr : if_id_)
+		instr.illegal = true;
+	for(OooInstrContext& instr : id_issue_)
+		instr.illegal = true;
+
+	for(FunctionalUnit& fu : functional_units_){
+		fu.picked.illegal = true;
+		fu.exec.illegal = true;
+		fu.commit.illegal = true;
+		fu.in_progress.Clear();
+		fu.busy_until = 0;
+	}
+}
+
+
+void OooCore::SquashYoungerThan(const OooInstrContext& branch){
+	uint64_t cycle = core_stats_.cycles;
+	if(trace_.InWindow(cycle)){
+		size_t tail = commit_buffer_.GetHeadTail().second;
+		const std::vector<ROBBuffer::ROBBufferEntry>& entries = commit_buffer_.GetEntries();
+		for(size_t idx=(branch.rob_idx+1)%entries.size();idx!=tail;idx=(idx+1)%entries.size())
+			trace_.Record(cycle, pipeline_trace::Stage::Squash, entries[idx].instr.seq, entries[idx].instr.pc);
+		for(const std::vector<OooInstrContext>* row : {&id_issue_, &if_id_}){
+			for(const OooInstrContext& instr : *row){
+				if(!instr.illegal)
+					trace_.Record(cycle, pipeline_trace::Stage::Squash, instr.seq, instr.pc);
+			}
+		}
+	}
+
+	// the issue slots of the squashed instrs, and the empty ones until the refetched path issues, are bad speculation
+	size_t free_slots = commit_buffer_.EmptySlots();
+	commit_buffer_.ResetTailTillIdx(branch.rob_idx, *this);
+	core_stats_.top_down.bad_speculation += commit_buffer_.EmptySlots() - free_slots;
+	refilling_after_squash_ = true;
+
+	// everything before issue is younger than anything issued
+	for(OooInstrContext& instr : if_id_)
+		instr.illegal = true;
+	for(OooInstrContext& instr : id_issue_)
+		instr.illegal = true;
+
+	auto squashed = [this](const OooInstrContext& instr){ return !commit_buffer_.Holds(instr); };
+	for(FunctionalUnit& fu : functional_units_){
+		if(squashed(fu.picked))
+			fu.picked.illegal = true;
+		if(squashed(fu.exec))
+			fu.exec.illegal = true;
+		if(squashed(fu.commit))
+			fu.commit.illegal = true;
+		fu.in_progress.EraseIf([&](const InProgress& op){ return squashed(op.instr); });
+	}
+	for(ReservationStation& station : stations_)
+		station.Squash(commit_buffer_);
+	broadcast_bus_.waiting_results.EraseIf(squashed);
+	load_store_queue_.SquashYoungerThan(branch.seq);
+}
+
+
+bool OooCore::ProgramEnded(){
+	if(pc<program_size_)
+		return false;
+
+	for(const OooInstrContext& instr : if_id_){
+		if(!instr.illegal)
+			return false;
+	}
+	for(const OooInstrContext& instr : id_issue_){
+		if(!instr.illegal)
+			return false;
+	}
+	for(const FunctionalUnit& fu : functional_units_){
+		if(!fu.exec.illegal || !fu.commit.illegal || !fu.in_progress.Empty())
+			return false;
+	}
+	for(ReservationStation& station : stations_){
+		if(!station.Empty())
+			return false;
+	}
+
+	return commit_buffer_.Empty() && broadcast_bus_.waiting_results.Empty();
+}
+
+
+ReservationStation& OooCore::StationFor(const OooInstrContext& instr){
+	if(instr.mem_read || instr.mem_write)
+		return Station(FuKind::kLsu);
+	if(instr.into_falu && shape_.units[static_cast<size_t>(FuKind::kFpu)]>0)
+		return Station(FuKind::kFpu);
+	return Station(FuKind::kAlu);
+}
+
+
+void OooCore::SaveCheckpoint(CycleCheckpoint& checkpoint) const{
+	checkpoint.pc = pc;
+	checkpoint.next_seq = next_seq_;
+	checkpoint.if_id = if_id_;
+	checkpoint.id_issue = id_issue_;
+	checkpoint.functional_units = functional_units_;
+	checkpoint.stations = stations_;
+	checkpoint.commit_buffer = commit_buffer_;
+	checkpoint.broadcast_bus = broadcast_bus_;
+	checkpoint.reg_status_file = reg_status_file_;
+	checkpoint.load_store_queue = load_store_queue_;
+	checkpoint.refilling_after_squash = refilling_after_squash_;
+	checkpoint.core_stats = core_stats_;
+}
+
+
+void OooCore::RestoreCheckpoint(const CycleCheckpoint& checkpoint){
+	pc = checkpoint.pc;
+	next_seq_ = checkpoint.next_seq;
+	if_id_ = checkpoint.if_id;
+	id_issue_ = checkpoint.id_issue;
+	functional_units_ = checkpoint.functional_units;
+	stations_ = checkpoint.stations;
+	commit_buffer_ = checkpoint.commit_buffer;
+	broadcast_bus_ = checkpoint.broadcast_bus;
+	reg_status_file_ = checkpoint.reg_status_file;
+	load_store_queue_ = checkpoint.load_store_queue;
+	refilling_after_squash_ = checkpoint.refilling_after_squash;
+	core_stats_ = checkpoint.core_stats;
+}
+
+
+const OooInstrContext* OooCore::NextBreakpointCommit() const{
+	auto [head, tail] = commit_buffer_.GetHeadTail();
+	const std::vector<ROBBuffer::ROBBufferEntry>& entries = commit_buffer_.GetEntries();
+	for(size_t i=0, idx=head; i<shape_.commit_width && idx!=tail; i++, idx=(idx+1)%entries.size()){
+		const ROBBuffer::ROBBufferEntry& entry = entries[idx];
+		if(!entry.ready_to_commit)
+			return nullptr;
+		if(std::find(breakpoints_.begin(), breakpoints_.end(), entry.instr.pc)!=breakpoints_.end())
+			return &entry.instr;
+	}
+	return nullptr;
+}
+
+const OooInstrContext* OooCore::OldestInFlight() const{
+	auto [head, tail] = commit_buffer_.GetHeadTail();
+	if(head!=tail)
+		return &commit_buffer_.GetEntries()[head].instr;
+
+	for(const std::vector<OooInstrContext>* row : {&id_issue_, &if_id_}){
+		for(const OooInstrContext& instr : *row){
+			if(!instr.illegal)
+				return &instr;
+		}
+	}
+	return nullptr;
+}
+
+
+void OooCore::ClearStop(){
+    stop_requested_ = false;
+}
+
+
+void OooCore::ApplyShape(){
+    shape_.width = config_.getIssueWidth(default_shape_.width);
+    shape_.commit_width = config_.getCommitWidth(shape_.width);
+    shape_.units[static_cast<size_t>(FuKind::kAlu)] = config_.getAluUnits(default_shape_.units[static_cast<size_t>(FuKind::kAlu)]);
+    shape_.units[static_cast<size_t>(FuKind::kFpu)] = config_.getFpuUnits(default_shape_.units[static_cast<size_t>(FuKind::kFpu)]);
+    shape_.units[static_cast<size_t>(FuKind::kLsu)] = config_.getLsuUnits(default_shape_.units[static_cast<size_t>(FuKind::kLsu)]);
+    shape_.rob_size = config_.getRobSize(default_shape_.rob_size);
+    shape_.load_queue_size = config_.getLoadQueueSize(default_shape_.load_queue_size);
+    shape_.store_queue_size = config_.getStoreQueueSize(default_shape_.store_queue_size);
+    BuildLatches();
+
+    size_t reservation_station_size = config_.getReservationStationSize();
+    for(ReservationStation& station : stations_)
+        station = ReservationStation(reservation_station_size);
+
+    commit_buffer_ = ReorderBuffer(shape_.rob_size);
+    load_store_queue_ = LoadStoreQueue(shape_.load_queue_size, shape_.store_queue_size);
+    // a result waits on the bus at most until every unit has put out the ops it has in flight
+    broadcast_bus_ = CommonDataBus(functional_units_.size() * (latency_table_.MaxLatency() + 1));
+    broadcast_bus_.SetWidth(config_.getCdbWidth());
+
+    // every instruction that can be in flight (both rows of latches, the units, the stations, the ROB) or fetched
+    // during the cycles Undo() can go back (a cycle fetches up to width of them)
+    size_t in_flight = 2 * shape_.width + 3 * functional_units_.size() + stations_.size() * reservation_station_size
+        + shape_.rob_size;
+    undo_records_.Reserve(max_undo_stack_size_ * shape_.width + in_flight);
+    undo_instruction_stack_.Reserve(max_undo_stack_size_ * shape_.commit_width);
+
+    // every checkpoint starts out with the containers of this shape, so taking one only copies into them
+    CycleCheckpoint prototype;
+    SaveCheckpoint(prototype);
+    undo_cycles_.Reserve(max_undo_stack_size_, prototype);
+}
+
+
+uint64_t OooCore::GetProgramCounter() const{
+    return pc;
+}
+void OooCore::AddToProgramCounter(int64_t value){
+    pc = static_cast<uint64_t>(static_cast<int64_t>(pc) + value);
+}
+void OooCore::SetProgramCounter(uint64_t value){
+    pc = value;
+}
+
+
+void OooCore::SetLog(std::ostream& log){
+    log_ = &log;
+    fast_forward_engine_.SetLog(log);
+}
+
+void OooCore::Reset(){
+    ResetLatches();
+
+    pc = 0;
+    refilling_after_squash_ = false;
+
+    branch_prediction_enabled_ = false;
+	branch_prediction_static_ = false;
+
+
+    debug_mode_ = true;
+    undo_instruction_stack_.Clear();
+    undo_cycles_.Clear();
+    max_undo_stack_size_ = 256;
+    next_seq_ = 0;
+    stop_requested_ = false;
+    breakpoints_.clear();
+
+    register_file_.Reset();
+    memory_controller_.SetCacheConfigs(config_.icache_config, config_.dcache_config);
+    memory_controller_.Reset();
+    for(ReservationStation& station : stations_)
+        station.Reset();
+    broadcast_bus_.Reset();
+    commit_buffer_.Reset();
+    load_store_queue_.Reset();
+    reg_status_file_.Reset();
+    branch_predictor_.Reset();
+
+    program_size_ = 0;
+
+	core_stats_ = VmBase::Stats{};
+	profile_.Resize(program_size_);
+	host_profile_.Reset();
+}
+
+
+void OooCore::Load(){
+    Reset();
+
+    // updating core state
+	max_undo_stack_size_ = config_.getMaxUndoStackSize();
+
+	std::vector<bool> t = config_.getBranchPredictionStatus();
+	this->branch_prediction_enabled_ = t[0];
+	this->branch_prediction_static_ = t[1];
+	this->branch_predictor_.Configure(config_.getBranchPredictorConfig());
+	this->latency_table_.Configure(config_.latency_config);
+
+	ApplyShape();
+}
+
+void OooCore::Load(AssembledProgram& program){
+    Reset();
+
+    // updating core state
+	max_undo_stack_size_ = config_.getMaxUndoStackSize();
+
+	std::vector<bool> t = config_.getBranchPredictionStatus();
+	this->branch_prediction_enabled_ = t[0];
+	this->branch_prediction_static_ = t[1];
+	this->branch_predictor_.Configure(config_.getBranchPredictorConfig());
+	this->latency_table_.Configure(config_.latency_config);
+
+	ApplyShape();
+
+
+    // Loading the instructions (machine code) into memory
+	unsigned int counter = 0;
+	for (const auto &instruction: program.text_buffer) {
+		this->memory_controller_.WriteWord(counter, instruction);
+		counter += 4;
+	}
+	this->program_size_ = counter;
+	this->memory_controller_.SetTextSize(program_size_);
+	this->profile_.Resize(program_size_);
+	this->trace_.Open(config_.trace_config);
+
+    // Loading data section into memory
+    unsigned int data_counter = 0;
+	uint64_t base_data_address = config_.getDataSectionStart();
+
+	auto align = [&](unsigned int alignment) {
+		if (data_counter % alignment != 0)
+		data_counter += alignment - (data_counter % alignment);
+	};
+
+    for (const auto& data : program.data_buffer) {
+		std::visit([&](auto&& value) {
+			using T = std::decay_t<decltype(value)>; 
+			
+
+			if constexpr (std::is_same_v<T, uint8_t>) {
+				align(1);
+				memory_controller_.WriteByte(base_data_address + data_counter, value);  // Write a byte
+				data_counter += 1;
+			}
+			else if constexpr (std::is_same_v<T, uint16_t>) {
+				align(2);
+				memory_controller_.WriteHalfWord(base_data_address + data_counter, value);  // Write a halfword (16 bits)
+				data_counter += 2;
+			}
+			else if constexpr (std::is_same_v<T, uint32_t>) {
+				align(4);
+				memory_controller_.WriteWord(base_data_address + data_counter, value);  // Write a word (32 bits)
+				data_counter += 4;
+			}
+			else if constexpr (std::is_same_v<T, uint64_t>) {
+				align(8);
+				memory_controller_.WriteDoubleWord(base_data_address + data_counter, value);  // Write a double word (64 bits)
+				data_counter += 8;
+			}
+			else if constexpr (std::is_same_v<T, float>) {
+				align(4);
+				uint32_t float_as_int;
+				std::memcpy(&float_as_int, &value, sizeof(float));
+				memory_controller_.WriteWord(base_data_address + data_counter, float_as_int);  // Write the float as a word
+				data_counter += 4;
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				align(8);
+				uint64_t double_as_int;
+				std::memcpy(&double_as_int, &value, sizeof(double));
+				memory_controller_.WriteDoubleWord(base_data_address + data_counter, double_as_int);  // Write the double as a double word
+				data_counter += 8;
+			}
+			else if constexpr (std::is_same_v<T, std::string>) {
+				align(1);
+				for (size_t i = 0; i < value.size(); i++) {
+					memory_controller_.WriteByte(base_data_address + data_counter, static_cast<uint8_t>(value[i]));  // Write each byte of the string
+					data_counter += 1;
+				}
+			}
+		}, data);
+	}
+}
+
+    
+} // namespace ooo
@@ -1,12 +1,12 @@
-#include "vm/dual_issue/core/instruction_context/instruction_context.h"
+#include "vm/ooo/core/instruction_context/instruction_context.h"
 
-namespace dual_issue{
+namespace ooo{
 
-DualIssueInstrContext::DualIssueInstrContext() : InstrContext() {}
+OooInstrContext::OooInstrContext() : InstrContext() {}
 
-DualIssueInstrContext::DualIssueInstrContext(uint64_t pc) : InstrContext(pc){}
+OooInstrContext::OooInstrContext(uint64_t pc) : InstrContext(pc){}
 
-void DualIssueInstrContext::reset_id_vars(){
+void OooInstrContext::reset_id_vars(){
     alu_op = alu::AluOp::kNone;
     
     opcode = 0;
@@ -61,5 +61,6 @@ void DualIssueInstrContext::reset_id_vars(){
 
     // bools for status
     ready_to_exec = false;
+    store_addr_done = false;
 }
 }
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include "vm/ooo/executor/executor.h"
+
+// anonymous namespace
+namespace {
+
+/**
+ * Top-down accounting of the issue slots of a cycle, num_delivered instructions went into the reservation stations
+ * (counted once they retire or are squashed). If issue stalled, the backend couldn't take the rest; otherwise the
+ * frontend had nothing for them, which is bad speculation while it refills after a squash.
+ */
+void CountIssueSlots(ooo::OooCore& vm_core, size_t num_delivered, bool stalled){
+    VmBase::TopDown& top_down = vm_core.core_stats_.top_down;
+    size_t num_empty = vm_core.id_issue_.size() - num_delivered;
+
+    if(num_delivered>0)
+        vm_core.refilling_after_squash_ = false;
+
+    if(stalled)
+        top_down.backend_bound += num_empty;
+    else if(vm_core.refilling_after_squash_)
+        top_down.bad_speculation += num_empty;
+    else
+        top_down.frontend_bound += num_empty;
+}
+
+/**
+ * One cycle. With kDebug the cycle is checkpointed and the instructions it retires are kept, so Undo() can take it
+ * back
+ */
+template<bool kDebug>
+void StepOooImpl(ooo::OooCore& vm_core){
+    using ooo::OooCore;
+    using ooo::OooStages;
+    using ooo::FuKind;
+
+    HOST_PROFILE_SCOPE(vm_core.host_profile_, Cycle);
+
+    if constexpr (kDebug){
+        vm_core.SaveCheckpoint(vm_core.undo_cycles_.PushSlot());
+    }
+
+    // Driving the pipeline part 1
+    uint64_t now = vm_core.core_stats_.cycles;
+    for(OooCore::FunctionalUnit& fu : vm_core.functional_units_){
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Select);
+        // a unit that isn't pipelined for the op it executes this cycle takes nothing until its interval is up
+        if(fu.kind!=FuKind::kLsu && !fu.exec.illegal)
+            fu.busy_until = now + vm_core.latency_table_[fu.exec.alu_op].interval;
+        if(now + 1 < fu.busy_until){
+            fu.picked = ooo::OooInstrContext{};
+            fu.picked.illegal = true;
+            continue;
+        }
+
+        ooo::ReservationStation& station = vm_core.Station(fu.kind);
+        fu.picked = (fu.kind==FuKind::kLsu) ? station.GetReadyMemInstr(vm_core.load_store_queue_) : station.GetReadyInstr();
+    }
+
+    // Issue
+    auto count_legal = [](auto begin, auto end){
+        return static_cast<size_t>(std::count_if(begin, end, [](const ooo::OooInstrContext& instr){ return !instr.illegal; }));
+    };
+    size_t width = vm_core.id_issue_.size();
+    size_t num_waiting = count_legal(vm_core.id_issue_.begin(), vm_core.id_issue_.end());
+    size_t num_issued;
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Issue);
+        num_issued = OooStages::Issue(vm_core);
+    }
+    size_t num_delivered = num_waiting - count_legal(vm_core.id_issue_.begin(), vm_core.id_issue_.end() - num_issued);
+    CountIssueSlots(vm_core, num_delivered, num_issued<width);
+
+    // Writeback, the profile charges the cycle to the first instruction it retires
+    const ooo::OooInstrContext* rob_head = vm_core.OldestInFlight();
+    pc_profile::CycleCharge charge;
+    charge.charged = rob_head!=nullptr;
+    charge.pc = rob_head!=nullptr ? rob_head->pc : 0;
+    size_t retired_before = vm_core.core_stats_.instrs_retired;
+
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Commit);
+        vm_core.commit_buffer_.Commit(vm_core);
+    }
+
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Broadcast);
+        vm_core.commit_buffer_.Pull(vm_core);
+    }
+
+    // Decode
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Decode);
+        OooStages::Decode(vm_core);
+    }
+    
+    // Driving the pipeline part 2
+    // the issued id_issue_ slots (the youngest ones, Issue() moved the stalled ones up) take the oldest decoded
+    // instructions, the rest of if_id_ moves up and Fetch() refills its youngest num_issued slots
+    std::vector<ooo::OooInstrContext>& if_id = vm_core.if_id_;
+    std::vector<ooo::OooInstrContext>& id_issue = vm_core.id_issue_;
+    for(size_t i=0;i<num_issued;i++){
+        id_issue[width-num_issued+i] = if_id[i];
+    }
+    for(size_t i=num_issued;i<width;i++){
+        if_id[i-num_issued] = if_id[i];
+    }
+
+    // Fetch
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Fetch);
+        OooStages::Fetch(vm_core, num_issued);
+    }
+
+    // Exec
+    for(OooCore::FunctionalUnit& fu : vm_core.functional_units_){
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Execute);
+        OooStages::Execute(fu, vm_core);
+        if(fu.exec.illegal)
+            continue;
+
+        // a mispredicted branch squashes the younger instrs right away, those on the units after this one too
+        if(fu.exec.branch)
+            OooStages::ResolveBranch(fu.exec, vm_core);
+
+        // a multi-cycle op leaves the commit latch empty and waits on the unit for its latency
+        unsigned int latency = fu.kind==FuKind::kLsu ? 1 : vm_core.latency_table_[fu.exec.alu_op].latency;
+        if(latency>1){
+            fu.in_progress.PushBack({now + latency, fu.exec});
+            fu.exec.illegal = true;
+        }
+    }
+
+    for(OooCore::FunctionalUnit& fu : vm_core.functional_units_){
+        fu.commit = fu.exec;
+        fu.exec = fu.picked;
+    }
+
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Broadcast);
+        for(size_t kind=0;kind<static_cast<size_t>(FuKind::kCount);kind++){
+            vm_core.Station(static_cast<FuKind>(kind)).ListenToBroadCast(vm_core.broadcast_bus_);
+        }
+        vm_core.Station(FuKind::kLsu).ResolveStoreAddresses(vm_core.load_store_queue_);
+        vm_core.broadcast_bus_.EndCycle();
+    }
+
+    // cache misses are modelled as blocking: the whole machine waits for the access
+    memory_controller::StallCycles stalls = vm_core.memory_controller_.TakeStallCycles();
+    vm_core.core_stats_.AddCycle(width, stalls);
+
+    // if nothing retired, the cycle goes to the instruction retirement waits on
+    charge.cycles = 1 + stalls.Total();
+    charge.stall_cycles = stalls.Total();
+    if(vm_core.core_stats_.instrs_retired==retired_before){
+        const ooo::OooInstrContext* oldest = vm_core.OldestInFlight();
+        charge.charged = oldest!=nullptr;
+        charge.pc = oldest!=nullptr ? oldest->pc : 0;
+        charge.stall_cycles++;
+    }
+    vm_core.profile_.Charge(charge);
+
+    if constexpr (kDebug){
+        vm_core.undo_cycles_.Top().profile_charge = charge;
+    }
+}
+
+// puts back the register values (or the memory, for a store) the retired instruction overwrote
+void UndoRetire(const ooo::OooInstrContext& instr, ooo::OooCore& vm_core){
+    const UndoRecord& record = vm_core.undo_records_[instr.seq];
+    vm_core.profile_.Subtract(instr.pc, pc_profile::PcCounters{1, 0, 0, instr.branch && instr.branch_mispredicted});
+
+    if(instr.mem_write){
+        vm_core.memory_controller_.WriteSized(instr.alu_out, instr.mem_access_bytes, record.mem_overwritten);
+        return;
+    }
+
+    if(instr.opcode==0b1110011){ // CSR opcode
+        vm_core.register_file_.WriteCsr(instr.csr_rd, record.csr_overwritten);
+        vm_core.register_file_.WriteGpr(instr.rd, record.reg_overwritten);
+        return;
+    }
+
+    if(instr.fcsr_update){
+        vm_core.register_file_.WriteCsr(0x003, record.fcsr_overwritten);
+    }
+
+    if(!instr.reg_write)
+        return;
+
+    if(instr.reg_write_to_fpr){
+        vm_core.register_file_.WriteFpr(instr.rd, record.reg_overwritten);
+    }
+    else{
+        vm_core.register_file_.WriteGpr(instr.rd, record.reg_overwritten);
+    }
+}
+
+}
+
+
+namespace ooo
+{
+    
+void OooExecutor::RunOoo(OooCore& vm_core){
+    uint64_t cycles_executed = 0;
+
+    // Run() doesn't keep undo records, the cycles stepped before it can't be undone across it either
+    vm_core.debug_mode_ = false;
+    vm_core.undo_cycles_.Clear();
+    vm_core.undo_instruction_stack_.Clear();
+
+    while(!vm_core.stop_requested_ && !vm_core.ProgramEnded()){
+        if(cycles_executed > vm_core.config_.getInstructionExecutionLimit())
+            break;
+
+        StepOooImpl<false>(vm_core);
+        cycles_executed++;
+    }
+
+    vm_core.debug_mode_ = true;
+
+    if(vm_core.ProgramEnded()){
+        vm_core.Log() << "Vm: the loaded program has ended!" << std::endl;
+    }
+}
+
+void OooExecutor::DebugRunOoo(OooCore& vm_core, const std::function<bool()>& after_step){
+    uint64_t cycles_executed = 0;
+
+    while(!vm_core.stop_requested_ && !vm_core.ProgramEnded()){
+        if(cycles_executed >= vm_core.config_.getInstructionExecutionLimit())
+            break;
+
+        // the program stops before the cycle a breakpoint instruction would commit in, registers and memory then
+        // hold the state before that cycle's commits. The first cycle always runs, so a run started at a breakpoint
+        // gets past it
+        const OooInstrContext* breakpoint = vm_core.NextBreakpointCommit();
+        if(cycles_executed!=0 && breakpoint!=nullptr) {
+            vm_core.Log() << " Breakpoint was hit. pc : " << breakpoint->pc << std::endl;
+            break;
+        }
+
+        StepOooImpl<true>(vm_core);
+        cycles_executed++;
+
+        if(!after_step())
+            break;
+    }
+
+    if(vm_core.ProgramEnded()){
+        vm_core.Log() << "VM : Program Has Ended" << std::endl;
+    }
+}
+
+void OooExecutor::StepOoo(OooCore& vm_core){
+    if(vm_core.ProgramEnded()){
+        vm_core.Log() << "Cannot step further." << std::endl;
+        return;
+    }
+
+    StepOooImpl<true>(vm_core);
+}
+
+void OooExecutor::UndoOoo(OooCore& vm_core){
+    if(vm_core.undo_cycles_.Empty()){
+        vm_core.Log() << "Cannot undo." << std::endl;
+        return;
+    }
+
+    const OooCore::CycleCheckpoint& checkpoint = vm_core.undo_cycles_.Top();
+
+    // the retirements of the cycle, newest first
+    size_t num_retired = vm_core.core_stats_.instrs_retired - checkpoint.core_stats.instrs_retired;
+    for(size_t i=0;i<num_retired && !vm_core.undo_instruction_stack_.Empty();i++){
+        UndoRetire(vm_core.undo_instruction_stack_.Top(), vm_core);
+        vm_core.undo_instruction_stack_.Pop();
+    }
+
+    const pc_profile::CycleCharge& charge = checkpoint.profile_charge;
+    if(charge.charged)
+        vm_core.profile_.Subtract(charge.pc, pc_profile::PcCounters{0, charge.cycles, charge.stall_cycles, 0});
+
+    vm_core.RestoreCheckpoint(checkpoint);
+    vm_core.undo_cycles_.Pop();
+
+    vm_core.Log() << "Program Counter: " << vm_core.pc << std::endl;
+    vm_core.Log() << "VM : Undo Complete!" << std::endl;
+}
+
+uint64_t OooExecutor::FastForwardOoo(OooCore& vm_core, uint64_t num_instrs){
+    // the instructions in flight would be lost
+    if(vm_core.core_stats_.cycles!=0){
+        vm_core.Log() << "VM : Fast forward is only possible before the first cycle." << std::endl;
+        return 0;
+    }
+
+    uint64_t retired = vm_core.fast_forward_engine_.Run(vm_core.pc, num_instrs, vm_core.program_size_,
+                                                        vm_core.register_file_, vm_core.memory_controller_,
+                                                        vm_core.stop_requested_);
+    vm_core.undo_instruction_stack_.Clear();
+    vm_core.undo_cycles_.Clear();
+    return retired;
+}
+
+} // namespace ooo
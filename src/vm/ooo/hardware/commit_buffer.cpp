@@ -0,0 +1,234 @@
+#include "vm/ooo/hardware/commit_buffer.h"
+#include "vm/ooo/core/core.h"
+#include "vm/ooo/stages/stages.h"
+
+
+namespace ooo{
+
+ROBBuffer::ROBBuffer() : max_size{16}, buffer(max_size){
+    Reset();
+}
+
+ROBBuffer::ROBBuffer(size_t slots) : max_size{slots}, buffer(slots){
+    Reset();
+}
+
+size_t ROBBuffer::EmptySlots(){
+    if(tail >= head){
+        return max_size - (tail-head)-1;
+    }
+    else{
+        return head-tail-1;
+    }
+}
+
+bool ROBBuffer::Empty(){
+    return head==tail;
+}
+
+bool ROBBuffer::HeadReady(){
+    return buffer[head].ready_to_commit;
+}
+
+bool ROBBuffer::InLimits(size_t idx){
+    if(tail>head){
+        if(idx>=head && idx<tail)
+            return true;
+        return false;
+    }
+    else if(tail<head){
+        if((idx>=head || idx<tail) && idx<max_size)
+            return true;
+        return false;
+    }
+    else
+        return false;
+}
+
+bool ROBBuffer::Push(OooInstrContext instr){
+    if(!InLimits(instr.rob_idx))
+        return false;
+
+    if(buffer[instr.rob_idx].epoch_number!=instr.epoch)
+        return false;
+
+    buffer[instr.rob_idx].ready_to_commit = true;
+    buffer[instr.rob_idx].instr = instr;
+    return true;
+}
+
+OooInstrContext ROBBuffer::Top(){
+    return buffer[head].instr;
+}
+
+void ROBBuffer::Pop(){
+    buffer[head].ready_to_commit = false;
+    buffer[head].instr.illegal = true;
+    head = (head+1) % max_size;
+}
+
+std::pair<size_t, size_t> ROBBuffer::Reserve(const OooInstrContext& instr){
+    epoch_counter++;
+    size_t ret = tail;
+    buffer[tail].epoch_number = epoch_counter;
+    buffer[tail].instr = instr;
+    tail = (tail+1) % max_size;
+    return {ret, epoch_counter};
+}
+
+std::tuple<bool, uint64_t, uint64_t> ROBBuffer::QueryVal(uint64_t idx){
+    uint64_t write_val = buffer[idx].instr.mem_to_reg 
+        ? buffer[idx].instr.mem_out 
+        : buffer[idx].instr.alu_out;
+
+    return {buffer[idx].ready_to_commit, write_val, buffer[idx].epoch_number};
+}
+
+bool ROBBuffer::Holds(const OooInstrContext& instr){
+    if(instr.illegal || !InLimits(instr.rob_idx))
+        return false;
+    return buffer[instr.rob_idx].epoch_number==instr.epoch;
+}
+
+void ROBBuffer::Reset(){
+    tail = 0;
+    head = 0;
+
+    for(size_t i=0;i<max_size;i++){
+        buffer[i].ready_to_commit = false;
+        buffer[i].instr.illegal = true;
+    }
+}
+
+const std::vector<ROBBuffer::ROBBufferEntry>& ROBBuffer::GetEntries() const{
+    return buffer;
+}
+std::pair<size_t, size_t> ROBBuffer::GetHeadTail() const{
+    return {head, tail};
+}
+
+
+void ROBBuffer::ResetTailTillIdx(size_t till_head, OooCore& vm_core){
+    for(size_t idx=(till_head+1)%max_size;idx!=tail;idx=(idx+1)%max_size){
+        buffer[idx].ready_to_commit = false;
+        buffer[idx].instr.illegal = true;
+    }
+    tail = (till_head+1)%max_size;
+
+    // the squashed instrs may have taken over the rd of older ones that are still in flight
+    vm_core.reg_status_file_.Reset();
+    for(size_t idx=head;idx!=tail;idx=(idx+1)%max_size){
+        const OooInstrContext& instr = buffer[idx].instr;
+        if(instr.reg_write){
+            vm_core.reg_status_file_.UpdateTableRobIdx(instr.rd, !instr.reg_write_to_fpr, idx);
+        }
+    }
+}
+
+} // namespace ooo
+
+
+namespace ooo
+{
+
+size_t ReorderBuffer::EmptySlots(){
+    return buffer.EmptySlots();
+}
+
+bool ReorderBuffer::Empty(){
+    return buffer.Empty();
+}
+
+
+void ReorderBuffer::Pull(OooCore& vm_core){
+    CommonDataBus& data_bus = vm_core.broadcast_bus_;
+
+    for(OooCore::FunctionalUnit& fu : vm_core.functional_units_){
+        if(!fu.commit.illegal){
+            data_bus.Request(fu.commit);
+        }
+
+        // multi-cycle results whose latency is up
+        size_t num_ready = 0;
+        while(num_ready<fu.in_progress.Size() && fu.in_progress[num_ready].ready_cycle<=vm_core.core_stats_.cycles){
+            data_bus.Request(fu.in_progress[num_ready].instr);
+            num_ready++;
+        }
+        fu.in_progress.PopFront(num_ready);
+    }
+
+    // results that lose arbitration stay on the bus and are written back next cycle
+    OooInstrContext instr;
+    while(data_bus.Grant(instr)){
+        Push(instr, vm_core);
+    }
+}
+
+void ReorderBuffer::Push(OooInstrContext& instr, OooCore& vm_core){
+    if(buffer.Push(instr)){
+        BroadCastMsgs(instr, vm_core.broadcast_bus_, false);
+        vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Complete, instr.seq, instr.pc);
+    }
+    else{
+        BroadCastMsgs(instr, vm_core.broadcast_bus_, true);
+        vm_core.reg_status_file_.EndDependency(instr.rd, instr.rob_idx, !instr.reg_write_to_fpr);
+    }
+}
+
+
+void ReorderBuffer::BroadCastMsgs(OooInstrContext& instr, CommonDataBus& data_bus, bool clear_dependency){
+    if(instr.reg_write){
+        uint64_t broadcast_val = instr.mem_to_reg ? instr.mem_out : instr.alu_out;
+        data_bus.BroadCast(instr.rob_idx, broadcast_val, clear_dependency, instr.epoch);
+    }
+}
+
+
+std::pair<size_t, size_t> ReorderBuffer::Reserve(const OooInstrContext& instr){
+    return buffer.Reserve(instr);
+}
+
+std::tuple<bool, uint64_t, uint64_t> ReorderBuffer::QueryVal(uint64_t idx){
+    return buffer.QueryVal(idx);
+}
+
+
+void ReorderBuffer::Commit(OooCore& vm_core){
+    // The ROB can commit commit_width instructions in 1 cycle. doing it in a for loop instead of making that many
+    // write ports
+    for(size_t i=0;i<vm_core.GetShape().commit_width;i++){
+
+        if(!buffer.HeadReady())
+            return;
+        
+        OooInstrContext top_instr = buffer.Top();
+        
+        buffer.Pop();
+        OooStages::WriteBack(top_instr, vm_core);
+        vm_core.reg_status_file_.EndDependency(top_instr.rd, top_instr.rob_idx, !top_instr.reg_write_to_fpr);
+    }
+}
+
+
+bool ReorderBuffer::Holds(const OooInstrContext& instr){
+    return buffer.Holds(instr);
+}
+
+void ReorderBuffer::Reset(){
+    buffer.Reset();
+}
+
+const std::vector<ROBBuffer::ROBBufferEntry>& ReorderBuffer::GetEntries() const{
+    return buffer.GetEntries();
+}
+
+std::pair<size_t, size_t> ReorderBuffer::GetHeadTail() const{
+    return buffer.GetHeadTail();
+}
+
+
+void ReorderBuffer::ResetTailTillIdx(size_t till_head, OooCore& vm_core){
+    buffer.ResetTailTillIdx(till_head, vm_core);
+}
+
+} // namespace ooo
@@ -0,0 +1,42 @@
+#include "vm/ooo/hardware/data_bus.h"
+
+namespace ooo
+{
+
+CommonDataBus::CommonDataBus(size_t slots) : broadcast_msgs(slots), waiting_results(slots){}
+
+void CommonDataBus::SetWidth(size_t width){
+    width_ = width;
+}
+
+void CommonDataBus::Reset(){
+    broadcast_msgs.Clear();
+    waiting_results.Clear();
+    granted_ = 0;
+}
+
+void CommonDataBus::EndCycle(){
+    broadcast_msgs.Clear();
+    granted_ = 0;
+}
+
+void CommonDataBus::BroadCast(uint64_t rob_idx, uint64_t val, bool clear_dependency, uint64_t epoch){
+    broadcast_msgs.PushBack(BroadCastMessage(rob_idx, val, clear_dependency, epoch));
+}
+
+void CommonDataBus::Request(const OooInstrContext& instr){
+    waiting_results.PushBack(instr);
+}
+
+bool CommonDataBus::Grant(OooInstrContext& instr){
+    if(waiting_results.Empty() || (width_!=0 && granted_>=width_)){
+        return false;
+    }
+
+    instr = waiting_results.Front();
+    waiting_results.PopFront();
+    granted_++;
+    return true;
+}
+
+} // namespace ooo
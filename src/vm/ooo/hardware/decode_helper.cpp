@@ -1,11 +1,11 @@
-#include "vm/dual_issue/hardware/decode_helper.h"
+#include "vm/ooo/hardware/decode_helper.h"
 
 namespace DecoderHelper
 {
 
-using namespace dual_issue;
+using namespace ooo;
 
-void SetContextValues(DualIssueInstrContext& instr_context){
+void SetContextValues(OooInstrContext& instr_context){
     uint8_t& opcode = instr_context.opcode;
     uint8_t& funct2 = instr_context.funct2;
     uint8_t& funct3 = instr_context.funct3;
@@ -4,24 +4,44 @@
  * @author Vishank Singh, https://github.com/VishankSingh
  */
 
-#include "vm/dual_issue/hardware/decode_unit.h"
-#include "vm/dual_issue/hardware/decode_helper.h"
+#include "vm/ooo/hardware/decode_unit.h"
+#include "vm/ooo/hardware/decode_helper.h"
 
-namespace dual_issue{
+namespace ooo{
 
 using instruction_set::Instruction;
 using instruction_set::get_instr_encoding;
 using register_file::RegisterFile;
 
-void DualIssueDecodeUnit::DecodeInstruction(DualIssueInstrContext& instr_context){
+void OooDecodeUnit::DecodeInstruction(OooInstrContext& instr_context, predecode::PredecodeTable& predecode_table){
+    if(predecode_table.Lookup(instr_context))
+        return;
+
+    DecodeStaticFields(instr_context);
+    predecode_table.Insert(instr_context);
+}
+
+
+void OooDecodeUnit::DecodeStaticFields(OooInstrContext& instr_context){
     DecodeInstrFields(instr_context);
     SetContextValues(instr_context);
-    // this function should be called after SetContextValues(DualIssueInstrContext);
+    // this function should be called after SetContextValues(OooInstrContext);
     SetMemValues(instr_context);
+    SetAluQue(instr_context);
+}
+
+
+void OooDecodeUnit::SetAluQue(OooInstrContext& instr_context){
+    if(instr_context.mem_read || instr_context.mem_write){
+        instr_context.into_falu = false;
+        return;
+    }
+
+    instr_context.into_falu = instruction_set::uses_falu(instr_context.instruction);
 }
 
 
-void DualIssueDecodeUnit::DecodeInstrFields(DualIssueInstrContext& instr_context){
+void OooDecodeUnit::DecodeInstrFields(OooInstrContext& instr_context){
     instr_context.opcode = instr_context.instruction & 0b1111111;
 
     instr_context.funct2 = (instr_context.instruction >> 25) & 0b11;
@@ -34,10 +54,16 @@ void DualIssueDecodeUnit::DecodeInstrFields(DualIssueInstrContext& instr_context
     instr_context.frs3 = (instr_context.instruction >> 27) & 0b11111;
 
     instr_context.rd = (instr_context.instruction >> 7) & 0b11111; 
+
+    instr_context.immediate = ImmGenerator(instr_context);
+
+    // csr related
+    instr_context.csr_rd = (instr_context.instruction >> 20) & 0xFFF;
+    instr_context.csr_uimm = instr_context.rs1;
 }
 
 
-void DualIssueDecodeUnit::SetRegImmValues(DualIssueInstrContext& instr_context, RegisterFile& rf){
+void OooDecodeUnit::SetRegValues(OooInstrContext& instr_context, RegisterFile& rf){
     // the values are correct because the register is uint8_t, the first 3 bits are always 0. (32 : 00011111)
     // ReadGpr uses size_t. implicit sign extension retains the correct register value.
     
@@ -48,17 +74,13 @@ void DualIssueDecodeUnit::SetRegImmValues(DualIssueInstrContext& instr_context,
     instr_context.frs2_value = rf.ReadFpr(instr_context.rs2);
     instr_context.frs3_value = rf.ReadFpr(instr_context.frs3);
     
-    instr_context.immediate = ImmGenerator(instr_context);
-    
     // csr related
-    instr_context.csr_rd = (instr_context.instruction >> 20) & 0xFFF;
     instr_context.csr_value = rf.ReadCsr(instr_context.csr_rd);
-    instr_context.csr_uimm = instr_context.rs1;
     instr_context.csr_write_val = instr_context.rs1_value;
 }
 
 
-void DualIssueDecodeUnit::SetMemValues(DualIssueInstrContext& instr_context){
+void OooDecodeUnit::SetMemValues(OooInstrContext& instr_context){
     instr_context.mem_access_bytes = 0;
     
     if(!instr_context.mem_read && !instr_context.mem_write)
@@ -87,13 +109,25 @@ void DualIssueDecodeUnit::SetMemValues(DualIssueInstrContext& instr_context){
             case 0b011: {// SD
                 instr_context.mem_access_bytes = 8;
                 break;
+            }
+            case 0b100: {// LBU
+                instr_context.mem_access_bytes = 1;
+                break;
+            }
+            case 0b101: {// LHU
+                instr_context.mem_access_bytes = 2;
+                break;
+            }
+            case 0b110: {// LWU
+                instr_context.mem_access_bytes = 4;
+                break;
             }
 		}
     }
 }
 
 
-void DualIssueDecodeUnit::SetContextValues(DualIssueInstrContext& instr_context) {
+void OooDecodeUnit::SetContextValues(OooInstrContext& instr_context) {
     
     DecoderHelper::SetContextValues(instr_context);
     
@@ -105,7 +139,7 @@ void DualIssueDecodeUnit::SetContextValues(DualIssueInstrContext& instr_context)
 
 
 
-int32_t DualIssueDecodeUnit::ImmGenerator(DualIssueInstrContext& instr_context){
+int32_t OooDecodeUnit::ImmGenerator(OooInstrContext& instr_context){
     int32_t imm = 0;
     uint32_t& instruction = instr_context.instruction;
 
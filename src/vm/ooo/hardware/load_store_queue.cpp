@@ -0,0 +1,133 @@
+#include "vm/ooo/hardware/load_store_queue.h"
+
+namespace ooo
+{
+
+namespace{
+
+// seq wraps around, in flight instrs are never 2^31 apart
+bool OlderThan(uint32_t seq, uint32_t other_seq){
+    return static_cast<int32_t>(seq - other_seq) < 0;
+}
+
+} // namespace
+
+
+LoadStoreQueue::LoadStoreQueue() : LoadStoreQueue(kDefaultSize, kDefaultSize){}
+
+LoadStoreQueue::LoadStoreQueue(size_t load_slots, size_t store_slots) : load_slots_{load_slots}, store_slots_{store_slots},
+    loads_(load_slots), stores_(store_slots){}
+
+bool LoadStoreQueue::HasSlot(const OooInstrContext& instr) const{
+    if(instr.mem_read)
+        return loads_.Size()<load_slots_;
+    if(instr.mem_write)
+        return stores_.Size()<store_slots_;
+    return true;
+}
+
+void LoadStoreQueue::Push(const OooInstrContext& instr){
+    Entry entry;
+    entry.seq = instr.seq;
+    entry.bytes = instr.mem_access_bytes;
+
+    if(instr.mem_read)
+        loads_.PushBack(entry);
+    else if(instr.mem_write)
+        stores_.PushBack(entry);
+}
+
+uint64_t LoadStoreQueue::EffectiveAddress(const OooInstrContext& instr){
+    return instr.rs1_value + static_cast<uint64_t>(static_cast<int64_t>(instr.immediate));
+}
+
+const LoadStoreQueue::Entry* LoadStoreQueue::YoungestOverlap(uint32_t load_seq, uint64_t address, uint8_t bytes) const{
+    for(size_t i=stores_.Size();i-->0;){
+        const Entry& store = stores_[i];
+        if(!OlderThan(store.seq, load_seq))
+            continue;
+
+        if(store.address < address + bytes && address < store.address + store.bytes)
+            return &store;
+    }
+    return nullptr;
+}
+
+bool LoadStoreQueue::LoadMayIssue(const OooInstrContext& load) const{
+    for(const Entry& store : stores_){
+        if(!OlderThan(store.seq, load.seq))
+            break;
+        if(!store.addr_known)
+            return false;
+    }
+
+    uint64_t address = EffectiveAddress(load);
+    const Entry* store = YoungestOverlap(load.seq, address, load.mem_access_bytes);
+    return store==nullptr || (store->data_known && store->address<=address
+                              && address + load.mem_access_bytes<=store->address + store->bytes);
+}
+
+void LoadStoreQueue::ResolveStoreAddress(const OooInstrContext& store){
+    for(Entry& entry : stores_){
+        if(entry.seq!=store.seq)
+            continue;
+
+        entry.addr_known = true;
+        entry.address = EffectiveAddress(store);
+        return;
+    }
+}
+
+void LoadStoreQueue::ResolveStore(const OooInstrContext& store, uint64_t data){
+    for(Entry& entry : stores_){
+        if(entry.seq!=store.seq)
+            continue;
+
+        entry.addr_known = true;
+        entry.address = store.alu_out;
+        entry.data_known = true;
+        entry.data = data;
+        return;
+    }
+}
+
+bool LoadStoreQueue::Forward(const OooInstrContext& load, uint64_t& value) const{
+    const Entry* store = YoungestOverlap(load.seq, load.alu_out, load.mem_access_bytes);
+    if(store==nullptr)
+        return false;
+
+    // LoadMayIssue() made sure the store holds every byte of the load
+    value = store->data >> (8 * (load.alu_out - store->address));
+    if(load.mem_access_bytes<8)
+        value &= (uint64_t{1} << (8 * load.mem_access_bytes)) - 1;
+    return true;
+}
+
+void LoadStoreQueue::Retire(const OooInstrContext& instr){
+    FixedQueue<Entry>& queue = instr.mem_read ? loads_ : stores_;
+    if(!queue.Empty() && queue.Front().seq==instr.seq)
+        queue.PopFront();
+}
+
+void LoadStoreQueue::SquashYoungerThan(uint32_t seq){
+    while(!loads_.Empty() && OlderThan(seq, loads_.Back().seq))
+        loads_.PopBack();
+    while(!stores_.Empty() && OlderThan(seq, stores_.Back().seq))
+        stores_.PopBack();
+}
+
+void LoadStoreQueue::Reset(){
+    loads_.Clear();
+    stores_.Clear();
+}
+
+const FixedQueue<LoadStoreQueue::Entry>& LoadStoreQueue::GetLoads() const{
+    return loads_;
+}
+
+const FixedQueue<LoadStoreQueue::Entry>& LoadStoreQueue::GetStores() const{
+    return stores_;
+}
+
+
+} // namespace ooo
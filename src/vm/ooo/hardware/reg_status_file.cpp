@@ -1,6 +1,6 @@
-#include "vm/dual_issue/hardware/reg_status_file.h"
+#include "vm/ooo/hardware/reg_status_file.h"
 
-namespace dual_issue
+namespace ooo
 {
 
 TagFile::TagFile() {
@@ -109,4 +109,4 @@ void RegisterStatusFile::Reset(){
     tag_file_.Reset();
 }
 
-} // namespace dual_issue
+} // namespace ooo
@@ -1,11 +1,13 @@
-#include "vm/dual_issue/hardware/reservation_station.h"
-#include "vm/dual_issue/core/core.h"
-#include "vm/triple_issue/core/core.h"
+#include "vm/ooo/hardware/reservation_station.h"
+#include "vm/ooo/core/core.h"
+#include <algorithm>
 
-namespace dual_issue
+namespace ooo
 {
 
-ReservationStation::ReservationStation() : que_(max_size_){
+ReservationStation::ReservationStation() : ReservationStation(kDefaultSize){}
+
+ReservationStation::ReservationStation(size_t slots) : max_size_{slots}, que_(slots){
     Reset();
 }
 
@@ -20,6 +22,10 @@ size_t ReservationStation::EmptySlots(){
     return empty_slots;
 }
 
+bool ReservationStation::Empty(){
+    return EmptySlots()==max_size_;
+}
+
 void ReservationStation::ListenToBroadCast(CommonDataBus& data_bus){
 
     for(auto& broadcast_msg : data_bus.broadcast_msgs){
@@ -61,13 +67,11 @@ void ReservationStation::ListenToBroadCast(CommonDataBus& data_bus){
 }
 
 
-void ReservationStation::Push(DualIssueInstrContext instr, DualIssueCore& vm_core){
+void ReservationStation::Push(OooInstrContext instr, OooCore& vm_core){
     instr.wait_for_rs1 = true;
     instr.wait_for_rs2 = true;
     instr.wait_for_rs3 = true;
 
-    auto* upcasted_triple = dynamic_cast<triple_issue::TripleIssueCore*>(&vm_core);
-
     if(instr.uses_rs1){
         auto [dependency, dependent_idx] = vm_core.reg_status_file_.QueryTableRobIdx(instr.rs1, !instr.rs1_from_fprf);
 
@@ -75,7 +79,7 @@ void ReservationStation::Push(DualIssueInstrContext instr, DualIssueCore& vm_cor
             instr.wait_for_rs1 = false;
         }
         else{
-            auto [value_ready, value, epoch] = (upcasted_triple) ? upcasted_triple->commit_buffer_.QueryVal(dependent_idx) : vm_core.commit_buffer_.QueryVal(dependent_idx);
+            auto [value_ready, value, epoch] = vm_core.commit_buffer_.QueryVal(dependent_idx);
 
             if(value_ready){
                 instr.wait_for_rs1 = false;
@@ -102,7 +106,7 @@ void ReservationStation::Push(DualIssueInstrContext instr, DualIssueCore& vm_cor
             instr.wait_for_rs2 = false;
         }
         else{
-            auto [value_ready, value, epoch] = (upcasted_triple) ? upcasted_triple->commit_buffer_.QueryVal(dependent_idx) : vm_core.commit_buffer_.QueryVal(dependent_idx);
+            auto [value_ready, value, epoch] = vm_core.commit_buffer_.QueryVal(dependent_idx);
 
             if(value_ready){
                 instr.wait_for_rs2 = false;
@@ -129,7 +133,7 @@ void ReservationStation::Push(DualIssueInstrContext instr, DualIssueCore& vm_cor
             instr.wait_for_rs3 = false;
         }
         else{
-            auto [value_ready, val, epoch] = (upcasted_triple) ? upcasted_triple->commit_buffer_.QueryVal(dependent_idx) : vm_core.commit_buffer_.QueryVal(dependent_idx);
+            auto [value_ready, val, epoch] = vm_core.commit_buffer_.QueryVal(dependent_idx);
 
             if(value_ready){
                 instr.wait_for_rs3 = false;
@@ -162,79 +166,69 @@ void ReservationStation::Push(DualIssueInstrContext instr, DualIssueCore& vm_cor
 }
 
 
-DualIssueInstrContext ReservationStation::GetReadyInstr(){
-    if(que_.empty()){
-        DualIssueInstrContext t;
-        t.illegal = true;
-        return t;
-    }
+OooInstrContext ReservationStation::Take(size_t idx){
+    OooInstrContext instr = que_[idx];
+    std::copy(que_.begin() + idx + 1, que_.end(), que_.begin() + idx);
 
-    for(int i=0;i<static_cast<int>(que_.size());i++){
-        if(que_[i].ready_to_exec && !que_[i].illegal){
-            DualIssueInstrContext instr = que_[i];
+    que_.back().illegal = true;
+    que_.back().ready_to_exec = false;
 
-            std::deque<DualIssueInstrContext> new_que_;
-            for(int j=0;j<static_cast<int>(que_.size());j++){
-                if(j==i)
-                    continue;
-                new_que_.push_back(que_[j]);
-            }
+    return instr;
+}
 
-            DualIssueInstrContext t;
-            t.illegal = true;
-            t.ready_to_exec = false;
-            new_que_.push_back(t);
 
-            que_ = new_que_;
-            return instr;
+OooInstrContext ReservationStation::GetReadyInstr(){
+    for(size_t i=0;i<que_.size();i++){
+        if(que_[i].ready_to_exec && !que_[i].illegal){
+            return Take(i);
         }
     }
 
-    DualIssueInstrContext t;
+    OooInstrContext t;
     t.illegal = true;
     return t;
 }
 
-DualIssueInstrContext ReservationStation::GetInorderInstr(){
-    if(que_.empty()){
-        DualIssueInstrContext t;
-        t.illegal = true;
-        return t;
-    }
-
-    if(que_[0].ready_to_exec && !que_[0].illegal){
-        DualIssueInstrContext instr = que_[0];
-        que_.pop_front();
-
-        DualIssueInstrContext t;
-        t.illegal = true;
-        t.ready_to_exec = false;
-        que_.push_back(t);
-
-        return instr;
+OooInstrContext ReservationStation::GetReadyMemInstr(const LoadStoreQueue& lsq){
+    for(size_t i=0;i<que_.size();i++){
+        if(que_[i].ready_to_exec && !que_[i].illegal && (!que_[i].mem_read || lsq.LoadMayIssue(que_[i]))){
+            return Take(i);
+        }
     }
 
-    DualIssueInstrContext t;
+    OooInstrContext t;
     t.illegal = true;
     return t;
 }
 
 
-void ReservationStation::Reset(){
-    for(auto& p : que_){
-        p.illegal = true;
+void ReservationStation::ResolveStoreAddresses(LoadStoreQueue& lsq){
+    for(auto& instr : que_){
+        if(instr.illegal || !instr.mem_write || instr.wait_for_rs1 || instr.store_addr_done)
+            continue;
+
+        lsq.ResolveStoreAddress(instr);
+        instr.store_addr_done = true;
     }
 }
 
-std::vector<std::unique_ptr<const InstrContext>> ReservationStation::GetQue(){
-    std::vector<std::unique_ptr<const InstrContext>> ret;
 
+void ReservationStation::Squash(ReorderBuffer& commit_buffer){
+    for(auto& instr : que_){
+        if(!commit_buffer.Holds(instr))
+            instr.illegal = true;
+    }
+}
+
+void ReservationStation::Reset(){
     for(auto& p : que_){
-        ret.push_back(std::make_unique<const DualIssueInstrContext>(p));
+        p.illegal = true;
     }
+}
 
-    return ret;
+const std::vector<OooInstrContext>& ReservationStation::GetQue() const{
+    return que_;
 }
 
 
-} // namespace dual_issue
\ No newline at end of file
+} // namespace ooo
\ No newline at end of file
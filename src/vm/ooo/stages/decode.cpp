@@ -0,0 +1,32 @@
+#include "vm/ooo/stages/stages.h"
+#include "common/instructions.h"
+
+namespace ooo
+{
+
+using instruction_set::Instruction;
+using instruction_set::get_instr_encoding;
+
+void OooStages::Decode(OooCore& vm_core){
+    for(OooInstrContext& instr : vm_core.if_id_){
+        if(instr.illegal)
+            continue;
+
+        vm_core.decode_unit_.DecodeInstruction(instr, vm_core.memory_controller_.GetPredecodeTable());
+        vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Decode, instr.seq, instr.pc);
+
+        if (instr.opcode == get_instr_encoding(Instruction::kecall).opcode &&
+            instr.funct3 == get_instr_encoding(Instruction::kecall).funct3) {
+            HandleSyscall(vm_core);
+            return;
+        }
+    }
+}
+
+void OooStages::HandleSyscall(OooCore& vm_core){
+    vm_core.Log() << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
+    return;
+}
+
+
+} // namespace ooo
@@ -0,0 +1,237 @@
+#include "vm/ooo/stages/stages.h"
+#include "common/instructions.h"
+
+
+namespace ooo
+{
+
+
+void OooStages::Execute(OooCore::FunctionalUnit& fu, OooCore& vm_core){
+    OooInstrContext& ex_instruction = fu.exec;
+    if(ex_instruction.illegal){
+        return;
+    }
+    vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Execute, ex_instruction.seq, ex_instruction.pc);
+
+    switch(fu.kind){
+        case FuKind::kAlu: ExecuteAlu(ex_instruction, vm_core); break;
+        case FuKind::kFpu: ExecuteFpu(ex_instruction, vm_core); break;
+        case FuKind::kLsu: MemoryAccess(ex_instruction, vm_core); break;
+        default: break;
+    }
+
+	// we don't update the pc here. we do that in the writeback stage
+	// "what an earlier branch to this was stalled and this executed earlier?"
+}
+
+
+void OooStages::ExecuteAlu(OooInstrContext& ex_instruction, OooCore& vm_core){
+	if (instruction_set::isFInstruction(ex_instruction.instruction)) { // RV64 F
+		ExecuteFloat(ex_instruction, vm_core);
+	}
+	else if (instruction_set::isDInstruction(ex_instruction.instruction)) {
+		ExecuteDouble(ex_instruction, vm_core);
+	}
+	else {
+		ExecuteBasic(ex_instruction, vm_core);
+	}
+}
+
+
+void OooStages::ExecuteFpu(OooInstrContext& ex_instruction, OooCore& vm_core){
+	if (instruction_set::isFInstruction(ex_instruction.instruction)) { // RV64 F
+		ExecuteFloat(ex_instruction, vm_core);
+	}
+	else if (instruction_set::isDInstruction(ex_instruction.instruction)) {
+		ExecuteDouble(ex_instruction, vm_core);
+	}
+}
+
+
+
+void OooStages::ExecuteBasic(OooInstrContext& ex_instruction, OooCore& vm_core){
+	// register values might change (if imm_to_alu is true etc), so not by reference
+	uint64_t reg1_value = ex_instruction.rs1_value;
+	uint64_t reg2_value = ex_instruction.rs2_value;
+	
+	if (ex_instruction.imm_to_alu) {
+		int32_t imm = ex_instruction.immediate;
+    	reg2_value = static_cast<uint64_t>(static_cast<int64_t>(imm));
+  	}
+
+	if(ex_instruction.auipc){
+		reg1_value = ex_instruction.pc;
+	}
+
+  	// std::tie(ex_instruction.alu_out, ex_instruction.alu_overflow) = alu_.execute(ex_instruction.alu_op, reg1_value, reg2_value);
+	auto [alu_out_temp, alu_overflow_temp] = vm_core.alu_.execute(ex_instruction.alu_op, reg1_value, reg2_value);
+	ex_instruction.alu_out = alu_out_temp;
+	ex_instruction.alu_overflow = alu_overflow_temp;
+
+	LinkJump(ex_instruction);
+}
+
+
+void OooStages::LinkJump(OooInstrContext& instr){
+    using instruction_set::Instruction;
+    using instruction_set::get_instr_encoding;
+
+	if (instr.opcode==get_instr_encoding(Instruction::kjal).opcode) {
+		instr.branch_target = instr.pc + instr.immediate;
+	}
+	else if (instr.opcode==get_instr_encoding(Instruction::kjalr).opcode) {
+		instr.branch_target = instr.alu_out;
+	}
+	else {
+		return;
+	}
+	instr.alu_out = instr.pc + 4;
+}
+
+
+void OooStages::ExecuteFloat(OooInstrContext& ex_instruction, OooCore& vm_core){
+	uint8_t& funct3 = ex_instruction.funct3;
+	uint8_t rm = funct3;
+
+	uint8_t fcsr_status = 0;
+
+	int32_t imm = ex_instruction.immediate;
+
+	if (rm==0b111) {
+		rm = vm_core.register_file_.ReadCsr(0x002);
+	}
+
+	uint64_t reg1_value = (ex_instruction.rs1_from_fprf) ? ex_instruction.frs1_value : ex_instruction.rs1_value;
+	uint64_t reg2_value = ex_instruction.frs2_value;
+	uint64_t reg3_value = ex_instruction.frs3_value;
+
+
+	if (ex_instruction.imm_to_alu) {
+		reg2_value = static_cast<uint64_t>(static_cast<int64_t>(imm));
+	}
+
+	alu::AluOp aluOperation = ex_instruction.alu_op;
+	// std::tie(execution_result_, fcsr_status) = alu::Alu::fpexecute(aluOperation, reg1_value, reg2_value, reg3_value, rm);
+	auto [alu_out_temp, fcsr_status_temp] = alu::Alu::fpexecute(aluOperation, reg1_value, reg2_value, reg3_value, rm);
+	ex_instruction.alu_out = alu_out_temp;
+	fcsr_status = fcsr_status_temp;
+
+	ex_instruction.fcsr_update = true;
+	ex_instruction.fcsr_status = fcsr_status;
+}
+
+
+void OooStages::ExecuteDouble(OooInstrContext& ex_instruction, OooCore& vm_core){
+	uint8_t& opcode = ex_instruction.opcode;
+	uint8_t& funct3 = ex_instruction.funct3;
+	uint8_t& funct7 = ex_instruction.funct7;
+	uint8_t rm = funct3;
+
+	// WHAT? : this fcsr_status is not used? Same as ExecuteFloat() i suppose
+	uint8_t fcsr_status = 0;
+
+	int32_t imm = ex_instruction.immediate;
+
+	if (rm==0b111) {
+		rm = vm_core.register_file_.ReadCsr(0x002);
+	}
+
+	uint64_t reg1_value = ex_instruction.frs1_value;
+	uint64_t reg2_value = ex_instruction.frs2_value;
+	uint64_t reg3_value = ex_instruction.frs3_value;
+
+	if (funct7==0b1101001 || funct7==0b1111001 || opcode==0b0000111 || opcode==0b0100111) {
+		reg1_value = ex_instruction.rs1_value;
+	}
+
+	if (ex_instruction.imm_to_alu) {
+		reg2_value = static_cast<uint64_t>(static_cast<int64_t>(imm));
+	}
+
+	alu::AluOp aluOperation = ex_instruction.alu_op;
+	// std::tie(execution_result_, fcsr_status) = alu::Alu::dfpexecute(aluOperation, reg1_value, reg2_value, reg3_value, rm);
+	auto [alu_out_temp, fcsr_status_temp] = alu::Alu::dfpexecute(aluOperation, reg1_value, reg2_value, reg3_value, rm);
+	ex_instruction.alu_out = alu_out_temp;
+	fcsr_status = fcsr_status_temp;
+
+	// WHAT?: what is this
+	ex_instruction.fcsr_update = true;
+	ex_instruction.fcsr_status = fcsr_status;
+}
+
+
+void OooStages::ResolveBranch(OooInstrContext& instr, OooCore& vm_core){
+    using instruction_set::Instruction;
+    using instruction_set::get_instr_encoding;
+
+	uint8_t& opcode = instr.opcode;
+	uint8_t& funct3 = instr.funct3;
+
+	bool branch_flag = false;
+	uint64_t target = instr.pc + instr.immediate;
+
+	if (opcode==get_instr_encoding(Instruction::kjalr).opcode || 
+			opcode==get_instr_encoding(Instruction::kjal).opcode) {
+		// the target was moved out of alu_out in execute (LinkJump), alu_out is the return address now
+		branch_flag = true;
+		target = instr.branch_target;
+	}
+	else if (opcode==get_instr_encoding(Instruction::kbeq).opcode ||
+				opcode==get_instr_encoding(Instruction::kbne).opcode ||
+				opcode==get_instr_encoding(Instruction::kblt).opcode ||
+				opcode==get_instr_encoding(Instruction::kbge).opcode ||
+				opcode==get_instr_encoding(Instruction::kbltu).opcode ||
+				opcode==get_instr_encoding(Instruction::kbgeu).opcode) {
+		
+		switch (funct3) {
+			case 0b000: {// BEQ
+				branch_flag = (instr.alu_out==0);
+				break;
+			}
+			case 0b001: {// BNE
+				branch_flag = (instr.alu_out!=0);
+				break;
+			}
+			case 0b100: {// BLT
+				branch_flag = (instr.alu_out==1);
+				break;
+			}
+			case 0b101: {// BGE
+				branch_flag = (instr.alu_out==0);
+				break;
+			}
+			case 0b110: {// BLTU
+				branch_flag = (instr.alu_out==1);
+				break;
+			}
+			case 0b111: {// BGEU
+				branch_flag = (instr.alu_out==0);
+				break;
+			}
+		}
+	}
+	else {
+		return;
+	}
+
+	instr.branch_taken = branch_flag;
+	instr.branch_target = target;
+
+	// the fetch went on at the predicted target, a taken branch also needs that target to be right
+	instr.branch_mispredicted = branch_flag!=instr.branch_predicted_taken
+		|| (branch_flag && instr.branch_prediction.target!=target);
+	if(!instr.branch_mispredicted)
+		return;
+
+	// everything behind the branch is on the wrong path, older instrs may still be in flight
+	vm_core.SquashYoungerThan(instr);
+
+	if(vm_core.branch_prediction_enabled_){
+		vm_core.branch_predictor_.Recover(instr.pc, instr.instruction, instr.branch_prediction);
+	}
+
+	vm_core.SetProgramCounter(branch_flag ? target : instr.pc + 4);
+}
+
+
+} // namespace ooo
@@ -0,0 +1,50 @@
+#include "vm/ooo/stages/stages.h"
+
+namespace ooo
+{
+
+// fetches the instruction at pc and moves pc to where the next one comes from
+OooInstrContext fetch_next(OooCore& vm_core){
+    OooInstrContext instr;
+    instr.pc = vm_core.pc;
+    instr.seq = vm_core.next_seq_++;
+    instr.instruction = vm_core.memory_controller_.FetchWord(vm_core.pc);
+
+    if(instr.pc>=vm_core.program_size_){
+        instr.illegal = true;
+    }
+    else{
+        vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Fetch, instr.seq, instr.pc);
+    }
+
+    if(vm_core.branch_prediction_enabled_ && !instr.illegal){
+        instr.branch_prediction = vm_core.branch_predictor_.Predict(instr.pc, instr.instruction);
+        instr.branch_predicted_taken = instr.branch_prediction.taken;
+        vm_core.SetProgramCounter(instr.branch_prediction.target);
+    }
+    else{
+        vm_core.AddToProgramCounter(4);
+    }
+
+    return instr;
+}
+
+
+void OooStages::Fetch(OooCore& vm_core, size_t num_fetch){
+    std::vector<OooInstrContext>& if_id = vm_core.if_id_;
+
+    // the fetch group ends at a predicted taken branch
+    bool group_ended = false;
+    for(size_t i=if_id.size()-num_fetch;i<if_id.size();i++){
+        if(group_ended){
+            if_id[i] = OooInstrContext{};
+            if_id[i].illegal = true;
+            continue;
+        }
+
+        if_id[i] = fetch_next(vm_core);
+        group_ended = if_id[i].branch_predicted_taken;
+    }
+}
+
+} // namespace ooo
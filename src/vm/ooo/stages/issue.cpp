@@ -0,0 +1,52 @@
+#include "vm/ooo/stages/stages.h"
+
+
+namespace ooo
+{
+
+// pushes instr into its reservation station (and a memory op into the load/store queue), false if the station, the
+// ROB or the load/store queue is full
+bool issue_single(OooInstrContext& instr, OooCore& vm_core){
+    if(instr.illegal)
+        return true;
+
+    ReservationStation& station = vm_core.StationFor(instr);
+    if(station.EmptySlots()==0 || vm_core.commit_buffer_.EmptySlots()==0 || !vm_core.load_store_queue_.HasSlot(instr))
+        return false;
+
+    // FIXME: Register values should be read in the decode stage
+    /**
+     * I don't know how to avoid this. (without making extra "physical" registers)
+     * When an instruction is stalled in the id-issue pipeline when a dependent instruction is commited,
+     * the instruction contains the stale register value. As the dependent instruction is popped from the ROB,
+     * this instruction doesn't see the dependency and is statisfied with the stale value (incorrect).
+     */
+    vm_core.decode_unit_.SetRegValues(instr, vm_core.register_file_);
+
+    auto [rob_idx, epoch] = vm_core.commit_buffer_.Reserve(instr);
+    instr.rob_idx = rob_idx;
+    instr.epoch = epoch;
+
+    station.Push(instr, vm_core);
+    vm_core.load_store_queue_.Push(instr);
+    vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Issue, instr.seq, instr.pc);
+    return true;
+}
+
+size_t OooStages::Issue(OooCore& vm_core){
+    std::vector<OooInstrContext>& id_issue = vm_core.id_issue_;
+
+    size_t num_issued = 0;
+    while(num_issued<id_issue.size() && issue_single(id_issue[num_issued], vm_core)){
+        num_issued++;
+    }
+
+    for(size_t i=num_issued;i<id_issue.size();i++){
+        id_issue[i-num_issued] = id_issue[i];
+    }
+
+    return num_issued;
+}
+
+
+} // namespace ooo
@@ -1,8 +1,8 @@
-#include "vm/dual_issue/stages/stages.h"
+#include "vm/ooo/stages/stages.h"
 
-namespace dual_issue{
+namespace ooo{
 
-void exec_mini_alu(DualIssueInstrContext& mem_instruction, DualIssueCore& vm_core){
+void exec_mini_alu(OooInstrContext& mem_instruction, OooCore& vm_core){
 	uint64_t reg1_value = mem_instruction.rs1_value;
 	uint64_t reg2_value = mem_instruction.rs2_value;
 	
@@ -22,11 +22,12 @@ void exec_mini_alu(DualIssueInstrContext& mem_instruction, DualIssueCore& vm_cor
 }
 
 
-void DualIssueStages::MemoryAccess(DualIssueCore& vm_core){
-    DualIssueInstrContext& mem_instruction = vm_core.pipeline_reg_instrs_.rsrvstn_lsu;
-	if(mem_instruction.illegal)
-		return;
+uint64_t OooStages::StoreData(const OooInstrContext& store){
+	return store.mem_write_data_from_gpr ? store.rs2_value : store.frs2_value;
+}
+
 
+void OooStages::MemoryAccess(OooInstrContext& mem_instruction, OooCore& vm_core){
 	if(!mem_instruction.mem_read && !mem_instruction.mem_write) return;
 
 
@@ -49,10 +50,11 @@ void DualIssueStages::MemoryAccess(DualIssueCore& vm_core){
 	if (mem_instruction.mem_read) {
 		uint64_t& mem_out = mem_instruction.mem_out;
 		uint64_t& address = mem_instruction.alu_out;
-		mem_out = 0;
-
-		for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-			mem_out += vm_core.memory_controller_.ReadByte(address+i) << (i*8);
+		if(vm_core.load_store_queue_.Forward(mem_instruction, mem_out)){
+			vm_core.core_stats_.store_forwards++;
+		}
+		else{
+			mem_out = vm_core.memory_controller_.ReadData(address, mem_instruction.mem_access_bytes);
 		}
 		
 		if(mem_instruction.sign_extend){
@@ -62,23 +64,10 @@ void DualIssueStages::MemoryAccess(DualIssueCore& vm_core){
 		return;
 	}
 
+	// the store goes into the store queue, memory is written when it commits
 	if (mem_instruction.mem_write) {
-		uint64_t& address = mem_instruction.alu_out;
-
-		uint64_t write_data = (mem_instruction.mem_write_data_from_gpr) ? 
-			mem_instruction.rs2_value :
-			mem_instruction.frs2_value;
-					
-		if(vm_core.debug_mode_){
-			for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-				mem_instruction.mem_overwritten.push_back(vm_core.memory_controller_.ReadByte(address+i));
-			}
-		}
-
-		for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-			vm_core.memory_controller_.WriteByte(address + i, 0xFF & (write_data >> (i*8)));
-		}
+		vm_core.load_store_queue_.ResolveStore(mem_instruction, OooStages::StoreData(mem_instruction));
 	}
 }
 
-} // namespace rv5s
\ No newline at end of file
+} // namespace ooo
@@ -0,0 +1,144 @@
+#include "vm/ooo/stages/stages.h"
+#include "common/instructions.h"
+
+namespace ooo{
+
+void OooStages::WriteBack(OooInstrContext& wb_instruction, OooCore& vm_core){
+	if(wb_instruction.illegal)
+		return;
+
+	vm_core.core_stats_.instrs_retired++;
+	vm_core.core_stats_.top_down.retiring++;
+	vm_core.trace_.Record(vm_core.core_stats_.cycles, pipeline_trace::Stage::Commit, wb_instruction.seq, wb_instruction.pc);
+	vm_core.profile_.Retire(wb_instruction.pc);
+	if(vm_core.debug_mode_){
+		vm_core.undo_instruction_stack_.Push(wb_instruction);
+	}
+
+	if(wb_instruction.mem_read || wb_instruction.mem_write){
+		vm_core.load_store_queue_.Retire(wb_instruction);
+	}
+
+	if(wb_instruction.mem_write){
+		uint64_t& address = wb_instruction.alu_out;
+		if(vm_core.debug_mode_){
+			vm_core.undo_records_[wb_instruction.seq].mem_overwritten = vm_core.memory_controller_.ReadSized(address, wb_instruction.mem_access_bytes);
+		}
+		vm_core.memory_controller_.WriteData(address, wb_instruction.mem_access_bytes, StoreData(wb_instruction));
+		return;
+	}
+	
+	if (wb_instruction.opcode==0b1110011) { // CSR opcode
+		WriteBackCsr(wb_instruction, vm_core);
+		return;
+	}
+
+	// fcsr update
+	if(wb_instruction.fcsr_update){
+		if(vm_core.debug_mode_){
+			vm_core.undo_records_[wb_instruction.seq].fcsr_overwritten = vm_core.register_file_.ReadCsr(0x003);
+		}
+		vm_core.register_file_.WriteCsr(0x003, wb_instruction.fcsr_status);
+	}
+
+	if(wb_instruction.branch)
+		CommitBranch(wb_instruction, vm_core);
+
+	if(!wb_instruction.reg_write) return;
+
+	uint64_t& write_data = wb_instruction.mem_to_reg ?
+		wb_instruction.mem_out : 
+		wb_instruction.alu_out;
+		
+	if(wb_instruction.reg_write_to_fpr){
+		if(vm_core.debug_mode_){
+			vm_core.undo_records_[wb_instruction.seq].reg_overwritten = vm_core.register_file_.ReadFpr(wb_instruction.rd);
+		}
+		vm_core.register_file_.WriteFpr(wb_instruction.rd, write_data);
+	}
+	else{
+		if(vm_core.debug_mode_){
+			vm_core.undo_records_[wb_instruction.seq].reg_overwritten = vm_core.register_file_.ReadGpr(wb_instruction.rd);
+		}
+		vm_core.register_file_.WriteGpr(wb_instruction.rd, write_data);
+	}
+}
+
+void OooStages::CommitBranch(OooInstrContext& instr, OooCore& vm_core){
+	vm_core.core_stats_.branch_instrs++;
+
+	if(vm_core.branch_prediction_enabled_){
+		vm_core.branch_predictor_.Update(instr.pc, instr.instruction, instr.branch_taken, instr.branch_target, instr.branch_prediction);
+	}
+
+	// the younger instrs were squashed when it executed
+	if(instr.branch_mispredicted){
+		vm_core.core_stats_.branch_mispredicts++;
+		vm_core.core_stats_.mispredicts.Count(instr.branch_prediction.component);
+		vm_core.profile_.Mispredict(instr.pc);
+	}
+}
+
+
+void OooStages::WriteBackCsr(OooInstrContext& wb_instruction, OooCore& vm_core){
+    using instruction_set::get_instr_encoding;
+    using instruction_set::Instruction;
+
+	uint8_t& rd = wb_instruction.rd;
+	uint8_t& funct3 = wb_instruction.funct3;
+
+	uint16_t& csr_target_address_ = wb_instruction.csr_rd;
+	uint64_t& csr_old_value_ = wb_instruction.csr_value;
+	uint64_t& csr_write_val_ = wb_instruction.csr_write_val;
+	uint8_t& csr_uimm_ = wb_instruction.csr_uimm;
+
+	if(vm_core.debug_mode_){
+		UndoRecord& undo_record = vm_core.undo_records_[wb_instruction.seq];
+		undo_record.is_csr_overwritten = true;
+		undo_record.csr_overwritten = csr_old_value_;
+		undo_record.reg_overwritten = vm_core.register_file_.ReadGpr(rd);
+	}
+
+	switch (funct3) {
+		case get_instr_encoding(Instruction::kcsrrw).funct3: { // CSRRW
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			vm_core.register_file_.WriteCsr(csr_target_address_, csr_write_val_);
+			break;
+		}
+		case get_instr_encoding(Instruction::kcsrrs).funct3: { // CSRRS
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			if (csr_write_val_!=0) {
+				vm_core.register_file_.WriteCsr(csr_target_address_, csr_old_value_ | csr_write_val_);
+			}
+			break;
+		}
+		case get_instr_encoding(Instruction::kcsrrc).funct3: { // CSRRC
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			if (csr_write_val_!=0) {
+				vm_core.register_file_.WriteCsr(csr_target_address_, csr_old_value_ & ~csr_write_val_);
+			}
+			break;
+		}
+		case get_instr_encoding(Instruction::kcsrrwi).funct3: { // CSRRWI
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			vm_core.register_file_.WriteCsr(csr_target_address_, csr_uimm_);
+			break;
+		}
+		case get_instr_encoding(Instruction::kcsrrsi).funct3: { // CSRRSI
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			if (csr_uimm_!=0) {
+				vm_core.register_file_.WriteCsr(csr_target_address_, csr_old_value_ | csr_uimm_);
+			}
+			break;
+		}
+		case get_instr_encoding(Instruction::kcsrrci).funct3: { // CSRRCI
+			vm_core.register_file_.WriteGpr(rd, csr_old_value_);
+			if (csr_uimm_!=0) {
+				vm_core.register_file_.WriteCsr(csr_target_address_, csr_old_value_ & ~csr_uimm_);
+			}
+			break;
+		}
+	}
+}
+
+} // namespace rv5s
\ No newline at end of file
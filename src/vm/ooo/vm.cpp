@@ -0,0 +1,171 @@
+#include "vm/ooo/vm.h"
+
+
+namespace ooo
+{
+
+OooVM::OooVM(const OooCore::Shape& shape, const vm_config::VmConfig& config) : vm_core_(shape) {
+    vm_core_.config_ = config;
+    LoadVM();
+}
+
+
+void OooVM::Reset(){
+    BumpGeneration();
+    vm_core_.Reset();
+}
+
+
+void OooVM::LoadVM(){
+    BumpGeneration();
+    vm_core_.Load();
+}
+
+void OooVM::LoadVM(AssembledProgram program){
+    BumpGeneration();
+    program_ = program;
+    vm_core_.Load(program);
+}
+
+
+void OooVM::Run(){
+    BumpGeneration();
+    host_profile::RunTimer run_timer(vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired);
+    OooExecutor::RunOoo(vm_core_);
+    vm_core_.trace_.Flush();
+    run_timer.Stop(vm_core_.host_profile_, vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired, vm_core_.Log());
+}
+
+void OooVM::Step(){
+    BumpGeneration();
+    OooExecutor::StepOoo(vm_core_);
+}
+
+void OooVM::DebugRun(){
+    BumpGeneration();
+    OooExecutor::DebugRunOoo(vm_core_, [this] { return AfterDebugStep(vm_core_.config_.getRunStepDelay()); });
+    vm_core_.trace_.Flush();
+}
+
+void OooVM::Undo(){
+    BumpGeneration();
+    OooExecutor::UndoOoo(vm_core_);
+}
+
+void OooVM::SetBreakpoints(const std::vector<uint64_t>& pcs){
+    vm_core_.breakpoints_ = pcs;
+}
+
+void OooVM::RequestStop(){
+    vm_core_.stop_requested_ = true;
+}
+
+void OooVM::ClearStop(){
+    vm_core_.ClearStop();
+}
+
+bool OooVM::ProgramEnded(){
+    return vm_core_.ProgramEnded();
+}
+
+uint64_t OooVM::FastForward(uint64_t num_instrs){
+    BumpGeneration();
+    return OooExecutor::FastForwardOoo(vm_core_, num_instrs);
+}
+
+
+uint64_t OooVM::ReadMemDoubleWord(uint64_t address){
+    return vm_core_.memory_controller_.ReadDoubleWord(address);
+}
+
+const std::array<uint64_t, 32>& OooVM::GetGprValues(){
+    return vm_core_.register_file_.GetGprValues();
+}
+const std::array<uint64_t, 32>& OooVM::GetFprValues(){
+    return vm_core_.register_file_.GetFprValues();
+}
+
+
+// the pcs in flight, youngest first like the in order models: if_id_, id_issue_, then the finished ROB entries
+// from tail to head
+std::vector<uint64_t> OooVM::GetInstructionPCs(){
+    std::vector<uint64_t> pcs;
+    for(auto it=vm_core_.if_id_.rbegin();it!=vm_core_.if_id_.rend();it++){
+        if(!it->illegal)
+            pcs.push_back(it->pc);
+    }
+    for(auto it=vm_core_.id_issue_.rbegin();it!=vm_core_.id_issue_.rend();it++){
+        if(!it->illegal)
+            pcs.push_back(it->pc);
+    }
+
+    const auto& entries = vm_core_.commit_buffer_.GetEntries();
+    auto [head, tail] = vm_core_.commit_buffer_.GetHeadTail();
+    for(size_t idx=tail;idx!=head;){
+        idx = (idx + entries.size() - 1) % entries.size();
+        if(entries[idx].ready_to_commit)
+            pcs.push_back(entries[idx].instr.pc);
+    }
+
+    if(pcs.empty())
+        pcs.push_back(vm_core_.pc);
+    return pcs;
+}
+void OooVM::FillPipelineSnapshot(PipelineSnapshot& snapshot){
+    using Section = PipelineSnapshot::Section;
+    // the latches row by row, then the functional units: what each one executes, then what it puts on the CDB
+    for(const auto& instr : vm_core_.if_id_){
+        snapshot.Push(Section::kPipeline, instr);
+    }
+    for(const auto& instr : vm_core_.id_issue_){
+        snapshot.Push(Section::kPipeline, instr);
+    }
+    for(const auto& fu : vm_core_.functional_units_){
+        snapshot.Push(Section::kPipeline, fu.exec);
+    }
+    for(const auto& fu : vm_core_.functional_units_){
+        snapshot.Push(Section::kPipeline, fu.commit);
+    }
+
+    for(const auto& instr : vm_core_.Station(FuKind::kAlu).GetQue()){
+        snapshot.Push(Section::kReservationStationAlu, instr);
+    }
+    for(const auto& instr : vm_core_.Station(FuKind::kFpu).GetQue()){
+        snapshot.Push(Section::kReservationStationFalu, instr);
+    }
+    for(const auto& instr : vm_core_.Station(FuKind::kLsu).GetQue()){
+        snapshot.Push(Section::kReservationStationLsu, instr);
+    }
+    for(const auto& entry : vm_core_.commit_buffer_.GetEntries()){
+        snapshot.PushRobEntry(entry.instr, entry.ready_to_commit);
+    }
+    snapshot.SetRobHeadTail(vm_core_.commit_buffer_.GetHeadTail());
+}
+
+
+VmBase::Stats& OooVM::GetStats(){
+    return vm_core_.core_stats_;
+}
+
+const pc_profile::PcProfile& OooVM::GetProfile(){
+    return vm_core_.profile_;
+}
+
+const host_profile::HostProfile& OooVM::GetHostProfile(){
+    return vm_core_.host_profile_;
+}
+
+std::pair<cache::CacheStats, cache::CacheStats> OooVM::GetCacheStats(){
+    return {vm_core_.memory_controller_.GetICacheStats(), vm_core_.memory_controller_.GetDCacheStats()};
+}
+
+void OooVM::DumpCache(){
+    vm_core_.memory_controller_.PrintCacheStatus(vm_core_.Log());
+    vm_core_.memory_controller_.DumpCache(vm_core_.Log());
+}
+
+void OooVM::SetLog(std::ostream& log){
+    vm_core_.SetLog(log);
+}
+    
+} // namespace ooo
@@ -0,0 +1,116 @@
+#include "vm/pc_profile.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace pc_profile {
+
+namespace {
+
+void WriteCounters(std::ostream& os, const PcCounters& counters) {
+    os << "\"retired\": " << counters.retired
+       << ", \"cycles\": " << counters.cycles
+       << ", \"stall_cycles\": " << counters.stall_cycles
+       << ", \"mispredicts\": " << counters.mispredicts;
+}
+
+std::string Escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c=='"' || c=='\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool Empty(const PcCounters& counters) {
+    return counters.retired==0 && counters.cycles==0 && counters.mispredicts==0;
+}
+
+}
+
+PcCounters& PcCounters::operator+=(const PcCounters& other) {
+    retired += other.retired;
+    cycles += other.cycles;
+    stall_cycles += other.stall_cycles;
+    mispredicts += other.mispredicts;
+    return *this;
+}
+
+void PcProfile::Resize(uint64_t text_size) {
+    counters_.assign(text_size / 4, PcCounters{});
+}
+
+void PcProfile::Charge(const CycleCharge& charge) {
+    if (charge.charged) {
+        Add(charge.pc, PcCounters{0, charge.cycles, charge.stall_cycles, 0});
+    }
+}
+
+void PcProfile::Add(uint64_t pc, const PcCounters& counters) {
+    if (PcCounters* at = At(pc)) {
+        *at += counters;
+    }
+}
+
+void PcProfile::Subtract(uint64_t pc, const PcCounters& counters) {
+    if (PcCounters* at = At(pc)) {
+        at->retired -= counters.retired;
+        at->cycles -= counters.cycles;
+        at->stall_cycles -= counters.stall_cycles;
+        at->mispredicts -= counters.mispredicts;
+    }
+}
+
+std::map<unsigned int, PcCounters> ByLine(const std::vector<PcCounters>& counters, const AssembledProgram& program) {
+    std::map<unsigned int, PcCounters> lines;
+    for (const auto& [instruction, line] : program.instruction_number_line_number_mapping) {
+        if (instruction < counters.size() && !Empty(counters[instruction])) {
+            lines[line] += counters[instruction];
+        }
+    }
+    return lines;
+}
+
+void DumpJson(std::ostream& os, const std::vector<PcCounters>& counters, const AssembledProgram& program,
+              uint64_t total_cycles) {
+    os << "{\n";
+    os << "    \"file\": \"" << Escape(program.filename) << "\",\n";
+    os << "    \"cycles\": " << total_cycles << ",\n";
+
+    os << "    \"pcs\": [";
+    bool first = true;
+    for (size_t i = 0; i < counters.size(); i++) {
+        if (Empty(counters[i])) {
+            continue;
+        }
+        auto line = program.instruction_number_line_number_mapping.find(static_cast<unsigned int>(i));
+        os << (first ? "\n" : ",\n") << "        {\"pc\": " << i * 4
+           << ", \"line\": " << (line!=program.instruction_number_line_number_mapping.end() ? line->second : 0) << ", ";
+        WriteCounters(os, counters[i]);
+        os << "}";
+        first = false;
+    }
+    os << (first ? "],\n" : "\n    ],\n");
+
+    std::map<unsigned int, PcCounters> by_line = ByLine(counters, program);
+    std::vector<std::pair<unsigned int, PcCounters>> lines(by_line.begin(), by_line.end());
+    std::stable_sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+        return a.second.cycles > b.second.cycles;
+    });
+
+    os << "    \"lines\": [";
+    first = true;
+    for (const auto& [line, line_counters] : lines) {
+        os << (first ? "\n" : ",\n") << "        {\"line\": " << line << ", ";
+        WriteCounters(os, line_counters);
+        os << "}";
+        first = false;
+    }
+    os << (first ? "]\n" : "\n    ]\n");
+    os << "}\n";
+}
+
+} // namespace pc_profile
@@ -0,0 +1,22 @@
+#include "vm/pipeline_snapshot.h"
+
+void PipelineSnapshot::Begin(uint64_t generation) {
+    generation_ = generation;
+    slots_.clear();
+    ranges_.fill(Range{});
+    rob_head_tail_ = {0, 0};
+}
+
+void PipelineSnapshot::Append(Section section, const InstrSlot& slot) {
+    Range& range = ranges_[static_cast<size_t>(section)];
+    if (range.count==0) {
+        range.offset = static_cast<uint32_t>(slots_.size());
+    }
+    slots_.push_back(slot);
+    range.count++;
+}
+
+std::span<const InstrSlot> PipelineSnapshot::Get(Section section) const {
+    const Range& range = ranges_[static_cast<size_t>(section)];
+    return std::span<const InstrSlot>(slots_.data() + range.offset, range.count);
+}
@@ -0,0 +1,333 @@
+#include "vm/pipeline_trace.h"
+#include "globals.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+namespace pipeline_trace {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'I', 'P', 'E', 'T', 'R', 'C', '1'};
+
+struct Header {
+    char magic[8];
+    uint32_t record_size;
+    uint32_t reserved;
+};
+
+constexpr uint64_t kUnset = std::numeric_limits<uint64_t>::max();
+
+// Konata draws Commit as a one cycle stage, Squash only ends the instruction
+constexpr std::array<const char*, kNumStages> kKanataNames = {"F", "D", "Is", "X", "M", "Cp", "Cm", ""};
+
+void ReadHeader(std::istream& trace) {
+    Header header{};
+    trace.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!trace || std::memcmp(header.magic, kMagic, sizeof(kMagic))!=0 || header.record_size!=sizeof(InstrRecord)) {
+        throw std::runtime_error("Not a pipeline trace file");
+    }
+}
+
+bool ReadRecord(std::istream& trace, InstrRecord& record) {
+    trace.read(reinterpret_cast<char*>(&record), sizeof(record));
+    return static_cast<bool>(trace);
+}
+
+std::string Label(const std::vector<std::string>& labels, uint64_t pc) {
+    std::ostringstream label;
+    label << "0x" << std::hex << std::setw(8) << std::setfill('0') << pc;
+    if (pc / 4 < labels.size()) {
+        label << ": " << labels[pc / 4];
+    }
+    return label.str();
+}
+
+// the cycle the instruction entered stage in, kUnset if it never got there
+uint64_t Entered(const InstrRecord& record, Stage stage) {
+    uint16_t entered = record.entered[static_cast<size_t>(stage)];
+    return entered!=0 ? record.cycle + entered - 1 : kUnset;
+}
+
+}
+
+void TraceConfig::Modify(const std::string& key, const std::string& value) {
+    if (key=="trace_enabled") {
+        if (value!="true" && value!="false") {
+            throw std::invalid_argument("Unknown value: " + value);
+        }
+        enabled = value=="true";
+    } else if (key=="trace_start_cycle") {
+        start_cycle = std::stoull(value);
+    } else if (key=="trace_end_cycle") {
+        end_cycle = std::stoull(value);
+    } else if (key=="trace_buffer_records") {
+        buffer_records = std::stoull(value);
+        if (buffer_records==0) {
+            throw std::invalid_argument("The trace buffer needs room for at least one record");
+        }
+    } else if (key=="trace_file") {
+        file = value;
+    } else {
+        throw std::invalid_argument("Unknown key: " + key);
+    }
+}
+
+std::filesystem::path TraceConfig::File() const {
+    return file.empty() ? globals::trace_file_path : file;
+}
+
+Tracer::~Tracer() {
+    Close();
+}
+
+void Tracer::Open(const TraceConfig& config) {
+    Close();
+    if (!config.enabled) {
+        return;
+    }
+
+    const std::filesystem::path path = config.File();
+    file_ = std::fopen(path.string().c_str(), "wb");
+    if (file_==nullptr) {
+        throw std::runtime_error("Unable to open trace file: " + path.string());
+    }
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.record_size = sizeof(InstrRecord);
+    std::fwrite(&header, sizeof(header), 1, file_);
+
+    // a slot's seq is one no instruction of it has, until the first one is traced
+    in_flight_.assign(kMaxInFlight, InstrRecord{});
+    for (size_t slot = 0; slot < kMaxInFlight; slot++) {
+        in_flight_[slot].seq = static_cast<uint32_t>(slot + 1);
+    }
+    chunk_records_ = std::max<uint64_t>(1, config.buffer_records / kNumChunks);
+    ring_.assign(chunk_records_ * kNumChunks, InstrRecord{});
+    chunk_ = 0;
+    fill_ = 0;
+    published_ = 0;
+    written_ = 0;
+    closing_ = false;
+
+    start_cycle_ = config.start_cycle;
+    end_cycle_ = config.end_cycle!=0 ? config.end_cycle : kUnset;
+    enabled_ = true;
+    writer_ = std::thread(&Tracer::WriterLoop, this);
+}
+
+void Tracer::Flush() {
+    if (!enabled_) {
+        return;
+    }
+    if (fill_>0) {
+        Publish();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return written_==published_; });
+    std::fflush(file_);
+}
+
+void Tracer::Close() {
+    if (!enabled_) {
+        return;
+    }
+    Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    writer_.join();
+
+    std::fclose(file_);
+    file_ = nullptr;
+    enabled_ = false;
+    in_flight_.clear();
+    in_flight_.shrink_to_fit();
+    ring_.clear();
+    ring_.shrink_to_fit();
+}
+
+void Tracer::Publish() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        chunk_fill_[chunk_] = fill_;
+        published_++;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return published_ - written_ < kNumChunks; });
+    }
+    chunk_ = published_ % kNumChunks;
+    fill_ = 0;
+}
+
+void Tracer::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return written_<published_ || closing_; });
+        if (written_==published_) {
+            return;
+        }
+
+        size_t chunk = written_ % kNumChunks;
+        size_t count = chunk_fill_[chunk];
+        lock.unlock();
+        std::fwrite(&ring_[chunk * chunk_records_], sizeof(InstrRecord), count, file_);
+        lock.lock();
+
+        written_++;
+        cv_.notify_all();
+    }
+}
+
+std::vector<std::string> Disassembly(const AssembledProgram& program) {
+    std::vector<std::string> labels;
+    labels.reserve(program.intermediate_code.size());
+    for (const auto& [unit, _] : program.intermediate_code) {
+        std::ostringstream text;
+        text << unit;
+        labels.push_back(text.str());
+    }
+    return labels;
+}
+
+void ConvertToKanata(std::istream& trace, std::ostream& os, const std::vector<std::string>& labels) {
+    ReadHeader(trace);
+
+    std::vector<InstrRecord> records;
+    InstrRecord record{};
+    while (ReadRecord(trace, record)) {
+        records.push_back(record);
+    }
+    std::stable_sort(records.begin(), records.end(), [](const InstrRecord& a, const InstrRecord& b) {
+        return a.cycle < b.cycle;
+    });
+
+    os << "Kanata\t0004\n";
+    if (records.empty()) {
+        return;
+    }
+
+    // the lines of the instructions that started, by the cycle they are for. An instruction that commits or is
+    // squashed in a cycle leaves the pipeline at the start of the next one
+    struct Lines {
+        uint64_t cycle;
+        uint64_t order;
+        bool retire;
+        std::string text;
+        bool operator>(const Lines& other) const {
+            return cycle!=other.cycle ? cycle > other.cycle : order > other.order;
+        }
+    };
+    std::priority_queue<Lines, std::vector<Lines>, std::greater<Lines>> pending;
+    uint64_t order = 0;
+    uint64_t retired = 0;
+
+    uint64_t now = records.front().cycle;
+    os << "C=\t" << now << "\n";
+    auto emit_until = [&](uint64_t cycle) {
+        while (!pending.empty() && pending.top().cycle < cycle) {
+            const Lines& lines = pending.top();
+            if (lines.cycle > now) {
+                os << "C\t" << lines.cycle - now << "\n";
+                now = lines.cycle;
+            }
+            os << lines.text;
+            if (lines.retire) {
+                os << retired++ << "\t0\n";
+            }
+            pending.pop();
+        }
+    };
+
+    for (uint64_t id = 0; id < records.size(); id++) {
+        const InstrRecord& instr = records[id];
+        emit_until(instr.cycle);
+
+        std::ostringstream start;
+        start << "I\t" << id << "\t" << instr.seq << "\t0\n";
+        start << "L\t" << id << "\t0\t" << Label(labels, instr.pc) << "\n";
+        pending.push({instr.cycle, order++, false, start.str()});
+
+        const char* last = nullptr;
+        for (size_t stage = 0; stage < kNumStages; stage++) {
+            uint64_t cycle = Entered(instr, static_cast<Stage>(stage));
+            if (cycle==kUnset) {
+                continue;
+            }
+
+            std::ostringstream lines;
+            bool squashed = static_cast<Stage>(stage)==Stage::Squash;
+            if (squashed) {
+                cycle++;
+            }
+            if (last!=nullptr) {
+                lines << "E\t" << id << "\t0\t" << last << "\n";
+            }
+            if (squashed) {
+                lines << "R\t" << id << "\t0\t1\n";
+                pending.push({cycle, order++, false, lines.str()});
+                break;
+            }
+
+            last = kKanataNames[stage];
+            lines << "S\t" << id << "\t0\t" << last << "\n";
+            pending.push({cycle, order++, false, lines.str()});
+
+            if (static_cast<Stage>(stage)==Stage::Commit) {
+                // the retire id is counted when the line is written
+                std::ostringstream retire;
+                retire << "E\t" << id << "\t0\t" << last << "\n" << "R\t" << id << "\t";
+                pending.push({cycle + 1, order++, true, retire.str()});
+            }
+        }
+    }
+    emit_until(kUnset);
+}
+
+void ConvertToO3PipeView(std::istream& trace, std::ostream& os, const std::vector<std::string>& labels) {
+    ReadHeader(trace);
+
+    uint64_t id = 0;
+    InstrRecord instr{};
+    while (ReadRecord(trace, instr)) {
+        bool squashed = instr.entered[static_cast<size_t>(Stage::Squash)]!=0;
+
+        // a committed instruction went through every stage, those its model doesn't have take no time. A squashed
+        // one never got to the stages it misses, gem5 writes 0 for those
+        auto tick = [&](std::initializer_list<Stage> stages, uint64_t before) {
+            for (Stage stage : stages) {
+                uint64_t cycle = Entered(instr, stage);
+                if (cycle!=kUnset) {
+                    return cycle * kTicksPerCycle;
+                }
+            }
+            return squashed ? 0 : before;
+        };
+
+        uint64_t fetch = tick({Stage::Fetch}, instr.cycle * kTicksPerCycle);
+        uint64_t decode = tick({Stage::Decode}, fetch);
+        uint64_t dispatch = tick({Stage::Issue}, decode);
+        uint64_t issue = tick({Stage::Execute}, dispatch);
+        uint64_t complete = tick({Stage::Complete, Stage::Memory}, issue);
+        uint64_t retire = squashed ? 0 : tick({Stage::Commit}, complete);
+
+        os << "O3PipeView:fetch:" << fetch << ":0x" << std::hex << std::setw(8) << std::setfill('0') << instr.pc
+           << std::dec << ":0:" << id++ << ":" << Label(labels, instr.pc) << "\n";
+        os << "O3PipeView:decode:" << decode << "\n";
+        os << "O3PipeView:rename:" << decode << "\n";
+        os << "O3PipeView:dispatch:" << dispatch << "\n";
+        os << "O3PipeView:issue:" << issue << "\n";
+        os << "O3PipeView:complete:" << complete << "\n";
+        os << "O3PipeView:retire:" << retire << ":store:0\n";
+    }
+}
+
+} // namespace pipeline_trace
@@ -19,47 +19,78 @@ void PipelinedCore::SetProgramCounter(uint64_t value){
     program_counter_ = value;
 }
 
+PipelinedInstrContext& PipelinedCore::GetLatch(size_t stage){
+    return latches_[(latch_head_ + stage) % kNumStages];
+}
+
+unsigned int PipelinedCore::ExCycles(const PipelinedInstrContext& instr) const{
+    if(instr.nopped || instr.bubbled)
+        return 1;
+    return latency_table_[instr.alu_op].latency;
+}
+
 PipelinedInstrContext& PipelinedCore::GetIfInstruction(){
-    return instruction_deque_[0];
+    return GetLatch(0);
 }
 PipelinedInstrContext& PipelinedCore::GetIdInstruction(){
-    return instruction_deque_[1];
+    return GetLatch(1);
 }
 PipelinedInstrContext& PipelinedCore::GetExInstruction(){
-    return instruction_deque_[2];
+    return GetLatch(2);
 }
 PipelinedInstrContext& PipelinedCore::GetMemInstruction(){
-    return instruction_deque_[3];
+    return GetLatch(3);
 }
 PipelinedInstrContext& PipelinedCore::GetWbInstruction(){
-    return instruction_deque_[4];
+    return GetLatch(4);
+}
+
+PipelinedInstrContext& PipelinedCore::ShiftLatches(){
+    latch_head_ = (latch_head_ + kNumStages - 1) % kNumStages;
+    return GetLatch(0);
+}
+
+PipelinedInstrContext& PipelinedCore::UnshiftLatches(){
+    latch_head_ = (latch_head_ + 1) % kNumStages;
+    return GetLatch(kNumStages - 1);
 }
 
 void PipelinedCore::ClearStop(){
     stop_requested_ = false;
 }
 
+bool PipelinedCore::ProgramEnded(){
+    if(program_counter_ < program_size_)
+        return false;
+    return GetIdInstruction().nopped && GetExInstruction().nopped && GetMemInstruction().nopped && GetWbInstruction().nopped;
+}
+
+void PipelinedCore::SetLog(std::ostream& log){
+	log_ = &log;
+	fast_forward_engine_.SetLog(log);
+}
+
 void PipelinedCore::Reset(){
 	this->stop_requested_ = false;
 
     this->program_counter_ = 0;
 	this->register_file_.Reset();
+	this->memory_controller_.SetCacheConfigs(config_.icache_config, config_.dcache_config);
 	this->memory_controller_.Reset();
-	// assert(instruction_deque_.size()==5);
-	instruction_deque_.clear();
-
-	branch_predictor_.reset();
+	data_hazard_detected_ = false;
 
-	undo_instruction_stack_.clear();
+	branch_predictor_.Reset();
 
-    for(int i=0;i<5;i++){
-        // instruction_deque_.pop_back();
-        
-        PipelinedInstrContext nop{};
-        nop.nopify();
-		nop.bubbled = true;
+	undo_instruction_stack_.Clear();
+	profile_.Resize(program_size_);
+	host_profile_.Reset();
 
-        instruction_deque_.push_front(nop);
+	latch_head_ = 0;
+	next_seq_ = 0;
+    for(PipelinedInstrContext& latch : latches_){
+        latch = PipelinedInstrContext{};
+        latch.nopify();
+		latch.bubbled = true;
     }
 }
 
@@ -67,13 +98,17 @@ void PipelinedCore::Load(AssembledProgram& program){
     Reset();
 
     // updating core state
-	this->data_forwarding_enabled_ = vm_config::config.getDataFowardingStatus();
-	this->hazard_detection_enabled_ = vm_config::config.getHazardDetectionStatus();
-	this->max_undo_stack_size_ = vm_config::config.getMaxUndoStackSize();
+	this->data_forwarding_enabled_ = config_.getDataFowardingStatus();
+	this->hazard_detection_enabled_ = config_.getHazardDetectionStatus();
+	this->max_undo_stack_size_ = config_.getMaxUndoStackSize();
+	this->undo_instruction_stack_.Reserve(max_undo_stack_size_);
+	this->undo_records_.Reserve(max_undo_stack_size_ + kNumStages + 1);
 
-	std::vector<bool> t = vm_config::config.getBranchPredictionStatus();
+	std::vector<bool> t = config_.getBranchPredictionStatus();
 	this->branch_prediction_enabled_ = t[0];
 	this->branch_prediction_static_ = t[1];
+	this->branch_predictor_.Configure(config_.getBranchPredictorConfig());
+	this->latency_table_.Configure(config_.latency_config);
 
 
     // Loading the instructions (machine code) into memory
@@ -83,11 +118,14 @@ void PipelinedCore::Load(AssembledProgram& program){
 		counter += 4;
 	}
 	this->program_size_ = counter;
+	this->memory_controller_.SetTextSize(program_size_);
+	this->profile_.Resize(program_size_);
+	this->trace_.Open(config_.trace_config);
 
 
     // Loading data section into memory
     unsigned int data_counter = 0;
-	uint64_t base_data_address = vm_config::config.getDataSectionStart();
+	uint64_t base_data_address = config_.getDataSectionStart();
 
 	auto align = [&](unsigned int alignment) {
 		if (data_counter % alignment != 0)
@@ -149,18 +187,19 @@ void PipelinedCore::Load(){
 	Reset();
 
     // updating core state
-	this->data_forwarding_enabled_ = vm_config::config.getDataFowardingStatus();
-	this->hazard_detection_enabled_ = vm_config::config.getHazardDetectionStatus();
-	this->max_undo_stack_size_ = vm_config::config.getMaxUndoStackSize();
+	this->data_forwarding_enabled_ = config_.getDataFowardingStatus();
+	this->hazard_detection_enabled_ = config_.getHazardDetectionStatus();
+	this->max_undo_stack_size_ = config_.getMaxUndoStackSize();
+	this->undo_instruction_stack_.Reserve(max_undo_stack_size_);
+	this->undo_records_.Reserve(max_undo_stack_size_ + kNumStages + 1);
 
-	std::vector<bool> t = vm_config::config.getBranchPredictionStatus();
+	std::vector<bool> t = config_.getBranchPredictionStatus();
 	this->branch_prediction_enabled_ = t[0];
 	this->branch_prediction_static_ = t[1];
+	this->branch_predictor_.Configure(config_.getBranchPredictorConfig());
+	this->latency_table_.Configure(config_.latency_config);
 
-	core_stats_.branch_instrs = 0;
-	core_stats_.branch_mispredicts = 0;
-	core_stats_.cycles = 0;
-	core_stats_.instrs_retired = 0;
+	core_stats_ = VmBase::Stats{};
 }
 
 
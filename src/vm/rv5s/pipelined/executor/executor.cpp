@@ -7,213 +7,329 @@ namespace {
 /**
  * Common functions
  */
-void InsertIfInstruction(rv5s::PipelinedCore& vm_core){
-    // Pushing a new instruction infront of the instruction deque
+// Moves the pipeline on by one stage: the WB instruction retires (onto the undo stack if kDebug) and its latch
+// takes the new IF instruction
+template<bool kDebug>
+void AdvancePipeline(rv5s::PipelinedCore& vm_core){
+    if constexpr (kDebug){
+        vm_core.undo_instruction_stack_.Push(vm_core.GetWbInstruction());
+    }
+
+    rv5s::PipelinedInstrContext& if_instruction = vm_core.ShiftLatches();
     if(vm_core.program_counter_ < vm_core.program_size_)
-        vm_core.instruction_deque_.push_front(rv5s::PipelinedInstrContext{vm_core.program_counter_});
+        if_instruction = rv5s::PipelinedInstrContext{vm_core.program_counter_};
     else{
         vm_core.AddToProgramCounter(4);   // so that the nop we insert now doesn't cause any probs in fetch
-        rv5s::PipelinedInstrContext nop;
-        nop.nopify();
-        nop.bubbled = true;
-        vm_core.instruction_deque_.push_front(nop);
+        if_instruction = rv5s::PipelinedInstrContext{};
+        if_instruction.nopify();
+        if_instruction.bubbled = true;
     }
+    if_instruction.seq = vm_core.next_seq_++;
 }
 
+// The EX instruction is still on a multi-cycle unit: IF, ID and EX hold, MEM moves on to WB (the WB instruction
+// retires) and a bubble goes into MEM
+template<bool kDebug>
+void HoldEx(rv5s::PipelinedCore& vm_core){
+    if constexpr (kDebug){
+        vm_core.undo_instruction_stack_.Push(vm_core.GetWbInstruction());
+    }
 
-void PopWbInstruction(rv5s::PipelinedCore& vm_core){
-    if(vm_core.debug_mode_){
-        rv5s::PipelinedInstrContext retired_instruction = vm_core.instruction_deque_.back();
-        vm_core.instruction_deque_.pop_back();
-        while(vm_core.undo_instruction_stack_.size() >= vm_core.max_undo_stack_size_){
-            vm_core.undo_instruction_stack_.pop_back();
-        }
-        vm_core.undo_instruction_stack_.push_front(retired_instruction);
+    vm_core.GetWbInstruction() = vm_core.GetMemInstruction();
+    rv5s::PipelinedInstrContext& bubble = vm_core.GetMemInstruction();
+    bubble = rv5s::PipelinedInstrContext{};
+    bubble.nopify();
+    bubble.bubbled = true;
+
+    vm_core.GetExInstruction().ex_cycles_left--;
+
+    rv5s::PipelinedStages::WriteBack<kDebug>(vm_core);
+}
+
+// counts the cycle and the cache stalls it took, in the stats and in the profile: the cycle goes to the WB
+// instruction if it retired, else to the oldest instruction in flight, the one retirement is waiting on
+void AddCycle(rv5s::PipelinedCore& vm_core){
+    memory_controller::StallCycles stalls = vm_core.memory_controller_.TakeStallCycles();
+    vm_core.core_stats_.AddCycle(1, stalls);
+
+    pc_profile::CycleCharge charge;
+    charge.cycles = 1 + stalls.Total();
+    charge.stall_cycles = stalls.Total();
+    for(size_t stage=rv5s::PipelinedCore::kNumStages;stage-->0;){
+        const rv5s::PipelinedInstrContext& instr = vm_core.GetLatch(stage);
+        if(instr.nopped)
+            continue;
+
+        charge.pc = instr.pc;
+        charge.charged = true;
+        if(stage!=rv5s::PipelinedCore::kNumStages - 1)
+            charge.stall_cycles++;
+        break;
     }
-    else{
-        vm_core.instruction_deque_.pop_back();
+    vm_core.profile_.Charge(charge);
+}
+
+// records the stage of the instructions that moved into a new one, those in first_moved and the stages after it
+void TraceLatches(rv5s::PipelinedCore& vm_core, size_t first_moved){
+    static constexpr std::array<pipeline_trace::Stage, rv5s::PipelinedCore::kNumStages> kStages = {
+        pipeline_trace::Stage::Fetch, pipeline_trace::Stage::Decode, pipeline_trace::Stage::Execute,
+        pipeline_trace::Stage::Memory, pipeline_trace::Stage::Commit,
+    };
+
+    uint64_t cycle = vm_core.core_stats_.cycles;
+    if(!vm_core.trace_.InWindow(cycle))
+        return;
+
+    for(size_t stage=first_moved;stage<rv5s::PipelinedCore::kNumStages;stage++){
+        const rv5s::PipelinedInstrContext& instr = vm_core.GetLatch(stage);
+        if(!instr.nopped)
+            vm_core.trace_.Record(cycle, kStages[stage], instr.seq, instr.pc);
+    }
+}
+
+// puts back the registers the WB instruction overwrote
+void UndoWriteBack(rv5s::PipelinedCore& vm_core, const rv5s::PipelinedInstrContext& wb_instruction){
+    const UndoRecord& wb_record = vm_core.undo_records_[wb_instruction.seq];
+    if(wb_instruction.fcsr_update){
+        vm_core.register_file_.WriteCsr(0x003, wb_record.fcsr_overwritten);
+    }
+    if(wb_instruction.reg_write){
+        if(wb_instruction.csr_op){
+            vm_core.register_file_.WriteCsr(wb_instruction.csr_rd, wb_record.csr_overwritten);
+            vm_core.register_file_.WriteGpr(wb_instruction.rd, wb_record.reg_overwritten);
+        }
+        else if(wb_instruction.reg_write_to_fpr){
+            vm_core.register_file_.WriteFpr(wb_instruction.rd, wb_record.reg_overwritten);
+        }
+        else{
+            vm_core.register_file_.WriteGpr(wb_instruction.rd, wb_record.reg_overwritten);
+        }
     }
 }
 
+template<bool kBranchPrediction, bool kDebug>
 void DrivePipeline(rv5s::PipelinedCore& vm_core){
     // Fetch
-    rv5s::PipelinedStages::Fetch(vm_core);
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Fetch);
+        rv5s::PipelinedStages::Fetch<kBranchPrediction>(vm_core);
+    }
 
     /**
      * WriteBack() happens before decode, following "write first"
      */
     // WriteBack
-    rv5s::PipelinedStages::WriteBack(vm_core);
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, WriteBack);
+        rv5s::PipelinedStages::WriteBack<kDebug>(vm_core);
+    }
 
     // Decode
-    rv5s::PipelinedStages::Decode(vm_core);
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Decode);
+        rv5s::PipelinedStages::Decode(vm_core);
+    }
 
     // Execute
-    rv5s::PipelinedStages::Execute(vm_core);
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Execute);
+        rv5s::PipelinedStages::Execute<kBranchPrediction>(vm_core);
+    }
 
     // MemoryAccess
-    rv5s::PipelinedStages::MemoryAccess(vm_core);
+    {
+        HOST_PROFILE_SCOPE(vm_core.host_profile_, Memory);
+        rv5s::PipelinedStages::MemoryAccess<kDebug>(vm_core);
+    }
 }
 
 
-
 /**
- * Pipeline without hazard detection and forwarding
+ * One cycle, without hazard detection (and forwarding) if !kHazard. kForwarding only matters with kHazard.
  */
-void StepPipelinedNoHazard(rv5s::PipelinedCore& vm_core){
-    // FIXME: stop when the program is over
-    if(vm_core.program_counter_ >= vm_core.program_size_){
-        if(vm_core.GetIdInstruction().nopped && vm_core.GetExInstruction().nopped && vm_core.GetMemInstruction().nopped && vm_core.GetWbInstruction().nopped){
-            globals::vm_cout_file << "Cannot step further." << std::endl;
-            return;
-        }
-    }
-
-    InsertIfInstruction(vm_core);
-
-    PopWbInstruction(vm_core);
-
-    DrivePipeline(vm_core);
-}
-
-void RunPipelinedNoHazard(rv5s::PipelinedCore& vm_core){
-    vm_core.ClearStop();
-    uint64_t instruction_executed = 0;
-    
-    while (!vm_core.stop_requested_) {
-        if (instruction_executed > vm_config::config.getInstructionExecutionLimit())
-            break;
-
-        
-        StepPipelinedNoHazard(vm_core);
-
-        // FIXME:
-        if(vm_core.program_counter_ >= vm_core.program_size_){
-            if(vm_core.GetIdInstruction().nopped && vm_core.GetExInstruction().nopped && vm_core.GetMemInstruction().nopped && vm_core.GetWbInstruction().nopped)
-                break;
-        }
-    
-        instruction_executed++;
-        globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
+template<bool kHazard, bool kForwarding, bool kBranchPrediction, bool kDebug>
+void StepPipelinedImpl(rv5s::PipelinedCore& vm_core){
+    // FIXME: do this properly
+    if(vm_core.ProgramEnded()){
+        vm_core.Log() << "Cannot step further." << std::endl;
+        return;
     }
-    
-    globals::vm_cout_file << "Vm: the loaded program has ended!" << std::endl;
-    
-    // DumpRegisters(globals::registers_dump_file_path, registers_);
-    // DumpState(globals::vm_state_dump_file_path);
-}
 
+    HOST_PROFILE_SCOPE(vm_core.host_profile_, Cycle);
 
+    // the slot of a cycle is what enters EX: an instruction (it retires), a bubble of a stall (backend), an
+    // instruction a control hazard flushed (bad speculation) or a bubble fetched past the program (frontend)
+    VmBase::TopDown& top_down = vm_core.core_stats_.top_down;
 
-/**
- * Pipelined With hazard detection
- */
-void StepPipelinedWithHazard(rv5s::PipelinedCore& vm_core){
-    // FIXME: do this properly
-    if(vm_core.program_counter_ >= vm_core.program_size_){
-        if(vm_core.GetIdInstruction().nopped && vm_core.GetExInstruction().nopped && vm_core.GetMemInstruction().nopped && vm_core.GetWbInstruction().nopped){
-            globals::vm_cout_file << "Cannot step further." << std::endl;
-            return;
-        }
+    if(vm_core.GetExInstruction().ex_cycles_left > 0){
+        HoldEx<kDebug>(vm_core);
+        top_down.backend_bound++;
+        TraceLatches(vm_core, rv5s::PipelinedCore::kNumStages - 1); // only WB moved
+        AddCycle(vm_core);
+        return;
     }
 
-    static bool data_hazard_detected = false;
-    if(data_hazard_detected){
-        vm_core.hazard_detector_.HandleDataHazard(vm_core);
+    size_t first_moved = 0;
+    if(kHazard && vm_core.data_hazard_detected_){
+        vm_core.hazard_detector_.HandleDataHazard<kBranchPrediction>(vm_core);
+        top_down.backend_bound++;
+        first_moved = 2; // IF and ID stay
     }
     else{
-        InsertIfInstruction(vm_core);
-        PopWbInstruction(vm_core);
+        AdvancePipeline<kDebug>(vm_core);
+
+        const rv5s::PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
+        if(!ex_instruction.nopped)
+            top_down.retiring++;
+        else if(!ex_instruction.bubbled)
+            top_down.bad_speculation++;
+        else
+            top_down.frontend_bound++;
     }
+    TraceLatches(vm_core, first_moved);
+
+    DrivePipeline<kBranchPrediction, kDebug>(vm_core);
+
+    // a multi-cycle op holds EX for the cycles after this one
+    rv5s::PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
+    ex_instruction.ex_cycles_left = static_cast<uint8_t>(vm_core.ExCycles(ex_instruction) - 1);
+
+    if constexpr (kHazard){
+        if(vm_core.hazard_detector_.DetectControlHazard(vm_core)){
+            // IF and ID hold the wrong path
+            uint64_t cycle = vm_core.core_stats_.cycles;
+            for(const rv5s::PipelinedInstrContext* instr : {&vm_core.GetIfInstruction(), &vm_core.GetIdInstruction()}){
+                if(!instr->nopped)
+                    vm_core.trace_.Record(cycle, pipeline_trace::Stage::Squash, instr->seq, instr->pc);
+            }
+            vm_core.hazard_detector_.HandleControlHazard<kBranchPrediction>(vm_core);
+        }
 
-    DrivePipeline(vm_core);
-    
-    if(vm_core.hazard_detector_.DetectControlHazard(vm_core)){
-        vm_core.hazard_detector_.HandleControlHazard(vm_core);
+        vm_core.data_hazard_detected_ = vm_core.hazard_detector_.DetectDataHazard<kForwarding>(vm_core);
     }
 
-    data_hazard_detected = vm_core.hazard_detector_.DetectDataHazard(vm_core);
+    // a cache miss in IF or MEM freezes the whole (in-order) pipeline
+    AddCycle(vm_core);
 }
-void RunPipelinedWithHazard(rv5s::PipelinedCore& vm_core){
-    vm_core.ClearStop();
+
+template<bool kHazard, bool kForwarding, bool kBranchPrediction>
+void RunPipelinedImpl(rv5s::PipelinedCore& vm_core){
     uint64_t instruction_executed = 0;
     
     while (!vm_core.stop_requested_) {
-        if (instruction_executed > vm_config::config.getInstructionExecutionLimit())
+        if (instruction_executed > vm_core.config_.getInstructionExecutionLimit())
             break;
 
-        StepPipelinedWithHazard(vm_core);
+        // Run() doesn't build undo records
+        StepPipelinedImpl<kHazard, kForwarding, kBranchPrediction, false>(vm_core);
 
         // FIXME:
-        if(vm_core.program_counter_ >= vm_core.program_size_){
-            if(vm_core.GetIdInstruction().nopped && vm_core.GetExInstruction().nopped && vm_core.GetMemInstruction().nopped && vm_core.GetWbInstruction().nopped)
-                break;
-        }
+        if(vm_core.ProgramEnded())
+            break;
 
+        // no per cycle logging here, flushing the log costs more than the cycle
         instruction_executed++;
-        globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
     }
     
-    globals::vm_cout_file << "Vm: the loaded program has ended!" << std::endl;
+    vm_core.Log() << "Vm: the loaded program has ended!" << std::endl;
     
     // DumpRegisters(globals::registers_dump_file_path, registers_);
     // DumpState(globals::vm_state_dump_file_path);
 }
+
+// without hazard detection, forwarding has nothing to forward into
+template<bool kHazard, bool kForwarding, bool kBranchPrediction>
+void SelectFns(rv5s::PipelinedCore& vm_core){
+    constexpr bool kForward = kHazard && kForwarding;
+    vm_core.step_fn_ = &StepPipelinedImpl<kHazard, kForward, kBranchPrediction, true>;
+    vm_core.run_fn_ = &RunPipelinedImpl<kHazard, kForward, kBranchPrediction>;
+}
+
+template<bool kHazard, bool kForwarding>
+void SelectFns(rv5s::PipelinedCore& vm_core){
+    if(vm_core.branch_prediction_enabled_)
+        SelectFns<kHazard, kForwarding, true>(vm_core);
+    else
+        SelectFns<kHazard, kForwarding, false>(vm_core);
+}
+
+template<bool kHazard>
+void SelectFns(rv5s::PipelinedCore& vm_core){
+    if(vm_core.data_forwarding_enabled_)
+        SelectFns<kHazard, true>(vm_core);
+    else
+        SelectFns<kHazard, false>(vm_core);
+}
 }
 
 
 namespace rv5s{
 
+void PipelinedExecutor::Specialize(PipelinedCore& vm_core){
+    if(vm_core.hazard_detection_enabled_)
+        SelectFns<true>(vm_core);
+    else
+        SelectFns<false>(vm_core);
+}
+
 void PipelinedExecutor::RunPipelined(PipelinedCore& vm_core){
-    if(!vm_core.hazard_detection_enabled_){
-        RunPipelinedNoHazard(vm_core);
-    }
-    else{
-        RunPipelinedWithHazard(vm_core);
-    }
+    vm_core.run_fn_(vm_core);
 }
 
 void PipelinedExecutor::StepPipelined(PipelinedCore& vm_core){
-    if(!vm_core.hazard_detection_enabled_){
-        StepPipelinedNoHazard(vm_core);
-    }
-    else{
-        StepPipelinedWithHazard(vm_core);
-    }
+    vm_core.step_fn_(vm_core);
+    vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
 }
 
-void PipelinedExecutor::DebugRunPipelined(PipelinedCore& vm_core){
-    vm_core.ClearStop();
+void PipelinedExecutor::DebugRunPipelined(PipelinedCore& vm_core, const std::function<bool()>& after_step){
 
     uint64_t instruction_executed = 0;
-    while (!vm_core.stop_requested_ && vm_core.program_counter_ < vm_core.program_size_) {
-        if (instruction_executed > vm_config::config.getInstructionExecutionLimit())
+    while (!vm_core.stop_requested_ && !vm_core.ProgramEnded()) {
+        if (instruction_executed >= vm_core.config_.getInstructionExecutionLimit())
             break;
         
-        // the program stops when the if instruction hits a breakpoint
-        if (std::find(vm_core.breakpoints_.begin(), vm_core.breakpoints_.end(), vm_core.GetIfInstruction().pc) == vm_core.breakpoints_.end()) {
+        // the program stops before a breakpoint instruction writes back (IF may hold a wrong path one), the first
+        // step always runs so a run started at a breakpoint gets past it
+        const PipelinedInstrContext& next_retired = vm_core.GetMemInstruction();
+        if (instruction_executed == 0 || next_retired.nopped || std::find(vm_core.breakpoints_.begin(), vm_core.breakpoints_.end(), next_retired.pc) == vm_core.breakpoints_.end()) {
             StepPipelined(vm_core);
-            unsigned int delay_ms = vm_config::config.getRunStepDelay();
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+            instruction_executed++;
+            if (!after_step())
+                break;
         }        
         else {
-            globals::vm_cout_file << " Breakpoint was hit. pc : " << vm_core.program_counter_ << std::endl;
+            vm_core.Log() << " Breakpoint was hit. pc : " << next_retired.pc << std::endl;
             break;
         }
     }
-    if (vm_core.program_counter_ >= vm_core.program_size_) {
-        globals::vm_cout_file << "VM : Program Has Ended" << std::endl;
+    if (vm_core.ProgramEnded()) {
+        vm_core.Log() << "VM : Program Has Ended" << std::endl;
     }
 }
 
 void PipelinedExecutor::UndoPipelined(PipelinedCore& vm_core){
-    if (vm_core.undo_instruction_stack_.empty()) {
-        globals::vm_cout_file << "Cannot undo." << std::endl;
+    if (vm_core.undo_instruction_stack_.Empty()) {
+        vm_core.Log() << "Cannot undo." << std::endl;
         return;
     }
 
-    PipelinedInstrContext last_instruction = vm_core.undo_instruction_stack_.front();
-    vm_core.undo_instruction_stack_.pop_front();
+    PipelinedInstrContext last_instruction = vm_core.undo_instruction_stack_.Top();
+    vm_core.undo_instruction_stack_.Pop();
+
+    // the last cycle held EX (see HoldEx()): WB goes back into MEM, EX gets the cycle back
+    PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
+    if(ex_instruction.ex_cycles_left + 1u < vm_core.ExCycles(ex_instruction)){
+        PipelinedInstrContext curr_wb_instruction_copy = vm_core.GetWbInstruction();
+        UndoWriteBack(vm_core, curr_wb_instruction_copy);
+
+        vm_core.GetMemInstruction() = curr_wb_instruction_copy;
+        vm_core.GetWbInstruction() = last_instruction;
+        ex_instruction.ex_cycles_left++;
+
+        vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
+        vm_core.Log() << "VM : Undo Complete!" << std::endl;
+        return;
+    }
 
     // not by reference, might get popped
     PipelinedInstrContext curr_if_instruction_copy = vm_core.GetIfInstruction();
@@ -221,46 +337,28 @@ void PipelinedExecutor::UndoPipelined(PipelinedCore& vm_core){
     PipelinedInstrContext curr_mem_instruction_copy = vm_core.GetMemInstruction();
     PipelinedInstrContext curr_wb_instruction_copy = vm_core.GetWbInstruction();
 
-    // Throwing the dirty instruction (if the ex instruction was bubbled, then we pop the ex bubble)
+    // Throwing the dirty instruction (if the ex instruction was bubbled, then we pop the ex bubble), the last retired
+    // instruction goes back into the freed WB latch
     vm_core.program_counter_ = curr_if_instruction_copy.pc;
     if(!curr_ex_instruction_copy.bubbled){
-        vm_core.instruction_deque_.pop_front();
+        vm_core.UnshiftLatches() = last_instruction;
+        vm_core.next_seq_ = curr_if_instruction_copy.seq; // refetched with the same seq
     }
     else{
-        vm_core.instruction_deque_.pop_back();
-        vm_core.instruction_deque_.pop_back();
-        vm_core.instruction_deque_.pop_back();
-        vm_core.instruction_deque_.push_back(curr_mem_instruction_copy);
-        vm_core.instruction_deque_.push_back(curr_wb_instruction_copy);
+        vm_core.GetExInstruction() = curr_mem_instruction_copy;
+        vm_core.GetMemInstruction() = curr_wb_instruction_copy;
+        vm_core.GetWbInstruction() = last_instruction;
     }
 
     // Changes in wb stage:
-    if(curr_wb_instruction_copy.reg_write){
-        if(curr_wb_instruction_copy.fcsr_update){
-            vm_core.register_file_.WriteCsr(0x003, curr_wb_instruction_copy.fcsr_status);
-        }
-        if(curr_wb_instruction_copy.csr_op){
-            vm_core.register_file_.WriteCsr(curr_wb_instruction_copy.csr_rd, curr_wb_instruction_copy.csr_overwritten);
-            vm_core.register_file_.WriteGpr(curr_wb_instruction_copy.rd, curr_wb_instruction_copy.reg_overwritten);
-        }
-        else if(curr_wb_instruction_copy.reg_write_to_fpr){
-            vm_core.register_file_.WriteFpr(curr_wb_instruction_copy.rd, curr_wb_instruction_copy.reg_overwritten);
-        }
-        else{
-            vm_core.register_file_.WriteGpr(curr_wb_instruction_copy.rd, curr_wb_instruction_copy.reg_overwritten);
-        }
-    }
+    UndoWriteBack(vm_core, curr_wb_instruction_copy);
 
     // Changes in mem stage:
     if(curr_mem_instruction_copy.mem_write){
-        for(size_t i=0;i<curr_mem_instruction_copy.mem_access_bytes;i++){
-            vm_core.memory_controller_.WriteByte(curr_mem_instruction_copy.alu_out, curr_mem_instruction_copy.mem_overwritten[i]);
-        }
+        vm_core.memory_controller_.WriteSized(curr_mem_instruction_copy.alu_out, curr_mem_instruction_copy.mem_access_bytes,
+                                              vm_core.undo_records_[curr_mem_instruction_copy.seq].mem_overwritten);
     }
 
-    // Pushing last_instruction into the queue
-    vm_core.instruction_deque_.push_back(last_instruction);
-
     // new if instruction == old id instrucion (if no bubble) OR new if instruction == old if instruction (if bubble).
     // resetting either one doesn't matter
     // same logic appies to id instruction
@@ -272,11 +370,26 @@ void PipelinedExecutor::UndoPipelined(PipelinedCore& vm_core){
     new_ex_instruction.mem_out = 0;
 
 
-    globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
-    globals::vm_cout_file << "VM : Undo Complete!" << std::endl;
+    vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
+    vm_core.Log() << "VM : Undo Complete!" << std::endl;
 
     // DumpRegisters(globals::registers_dump_file_path, registers_);
     // DumpState(globals::vm_state_dump_file_path);
 }
 
+
+uint64_t PipelinedExecutor::FastForwardPipelined(PipelinedCore& vm_core, uint64_t num_instrs){
+    // the instructions in flight would be lost
+    if(vm_core.core_stats_.cycles!=0){
+        vm_core.Log() << "VM : Fast forward is only possible before the first cycle." << std::endl;
+        return 0;
+    }
+
+    uint64_t retired = vm_core.fast_forward_engine_.Run(vm_core.program_counter_, num_instrs, vm_core.program_size_,
+                                                        vm_core.register_file_, vm_core.memory_controller_,
+                                                        vm_core.stop_requested_);
+    vm_core.undo_instruction_stack_.Clear();
+    return retired;
+}
+
 } // namespace rv5s
\ No newline at end of file
@@ -13,12 +13,15 @@ using instruction_set::Instruction;
 using instruction_set::get_instr_encoding;
 using register_file::RegisterFile;
 
-void PipelinedDecodeUnit::DecodeInstruction(PipelinedInstrContext& instr_context, RegisterFile& rf){
-    DecodeInstrFields(instr_context);
-    SetRegImmValues(instr_context, rf);
-    SetContextValues(instr_context);
-    // this function should be called after SetContextValues(PipelinedInstrContext);
-    SetMemValues(instr_context);
+void PipelinedDecodeUnit::DecodeInstruction(PipelinedInstrContext& instr_context, RegisterFile& rf, predecode::PredecodeTable& predecode_table){
+    if(!predecode_table.Lookup(instr_context)){
+        DecodeInstrFields(instr_context);
+        SetContextValues(instr_context);
+        // this function should be called after SetContextValues(PipelinedInstrContext);
+        SetMemValues(instr_context);
+        predecode_table.Insert(instr_context);
+    }
+    SetRegValues(instr_context, rf);
 }
 
 
@@ -35,10 +38,16 @@ void PipelinedDecodeUnit::DecodeInstrFields(PipelinedInstrContext& instr_context
     instr_context.frs3 = (instr_context.instruction >> 27) & 0b11111;
 
     instr_context.rd = (instr_context.instruction >> 7) & 0b11111; 
+
+    instr_context.immediate = ImmGenerator(instr_context);
+
+    // csr related
+    instr_context.csr_rd = (instr_context.instruction >> 20) & 0xFFF;
+    instr_context.csr_uimm = instr_context.rs1;
 }
 
 
-void PipelinedDecodeUnit::SetRegImmValues(PipelinedInstrContext& instr_context, RegisterFile& rf){
+void PipelinedDecodeUnit::SetRegValues(PipelinedInstrContext& instr_context, RegisterFile& rf){
     // the values are correct because the register is uint8_t, the first 3 bits are always 0. (32 : 00011111)
     // ReadGpr uses size_t. implicit sign extension retains the correct register value.
     
@@ -49,12 +58,8 @@ void PipelinedDecodeUnit::SetRegImmValues(PipelinedInstrContext& instr_context,
     instr_context.frs2_value = rf.ReadFpr(instr_context.rs2);
     instr_context.frs3_value = rf.ReadFpr(instr_context.frs3);
     
-    instr_context.immediate = ImmGenerator(instr_context);
-    
     // csr related
-    instr_context.csr_rd = (instr_context.instruction >> 20) & 0xFFF;
     instr_context.csr_value = rf.ReadCsr(instr_context.csr_rd);
-    instr_context.csr_uimm = instr_context.rs1;
     instr_context.csr_write_val = instr_context.rs1_value;
 }
 
@@ -88,6 +93,18 @@ void PipelinedDecodeUnit::SetMemValues(PipelinedInstrContext& instr_context){
             case 0b011: {// SD
                 instr_context.mem_access_bytes = 8;
                 break;
+            }
+            case 0b100: {// LBU
+                instr_context.mem_access_bytes = 1;
+                break;
+            }
+            case 0b101: {// LHU
+                instr_context.mem_access_bytes = 2;
+                break;
+            }
+            case 0b110: {// LWU
+                instr_context.mem_access_bytes = 4;
+                break;
             }
 		}
     }
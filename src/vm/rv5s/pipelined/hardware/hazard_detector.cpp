@@ -35,8 +35,9 @@ Control Hazards:
 
 namespace rv5s{
 
+template<bool kForwarding>
 bool HazardDetector::DetectDataHazard(PipelinedCore& vm_core){
-    if(!vm_core.data_forwarding_enabled_){
+    if constexpr (!kForwarding){
         return DetectDataHazardWithoutForwarding(vm_core);
     }
     else{
@@ -44,6 +45,9 @@ bool HazardDetector::DetectDataHazard(PipelinedCore& vm_core){
     }
 }
 
+template bool HazardDetector::DetectDataHazard<false>(PipelinedCore& vm_core);
+template bool HazardDetector::DetectDataHazard<true>(PipelinedCore& vm_core);
+
 bool HazardDetector::DetectDataHazardWithoutForwarding(PipelinedCore& vm_core){
     PipelinedInstrContext& id_instruction = vm_core.GetIdInstruction();
     PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
@@ -60,25 +64,25 @@ bool HazardDetector::DetectDataHazardWithoutForwarding(PipelinedCore& vm_core){
     
     // if(ex_instruction.nopped) then ex_instruction.reg_write is false, idk why we check the nopped variable but ok
     if(!ex_instruction.nopped && ex_instruction.reg_write){   // checking if the ex instruction changes the register file
-        bool id_rs1__ex_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == ex_instruction.rd) && (id_instruction.rs1_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 && !id_instruction.rs1_from_fprf);
-        bool id_rs2__ex_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == ex_instruction.rd) && (id_instruction.rs2_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 && !id_instruction.rs2_from_fprf);
+        bool id_rs1__ex_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == ex_instruction.rd) && (id_instruction.rs1_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 || id_instruction.rs1_from_fprf);
+        bool id_rs2__ex_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == ex_instruction.rd) && (id_instruction.rs2_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 || id_instruction.rs2_from_fprf);
         bool id_rs3__ex_rd_clash = (id_instruction.uses_rs3) && (id_instruction.frs3 == ex_instruction.rd) && (ex_instruction.reg_write_to_fpr);
 
         if(id_rs1__ex_rd_clash || id_rs2__ex_rd_clash || id_rs3__ex_rd_clash){
-            SimState_.HAZARD_DETECTED = true;
-            SimState_.HZ_PATH = SimState::HazardPaths::EXEC_MEM;
+            vm_core.sim_state_.HAZARD_DETECTED = true;
+            vm_core.sim_state_.HZ_PATH = SimState::HazardPaths::EXEC_MEM;
             return true;
         }
     }
 
     if(!mem_instruction.nopped && mem_instruction.reg_write){  // checking if the mem instruction changes the register file
-        bool id_rs1__mem_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == mem_instruction.rd) && (id_instruction.rs1_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 && !id_instruction.rs1_from_fprf);
-        bool id_rs2__mem_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == mem_instruction.rd) && (id_instruction.rs2_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 && !id_instruction.rs2_from_fprf);
+        bool id_rs1__mem_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == mem_instruction.rd) && (id_instruction.rs1_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 || id_instruction.rs1_from_fprf);
+        bool id_rs2__mem_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == mem_instruction.rd) && (id_instruction.rs2_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 || id_instruction.rs2_from_fprf);
         bool id_rs3__mem_rd_clash = (id_instruction.uses_rs3) && (id_instruction.frs3 == mem_instruction.rd) && (mem_instruction.reg_write_to_fpr);
 
         if(id_rs1__mem_rd_clash || id_rs2__mem_rd_clash || id_rs3__mem_rd_clash){
-            SimState_.HAZARD_DETECTED = true;
-            SimState_.HZ_PATH = SimState::HazardPaths::MEM_WB;
+            vm_core.sim_state_.HAZARD_DETECTED = true;
+            vm_core.sim_state_.HZ_PATH = SimState::HazardPaths::MEM_WB;
             return true;
         }
     }
@@ -106,21 +110,21 @@ bool HazardDetector::DetectDataHazardWithForwarding(PipelinedCore& vm_core){
     bool rs3_updated = false;
     
     if(!ex_instruction.nopped && ex_instruction.reg_write){   // checking if the ex instruction changes the register file
-        bool id_rs1__ex_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == ex_instruction.rd) && (id_instruction.rs1_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 && !id_instruction.rs1_from_fprf);
-        bool id_rs2__ex_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == ex_instruction.rd) && (id_instruction.rs2_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 && !id_instruction.rs2_from_fprf);
+        bool id_rs1__ex_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == ex_instruction.rd) && (id_instruction.rs1_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 || id_instruction.rs1_from_fprf);
+        bool id_rs2__ex_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == ex_instruction.rd) && (id_instruction.rs2_from_fprf == ex_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 || id_instruction.rs2_from_fprf);
         bool id_rs3__ex_rd_clash = (id_instruction.uses_rs3) && (id_instruction.frs3 == ex_instruction.rd) && (ex_instruction.reg_write_to_fpr);
         bool clash = id_rs1__ex_rd_clash || id_rs2__ex_rd_clash || id_rs3__ex_rd_clash;
 
         if(clash && ex_instruction.mem_read) // data hazard
         {
-            SimState_.HAZARD_DETECTED = true;
-            SimState_.HZ_PATH = SimState::HazardPaths::EXEC_MEM;
+            vm_core.sim_state_.HAZARD_DETECTED = true;
+            vm_core.sim_state_.HZ_PATH = SimState::HazardPaths::EXEC_MEM;
             return true;
         }
 
         if(id_rs1__ex_rd_clash){            
-            SimState_.DATA_FORWARD = true;
-            SimState_.DF_PATH = SimState::DataForwardPaths::EXEC_MEM_RS1;
+            vm_core.sim_state_.DATA_FORWARD = true;
+            vm_core.sim_state_.DF_PATH = SimState::DataForwardPaths::EXEC_MEM_RS1;
             rs1_updated = true;
 
             if(id_instruction.rs1_from_fprf)
@@ -130,8 +134,8 @@ bool HazardDetector::DetectDataHazardWithForwarding(PipelinedCore& vm_core){
         }
 
         if(id_rs2__ex_rd_clash){
-            SimState_.DATA_FORWARD = true;
-            SimState_.DF_PATH = SimState::DataForwardPaths::EXEC_MEM_RS2;
+            vm_core.sim_state_.DATA_FORWARD = true;
+            vm_core.sim_state_.DF_PATH = SimState::DataForwardPaths::EXEC_MEM_RS2;
             rs2_updated = true;
 
             if(id_instruction.rs2_from_fprf)
@@ -147,16 +151,16 @@ bool HazardDetector::DetectDataHazardWithForwarding(PipelinedCore& vm_core){
     }
 
     if(!mem_instruction.nopped && mem_instruction.reg_write){  // checking if the mem instruction changes the register file
-        bool id_rs1__mem_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == mem_instruction.rd) && (id_instruction.rs1_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 && !id_instruction.rs1_from_fprf);
-        bool id_rs2__mem_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == mem_instruction.rd) && (id_instruction.rs2_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 && !id_instruction.rs2_from_fprf);
+        bool id_rs1__mem_rd_clash = (id_instruction.uses_rs1) && (id_instruction.rs1 == mem_instruction.rd) && (id_instruction.rs1_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs1 != 0 || id_instruction.rs1_from_fprf);
+        bool id_rs2__mem_rd_clash = (id_instruction.uses_rs2) && (id_instruction.rs2 == mem_instruction.rd) && (id_instruction.rs2_from_fprf == mem_instruction.reg_write_to_fpr) && (id_instruction.rs2 != 0 || id_instruction.rs2_from_fprf);
         bool id_rs3__mem_rd_clash = (id_instruction.uses_rs3) && (id_instruction.frs3 == mem_instruction.rd) && (mem_instruction.reg_write_to_fpr);
 
         if(id_rs1__mem_rd_clash && !rs1_updated){
-            if(SimState_.DATA_FORWARD){
-                SimState_.DF_ALL = true;
+            if(vm_core.sim_state_.DATA_FORWARD){
+                vm_core.sim_state_.DF_ALL = true;
             }
-            SimState_.DATA_FORWARD = true;
-            SimState_.DF_PATH = SimState::DataForwardPaths::MEM_WB_RS1;
+            vm_core.sim_state_.DATA_FORWARD = true;
+            vm_core.sim_state_.DF_PATH = SimState::DataForwardPaths::MEM_WB_RS1;
 
             if(id_instruction.rs1_from_fprf)
                 id_instruction.frs1_value = mem_instruction.mem_to_reg ? mem_instruction.mem_out : mem_instruction.alu_out;
@@ -165,11 +169,11 @@ bool HazardDetector::DetectDataHazardWithForwarding(PipelinedCore& vm_core){
         }
 
         if(id_rs2__mem_rd_clash && !rs2_updated){
-            if(SimState_.DATA_FORWARD){
-                SimState_.DF_ALL = true;
+            if(vm_core.sim_state_.DATA_FORWARD){
+                vm_core.sim_state_.DF_ALL = true;
             }
-            SimState_.DATA_FORWARD = true;
-            SimState_.DF_PATH = SimState::DataForwardPaths::MEM_WB_RS2;
+            vm_core.sim_state_.DATA_FORWARD = true;
+            vm_core.sim_state_.DF_PATH = SimState::DataForwardPaths::MEM_WB_RS2;
 
             if(id_instruction.rs2_from_fprf)
                 id_instruction.frs2_value = mem_instruction.mem_to_reg ? mem_instruction.mem_out : mem_instruction.alu_out;
@@ -186,22 +190,29 @@ bool HazardDetector::DetectDataHazardWithForwarding(PipelinedCore& vm_core){
 }
 
 
+template<bool kBranchPrediction>
 void HazardDetector::HandleDataHazard(PipelinedCore& vm_core){
     vm_core.SetProgramCounter(vm_core.GetIfInstruction().pc);
 
-    std::deque<PipelinedInstrContext> new_instruction_deque;
-    new_instruction_deque.push_back(vm_core.GetIfInstruction());
-    new_instruction_deque.push_back(vm_core.GetIdInstruction());
-    PipelinedInstrContext bubble;
+    // the instruction in IF is fetched (and predicted) again
+    if(kBranchPrediction && !vm_core.GetIfInstruction().nopped){
+        vm_core.branch_predictor_.Restore(vm_core.GetIfInstruction().branch_prediction);
+    }
+
+    // IF and ID stay, a bubble goes into EX, EX and MEM move on and WB is dropped
+    PipelinedInstrContext& if_instruction = vm_core.ShiftLatches();
+    if_instruction = vm_core.GetIdInstruction();
+    PipelinedInstrContext& id_instruction = vm_core.GetIdInstruction();
+    id_instruction = vm_core.GetExInstruction();
+    PipelinedInstrContext& bubble = vm_core.GetExInstruction();
+    bubble = PipelinedInstrContext{};
     bubble.nopify();
     bubble.bubbled = true;
-    new_instruction_deque.push_back(bubble);
-    new_instruction_deque.push_back(vm_core.GetExInstruction());
-    new_instruction_deque.push_back(vm_core.GetMemInstruction());
-
-    vm_core.instruction_deque_ = new_instruction_deque;
 }
 
+template void HazardDetector::HandleDataHazard<false>(PipelinedCore& vm_core);
+template void HazardDetector::HandleDataHazard<true>(PipelinedCore& vm_core);
+
 
 bool HazardDetector::DetectControlHazard(PipelinedCore& vm_core){
     PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
@@ -219,21 +230,26 @@ bool HazardDetector::DetectControlHazard(PipelinedCore& vm_core){
     */
     // return ex_instruction.branch && (ex_instruction.branch_predicted_taken != ex_instruction.branch_taken) && (ex_instruction.immediate != 4);
 
-    return ex_instruction.branch && (ex_instruction.branch_predicted_taken != ex_instruction.branch_taken);
+    return ex_instruction.branch && ex_instruction.branch_mispredicted;
 }
 
 
+template<bool kBranchPrediction>
 void HazardDetector::HandleControlHazard(PipelinedCore& vm_core){
     PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
 
-    if(vm_core.branch_prediction_enabled_ && !ex_instruction.branch_jalr){
-        vm_core.branch_predictor_.update_btb(ex_instruction.pc, ex_instruction.branch_taken, ex_instruction.pc + ex_instruction.immediate);
+    // the predictor was trained in ResolveBranch(), only the return address stack still holds the wrong path
+    if constexpr (kBranchPrediction){
+        vm_core.branch_predictor_.Recover(ex_instruction.pc, ex_instruction.instruction, ex_instruction.branch_prediction);
     }
-    
+
     PipelinedInstrContext& if_instruction = vm_core.GetIfInstruction();
     if_instruction.nopify();
     PipelinedInstrContext& id_instruction = vm_core.GetIdInstruction();
     id_instruction.nopify();
 }
 
+template void HazardDetector::HandleControlHazard<false>(PipelinedCore& vm_core);
+template void HazardDetector::HandleControlHazard<true>(PipelinedCore& vm_core);
+
 } // namespace rv5s
\ No newline at end of file
@@ -11,7 +11,7 @@ void PipelinedStages::Decode(PipelinedCore& vm_core){
 	if(id_instruction.nopped)
 		return;
 	
-	vm_core.decode_unit_.DecodeInstruction(id_instruction, vm_core.register_file_);
+	vm_core.decode_unit_.DecodeInstruction(id_instruction, vm_core.register_file_, vm_core.memory_controller_.GetPredecodeTable());
 
 	if (id_instruction.opcode == get_instr_encoding(Instruction::kecall).opcode && 
 		id_instruction.funct3 == get_instr_encoding(Instruction::kecall).funct3) {
@@ -21,7 +21,7 @@ void PipelinedStages::Decode(PipelinedCore& vm_core){
 }
 
 void PipelinedStages::HandleSyscall(PipelinedCore& vm_core){
-    globals::vm_cout_file << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
+    vm_core.Log() << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
     return;
 }
 
@@ -3,6 +3,7 @@
 
 namespace rv5s{
 
+template<bool kBranchPrediction>
 void PipelinedStages::Execute(PipelinedCore& vm_core) {
     PipelinedInstrContext& ex_instruction = vm_core.GetExInstruction();
 	if(ex_instruction.nopped)
@@ -22,9 +23,13 @@ void PipelinedStages::Execute(PipelinedCore& vm_core) {
 
 	// branch cheking
 	if (ex_instruction.branch)
-		ResolveBranch(vm_core);
+		ResolveBranch<kBranchPrediction>(vm_core);
 }
 
+template void PipelinedStages::Execute<false>(PipelinedCore& vm_core);
+template void PipelinedStages::Execute<true>(PipelinedCore& vm_core);
+
+template<bool kBranchPrediction>
 void PipelinedStages::ResolveBranch(PipelinedCore& vm_core){
     using instruction_set::Instruction;
     using instruction_set::get_instr_encoding;
@@ -35,29 +40,19 @@ void PipelinedStages::ResolveBranch(PipelinedCore& vm_core){
 	uint8_t& opcode = ex_instruction.opcode;
 	uint8_t& funct3 = ex_instruction.funct3;
 
+	bool branch_flag = false;
+	uint64_t target = ex_instruction.pc + ex_instruction.immediate;
+
 	if (opcode==get_instr_encoding(Instruction::kjalr).opcode || 
 			opcode==get_instr_encoding(Instruction::kjal).opcode) {
+		branch_flag = true;
 
-		// updating branch_taken status
-		ex_instruction.branch_taken = true;
-		
-		// if branch was already taken, we skip updating the pc
-		if(ex_instruction.branch_predicted_taken)
-			return;
-
-		vm_core.core_stats_.branch_mispredicts++;
-		
 		if (opcode==get_instr_encoding(Instruction::kjalr).opcode) { 
-			vm_core.SetProgramCounter(ex_instruction.alu_out);
-		}
-		else if (opcode==get_instr_encoding(Instruction::kjal).opcode) {
-			vm_core.SetProgramCounter(ex_instruction.pc + ex_instruction.immediate);
+			target = ex_instruction.alu_out;
 		}
 
 		// storing the current value of pc for returning (storing it in rd)
 		ex_instruction.alu_out = ex_instruction.pc + 4;
-
-		return;
 	}
 	else if (opcode==get_instr_encoding(Instruction::kbeq).opcode ||
 				opcode==get_instr_encoding(Instruction::kbne).opcode ||
@@ -66,7 +61,6 @@ void PipelinedStages::ResolveBranch(PipelinedCore& vm_core){
 				opcode==get_instr_encoding(Instruction::kbltu).opcode ||
 				opcode==get_instr_encoding(Instruction::kbgeu).opcode) {
 		
-		bool branch_flag = false;
 		switch (funct3) {
 			case 0b000: {// BEQ
 				branch_flag = (ex_instruction.alu_out==0);
@@ -93,31 +87,30 @@ void PipelinedStages::ResolveBranch(PipelinedCore& vm_core){
 				break;
 			}
 		}
+	}
+	else {
+		return;
+	}
 
-		if (branch_flag) {
-			// Updating branch_taken status
-			ex_instruction.branch_taken = true;
+	// Updating branch_taken status
+	ex_instruction.branch_taken = branch_flag;
 
-			// if branch was predicted taken, we skip updating pc
-			if(ex_instruction.branch_predicted_taken)
-				return;
-			
-			vm_core.core_stats_.branch_mispredicts++;
+	if constexpr (kBranchPrediction){
+		vm_core.branch_predictor_.Update(ex_instruction.pc, ex_instruction.instruction, branch_flag, target,
+			ex_instruction.branch_prediction);
+	}
 
-			// // Subtracting 4 from pc (updated in Fetch())
-			// vm_core.AddToProgramCounter(-4);
-			// vm_core.AddToProgramCounter(ex_instruction.immediate);
+	// a taken prediction has to have gone to the right place as well, jalr targets come from the RAS or the BTB
+	ex_instruction.branch_mispredicted = branch_flag!=ex_instruction.branch_predicted_taken
+		|| (branch_flag && ex_instruction.branch_prediction.target!=target);
+	if(!ex_instruction.branch_mispredicted)
+		return;
 
-			vm_core.SetProgramCounter(ex_instruction.pc + ex_instruction.immediate);
-		}
-		else{
-			// branch was incorrectly predicted, need to set the pc to pc+4
-			if(ex_instruction.branch_predicted_taken){
-				vm_core.core_stats_.branch_mispredicts++;
-				vm_core.SetProgramCounter(ex_instruction.pc + 4);
-			}
-		}
-	}
+	vm_core.core_stats_.branch_mispredicts++;
+	vm_core.core_stats_.mispredicts.Count(ex_instruction.branch_prediction.component);
+	vm_core.profile_.Mispredict(ex_instruction.pc);
+
+	vm_core.SetProgramCounter(branch_flag ? target : ex_instruction.pc + 4);
 }
 
 
@@ -190,6 +183,10 @@ void PipelinedStages::ExecuteDouble(PipelinedCore& vm_core){
 
 	int32_t imm = ex_instruction.immediate;
 
+	if (rm==0b111) {
+		rm = vm_core.register_file_.ReadCsr(0x002);
+	}
+
 	uint64_t reg1_value = ex_instruction.frs1_value;
 	uint64_t reg2_value = ex_instruction.frs2_value;
 	uint64_t reg3_value = ex_instruction.frs3_value;
@@ -2,29 +2,19 @@
 
 namespace rv5s {
 
+template<bool kBranchPrediction>
 void PipelinedStages::Fetch(PipelinedCore& vm_core){
     PipelinedInstrContext& if_instruction = vm_core.GetIfInstruction();
 	if(if_instruction.nopped)
 		return;
 	if_instruction.pc = vm_core.program_counter_;
-  	if_instruction.instruction = vm_core.memory_controller_.ReadWord(vm_core.program_counter_);
+  	if_instruction.instruction = vm_core.memory_controller_.FetchWord(vm_core.program_counter_);
 	if_instruction.branch_predicted_taken = false;
 
-	if(vm_core.branch_prediction_enabled_){
-		if(vm_core.branch_prediction_static_){
-			auto [take_branch, new_pc] = vm_core.branch_predictor_.static_predict(vm_core.program_counter_);
-			vm_core.SetProgramCounter(new_pc);
-			if(take_branch){
-				if_instruction.branch_predicted_taken = true;
-			}
-		}
-		else{
-			auto [take_branch, new_pc] = vm_core.branch_predictor_.dynamic_predict(vm_core.program_counter_);
-			vm_core.SetProgramCounter(new_pc);
-			if(take_branch){
-				if_instruction.branch_predicted_taken = true;
-			}
-		}
+	if constexpr (kBranchPrediction){
+		if_instruction.branch_prediction = vm_core.branch_predictor_.Predict(if_instruction.pc, if_instruction.instruction);
+		if_instruction.branch_predicted_taken = if_instruction.branch_prediction.taken;
+		vm_core.SetProgramCounter(if_instruction.branch_prediction.target);
 	}
 	// no branch prediction, we go with the flow.
 	// if the branch was taken, we flush the 2 cycles
@@ -33,4 +23,7 @@ void PipelinedStages::Fetch(PipelinedCore& vm_core){
 	}
 }
 
+template void PipelinedStages::Fetch<false>(PipelinedCore& vm_core);
+template void PipelinedStages::Fetch<true>(PipelinedCore& vm_core);
+
 } // namespace rv5s
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 namespace rv5s{
 
+template<bool kDebug>
 void PipelinedStages::MemoryAccess(PipelinedCore& vm_core){
     PipelinedInstrContext& mem_instruction = vm_core.GetMemInstruction();
 	if(mem_instruction.nopped)
@@ -26,11 +27,7 @@ void PipelinedStages::MemoryAccess(PipelinedCore& vm_core){
 	if (mem_instruction.mem_read) {
 		uint64_t& mem_out = mem_instruction.mem_out;
 		uint64_t& address = mem_instruction.alu_out;
-		mem_out = 0;
-
-		for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-			mem_out += vm_core.memory_controller_.ReadByte(address+i) << (i*8);
-		}
+		mem_out = vm_core.memory_controller_.ReadData(address, mem_instruction.mem_access_bytes);
 		
 		if(mem_instruction.sign_extend){
 			mem_out = sign_extend(mem_out, mem_instruction.mem_access_bytes*8);
@@ -46,16 +43,15 @@ void PipelinedStages::MemoryAccess(PipelinedCore& vm_core){
 			mem_instruction.rs2_value :
 			mem_instruction.frs2_value;
 					
-		if(vm_core.debug_mode_){
-			for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-				mem_instruction.mem_overwritten.push_back(vm_core.memory_controller_.ReadByte(address+i));
-			}
+		if constexpr (kDebug){
+			vm_core.undo_records_[mem_instruction.seq].mem_overwritten = vm_core.memory_controller_.ReadSized(address, mem_instruction.mem_access_bytes);
 		}
 
-		for(size_t i=0;i<mem_instruction.mem_access_bytes;i++){
-			vm_core.memory_controller_.WriteByte(address + i, 0xFF & (write_data >> (i*8)));
-		}
+		vm_core.memory_controller_.WriteData(address, mem_instruction.mem_access_bytes, write_data);
 	}
 }
 
+template void PipelinedStages::MemoryAccess<false>(PipelinedCore& vm_core);
+template void PipelinedStages::MemoryAccess<true>(PipelinedCore& vm_core);
+
 } // namespace rv5s
\ No newline at end of file
@@ -3,22 +3,24 @@
 
 namespace rv5s{
 
+template<bool kDebug>
 void PipelinedStages::WriteBack(PipelinedCore& vm_core){
     PipelinedInstrContext& wb_instruction = vm_core.GetWbInstruction();
 	if(wb_instruction.nopped)
 		return;
 
 	vm_core.core_stats_.instrs_retired++;
+	vm_core.profile_.Retire(wb_instruction.pc);
 
 	if (wb_instruction.opcode==0b1110011) { // CSR opcode
-		WriteBackCsr(vm_core);
+		WriteBackCsr<kDebug>(vm_core);
 		return;
 	}
 
 	// fcsr update
-	if(wb_instruction.csr_overwritten){
-		if(vm_core.debug_mode_){
-			wb_instruction.csr_overwritten = vm_core.register_file_.ReadCsr(0x003);
+	if(wb_instruction.fcsr_update){
+		if constexpr (kDebug){
+			vm_core.undo_records_[wb_instruction.seq].fcsr_overwritten = vm_core.register_file_.ReadCsr(0x003);
 		}
 		vm_core.register_file_.WriteCsr(0x003, wb_instruction.fcsr_status);
 	}
@@ -30,20 +32,24 @@ void PipelinedStages::WriteBack(PipelinedCore& vm_core){
 		wb_instruction.alu_out;
 		
 	if(wb_instruction.reg_write_to_fpr){
-		if(vm_core.debug_mode_){
-			wb_instruction.reg_overwritten = vm_core.register_file_.ReadFpr(wb_instruction.rd);
+		if constexpr (kDebug){
+			vm_core.undo_records_[wb_instruction.seq].reg_overwritten = vm_core.register_file_.ReadFpr(wb_instruction.rd);
 		}
 		vm_core.register_file_.WriteFpr(wb_instruction.rd, write_data);
 	}
 	else{
-		if(vm_core.debug_mode_){
-			wb_instruction.reg_overwritten = vm_core.register_file_.ReadGpr(wb_instruction.rd);
+		if constexpr (kDebug){
+			vm_core.undo_records_[wb_instruction.seq].reg_overwritten = vm_core.register_file_.ReadGpr(wb_instruction.rd);
 		}
 		vm_core.register_file_.WriteGpr(wb_instruction.rd, write_data);
 	}
 }
 
+template void PipelinedStages::WriteBack<false>(PipelinedCore& vm_core);
+template void PipelinedStages::WriteBack<true>(PipelinedCore& vm_core);
 
+
+template<bool kDebug>
 void PipelinedStages::WriteBackCsr(PipelinedCore& vm_core){
     using instruction_set::get_instr_encoding;
     using instruction_set::Instruction;
@@ -57,10 +63,11 @@ void PipelinedStages::WriteBackCsr(PipelinedCore& vm_core){
 	uint64_t& csr_write_val_ = wb_instruction.csr_write_val;
 	uint8_t& csr_uimm_ = wb_instruction.csr_uimm;
 
-	if(vm_core.debug_mode_){
-		wb_instruction.is_csr_overwritten = true;
-		wb_instruction.csr_overwritten = csr_old_value_;
-		wb_instruction.reg_overwritten = vm_core.register_file_.ReadGpr(rd);
+	if constexpr (kDebug){
+		UndoRecord& undo_record = vm_core.undo_records_[wb_instruction.seq];
+		undo_record.is_csr_overwritten = true;
+		undo_record.csr_overwritten = csr_old_value_;
+		undo_record.reg_overwritten = vm_core.register_file_.ReadGpr(rd);
 	}
 
 	switch (funct3) {
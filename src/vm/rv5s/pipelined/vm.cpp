@@ -2,53 +2,83 @@
 
 namespace rv5s{
 
-PipelinedVM::PipelinedVM(){
+PipelinedVM::PipelinedVM(const vm_config::VmConfig& config){
+    vm_core_.config_ = config;
     LoadVM();
 }
 
 void PipelinedVM::Reset(){
+    BumpGeneration();
     vm_core_.Reset();
     program_ = AssembledProgram{};
 }
 
 void PipelinedVM::LoadVM(AssembledProgram program){
+    BumpGeneration();
     program_ = program;
     vm_core_.Load(program_);
+    PipelinedExecutor::Specialize(vm_core_);
 }
 
 void PipelinedVM::LoadVM(){
+    BumpGeneration();
     vm_core_.Load();
+    PipelinedExecutor::Specialize(vm_core_);
 }
 
 void PipelinedVM::Run(){
-    vm_core_.debug_mode_ = false;
+    BumpGeneration();
     vm_core_.is_stop_requested_ = false;
 
+    host_profile::RunTimer run_timer(vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired);
     PipelinedExecutor::RunPipelined(vm_core_);
+    vm_core_.trace_.Flush();
+    run_timer.Stop(vm_core_.host_profile_, vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired, vm_core_.Log());
 }
 
 void PipelinedVM::DebugRun(){
-    vm_core_.debug_mode_ = true;
+    BumpGeneration();
     vm_core_.is_stop_requested_ = false;
 
-    PipelinedExecutor::DebugRunPipelined(vm_core_);
+    PipelinedExecutor::DebugRunPipelined(vm_core_, [this] { return AfterDebugStep(vm_core_.config_.getRunStepDelay()); });
+    vm_core_.trace_.Flush();
 }
 
 void PipelinedVM::Step(){
-    vm_core_.debug_mode_ = true;
+    BumpGeneration();
     vm_core_.is_stop_requested_ = false;
 
     PipelinedExecutor::StepPipelined(vm_core_);
-    vm_core_.core_stats_.cycles++;
 }
 
 void PipelinedVM::Undo(){
-    vm_core_.debug_mode_ = true;
+    BumpGeneration();
     vm_core_.is_stop_requested_ = false;
 
     PipelinedExecutor::UndoPipelined(vm_core_);
 }
 
+void PipelinedVM::SetBreakpoints(const std::vector<uint64_t>& pcs){
+    vm_core_.breakpoints_ = pcs;
+}
+
+void PipelinedVM::RequestStop(){
+    vm_core_.stop_requested_ = true;
+}
+
+void PipelinedVM::ClearStop(){
+    vm_core_.ClearStop();
+}
+
+bool PipelinedVM::ProgramEnded(){
+    return vm_core_.ProgramEnded();
+}
+
+uint64_t PipelinedVM::FastForward(uint64_t num_instrs){
+    BumpGeneration();
+    return PipelinedExecutor::FastForwardPipelined(vm_core_, num_instrs);
+}
+
 uint64_t PipelinedVM::ReadMemDoubleWord(uint64_t address){
     return vm_core_.memory_controller_.ReadDoubleWord(address);
 }
@@ -61,21 +91,17 @@ const std::array<uint64_t, 32>& PipelinedVM::GetFprValues(){
 }
 
 std::vector<uint64_t> PipelinedVM::GetInstructionPCs(){
-    return {vm_core_.instruction_deque_[0].pc, vm_core_.instruction_deque_[1].pc, vm_core_.instruction_deque_[2].pc, vm_core_.instruction_deque_[3].pc, vm_core_.instruction_deque_[4].pc};
+    return {vm_core_.GetIfInstruction().pc, vm_core_.GetIdInstruction().pc, vm_core_.GetExInstruction().pc, vm_core_.GetMemInstruction().pc, vm_core_.GetWbInstruction().pc};
 }
 
 
-VmBase::InstrView PipelinedVM::GetInstructions() {
-    std::vector<std::unique_ptr<const InstrContext>> result;
-    result.push_back(std::make_unique<const PipelinedInstrContext>(vm_core_.GetIfInstruction()));
-    result.push_back(std::make_unique<const PipelinedInstrContext>(vm_core_.GetIdInstruction()));
-    result.push_back(std::make_unique<const PipelinedInstrContext>(vm_core_.GetExInstruction()));
-    result.push_back(std::make_unique<const PipelinedInstrContext>(vm_core_.GetMemInstruction()));
-    result.push_back(std::make_unique<const PipelinedInstrContext>(vm_core_.GetWbInstruction()));
-
-    InstrView ret;
-    ret.pipeline = std::move(result);
-    return ret;
+void PipelinedVM::FillPipelineSnapshot(PipelineSnapshot& snapshot){
+    using Section = PipelineSnapshot::Section;
+    snapshot.Push(Section::kPipeline, vm_core_.GetIfInstruction());
+    snapshot.Push(Section::kPipeline, vm_core_.GetIdInstruction());
+    snapshot.Push(Section::kPipeline, vm_core_.GetExInstruction());
+    snapshot.Push(Section::kPipeline, vm_core_.GetMemInstruction());
+    snapshot.Push(Section::kPipeline, vm_core_.GetWbInstruction());
 }
 
 bool PipelinedVM::ForwardingEnabled(){
@@ -90,4 +116,29 @@ VmBase::Stats& PipelinedVM::GetStats(){
     return vm_core_.GetStats();
 }
 
+const pc_profile::PcProfile& PipelinedVM::GetProfile(){
+    return vm_core_.profile_;
+}
+
+const host_profile::HostProfile& PipelinedVM::GetHostProfile(){
+    return vm_core_.host_profile_;
+}
+
+std::pair<cache::CacheStats, cache::CacheStats> PipelinedVM::GetCacheStats(){
+    return {vm_core_.memory_controller_.GetICacheStats(), vm_core_.memory_controller_.GetDCacheStats()};
+}
+
+void PipelinedVM::DumpCache(){
+    vm_core_.memory_controller_.PrintCacheStatus(vm_core_.Log());
+    vm_core_.memory_controller_.DumpCache(vm_core_.Log());
+}
+
+void PipelinedVM::SetLog(std::ostream& log){
+    vm_core_.SetLog(log);
+}
+
+SimState& PipelinedVM::GetSimState(){
+    return vm_core_.sim_state_;
+}
+
 } // namespace rv5s
\ No newline at end of file
@@ -23,24 +23,35 @@ void SingleCycleCore::ClearStop(){
     stop_requested_ = false;
 }
 
+bool SingleCycleCore::ProgramEnded() const{
+    return program_counter_ >= program_size_;
+}
+
+void SingleCycleCore::SetLog(std::ostream& log){
+	log_ = &log;
+	fast_forward_engine_.SetLog(log);
+}
+
 void SingleCycleCore::Reset(){
     this->program_counter_ = 0;
 	this->register_file_.Reset();
+	this->memory_controller_.SetCacheConfigs(config_.icache_config, config_.dcache_config);
 	this->memory_controller_.Reset();
 	// assert(instruction_deque_.size()==5);
 
 	undo_instruction_stack_.clear();
+	next_seq_ = 0;
 	
     this->instr.reset_id_vars();
 
-	core_stats_.cycles= 0;
-	core_stats_.instrs_retired = 0;
-	core_stats_.branch_mispredicts = 0;
-	core_stats_.branch_instrs= 0;
+	core_stats_ = VmBase::Stats{};
+	profile_.Resize(program_size_);
+	host_profile_.Reset();
 }
 
 void SingleCycleCore::Load(AssembledProgram& program){
     Reset();
+    undo_records_.Reserve(max_undo_stack_size_ + 1);
 
     // Loading the instructions (machine code) into memory
 	unsigned int counter = 0;
@@ -49,11 +60,14 @@ void SingleCycleCore::Load(AssembledProgram& program){
 		counter += 4;
 	}
 	this->program_size_ = counter;
+	this->memory_controller_.SetTextSize(program_size_);
+	this->profile_.Resize(program_size_);
+	this->trace_.Open(config_.trace_config);
 
 
     // Loading data section into memory
     unsigned int data_counter = 0;
-	uint64_t base_data_address = vm_config::config.getDataSectionStart();
+	uint64_t base_data_address = config_.getDataSectionStart();
 
 	auto align = [&](unsigned int alignment) {
 		if (data_counter % alignment != 0)
@@ -3,45 +3,63 @@
 namespace rv5s{
 
 void SingleCycleExecutor::RunSingleCycle(SingleCycleCore& vm_core){
-	vm_core.ClearStop();
+	// without caches every instruction is one cycle, the functional engine gives the same state and stats (but
+	// no trace)
+	if (!vm_core.memory_controller_.CachesEnabled() && !vm_core.trace_.Enabled()) {
+		std::vector<uint64_t> retired_at(vm_core.program_size_ / 4);
+		uint64_t retired = FastForwardSingleCycle(vm_core, vm_core.config_.getInstructionExecutionLimit(), &retired_at);
+		vm_core.core_stats_.cycles += retired;
+		vm_core.core_stats_.instrs_retired += retired;
+		vm_core.core_stats_.top_down.retiring += retired;
+		for (size_t i = 0; i < retired_at.size(); i++) {
+			if (retired_at[i] != 0)
+				vm_core.profile_.Add(i * 4, pc_profile::PcCounters{retired_at[i], retired_at[i], 0, 0});
+		}
+
+		if (vm_core.program_counter_ >= vm_core.program_size_) {
+			vm_core.Log() << "Vm : Program Has Ended!" << std::endl;
+		}
+		return;
+	}
+
 	uint64_t instruction_executed = 0;
 
 	while (!vm_core.stop_requested_ && vm_core.program_counter_ < vm_core.program_size_) {
-		if (instruction_executed > vm_config::config.getInstructionExecutionLimit())
+		if (instruction_executed > vm_core.config_.getInstructionExecutionLimit())
 		    break;
 		
         StepSingleCycle(vm_core, false);
 
 		instruction_executed++;
-		globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
 	}
 
 	if (vm_core.program_counter_ >= vm_core.program_size_) {
-		globals::vm_cout_file << "Vm : Program Has Ended!" << std::endl;
+		vm_core.Log() << "Vm : Program Has Ended!" << std::endl;
 	}
 }
 
 
-void SingleCycleExecutor::DebugRunSingleCycle(SingleCycleCore& vm_core){
-    vm_core.ClearStop();
-
+void SingleCycleExecutor::DebugRunSingleCycle(SingleCycleCore& vm_core, const std::function<bool()>& after_step){
     uint64_t instruction_executed = 0;
     while (!vm_core.stop_requested_ && vm_core.program_counter_ < vm_core.program_size_) {
-        if (instruction_executed > vm_config::config.getInstructionExecutionLimit())
+        if (instruction_executed >= vm_core.config_.getInstructionExecutionLimit())
             break;
         
-        if (std::find(vm_core.breakpoints_.begin(), vm_core.breakpoints_.end(), vm_core.program_counter_) == vm_core.breakpoints_.end()) {
+        // the first step always runs, so a run started at a breakpoint gets past it
+        if (instruction_executed == 0 || std::find(vm_core.breakpoints_.begin(), vm_core.breakpoints_.end(), vm_core.program_counter_) == vm_core.breakpoints_.end()) {
             StepSingleCycle(vm_core, false);
-            unsigned int delay_ms = vm_config::config.getRunStepDelay();
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+            instruction_executed++;
+            vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
+            if (!after_step())
+                break;
         }        
         else {
-            globals::vm_cout_file << " Breakpoint was hit. pc : " << vm_core.program_counter_ << std::endl;
+            vm_core.Log() << " Breakpoint was hit. pc : " << vm_core.program_counter_ << std::endl;
             break;
         }
     }
     if (vm_core.program_counter_ >= vm_core.program_size_) {
-        globals::vm_cout_file << "VM : Program Has Ended" << std::endl;
+        vm_core.Log() << "VM : Program Has Ended" << std::endl;
     }
 
     // DumpRegisters(globals::registers_dump_file_path, registers_);
@@ -51,23 +69,52 @@ void SingleCycleExecutor::DebugRunSingleCycle(SingleCycleCore& vm_core){
 
 
 void SingleCycleExecutor::StepSingleCycle(SingleCycleCore& vm_core, bool dump){
+    HOST_PROFILE_SCOPE(vm_core.host_profile_, Cycle);
+    pc_profile::CycleCharge charge;
 
     if (vm_core.program_counter_ < vm_core.program_size_) {
 
         // Fetch
-		SingleCycleStages::Fetch(vm_core);
+		{
+			HOST_PROFILE_SCOPE(vm_core.host_profile_, Fetch);
+			SingleCycleStages::Fetch(vm_core);
+		}
 
 		// Decode
-		SingleCycleStages::Decode(vm_core);
+		{
+			HOST_PROFILE_SCOPE(vm_core.host_profile_, Decode);
+			SingleCycleStages::Decode(vm_core);
+		}
 
 		// Execute
-		SingleCycleStages::Execute(vm_core);
+		{
+			HOST_PROFILE_SCOPE(vm_core.host_profile_, Execute);
+			SingleCycleStages::Execute(vm_core);
+		}
 
 		// MemoryAccess
-		SingleCycleStages::MemoryAccess(vm_core);
+		{
+			HOST_PROFILE_SCOPE(vm_core.host_profile_, Memory);
+			SingleCycleStages::MemoryAccess(vm_core);
+		}
 
 		// WriteBack
-		SingleCycleStages::WriteBack(vm_core);
+		{
+			HOST_PROFILE_SCOPE(vm_core.host_profile_, WriteBack);
+			SingleCycleStages::WriteBack(vm_core);
+		}
+
+		// the only slot of the cycle, taken by the instruction that retired
+		vm_core.core_stats_.top_down.retiring++;
+		charge.pc = vm_core.instr.pc;
+		charge.charged = true;
+
+		// every stage is in this cycle
+		uint64_t cycle = vm_core.core_stats_.cycles;
+		if (vm_core.trace_.InWindow(cycle)) {
+			vm_core.trace_.Record(cycle, pipeline_trace::Stage::Fetch, vm_core.instr.seq, vm_core.instr.pc);
+			vm_core.trace_.Record(cycle, pipeline_trace::Stage::Commit, vm_core.instr.seq, vm_core.instr.pc);
+		}
 
         // Debug Store
         if(vm_core.debug_mode_){
@@ -81,61 +128,81 @@ void SingleCycleExecutor::StepSingleCycle(SingleCycleCore& vm_core, bool dump){
     }
     else{
         if(dump){
-            globals::vm_cout_file << "Vm : Program Has ended!" << std::endl;
+            vm_core.Log() << "Vm : Program Has ended!" << std::endl;
             return;
         }
+        vm_core.core_stats_.top_down.frontend_bound++;
     }
     
     if(dump){
-        globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
-        globals::vm_cout_file << "Step completed!" << std::endl;
+        vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
+        vm_core.Log() << "Step completed!" << std::endl;
         // DumpRegisters(globals::registers_dump_file_path, registers_);
         // DumpState(globals::vm_state_dump_file_path);
     }  
 
-    vm_core.core_stats_.cycles++;
+    // cache misses stall the whole datapath
+    memory_controller::StallCycles stalls = vm_core.memory_controller_.TakeStallCycles();
+    vm_core.core_stats_.AddCycle(1, stalls);
+
+    charge.cycles = 1 + stalls.Total();
+    charge.stall_cycles = stalls.Total();
+    vm_core.profile_.Charge(charge);
 }
 
 
 void SingleCycleExecutor::UndoSingleCycle(SingleCycleCore& vm_core){
     if (vm_core.undo_instruction_stack_.empty()) {
-        globals::vm_cout_file << "VM : Cannot undo." << std::endl;
+        vm_core.Log() << "VM : Cannot undo." << std::endl;
         return;
     }
 
     SingleCycleInstrContext last_instruction = vm_core.undo_instruction_stack_.front();
     vm_core.undo_instruction_stack_.pop_front();
 
+    const UndoRecord& undo_record = vm_core.undo_records_[last_instruction.seq];
+
     // Changes in wb stage:
+    if(last_instruction.fcsr_update){
+        vm_core.register_file_.WriteCsr(0x003, undo_record.fcsr_overwritten);
+    }
     if(last_instruction.reg_write){
-        if(last_instruction.fcsr_update){
-            vm_core.register_file_.WriteCsr(0x003, last_instruction.fcsr_status);
-        }
         if(last_instruction.csr_op){
-            vm_core.register_file_.WriteCsr(last_instruction.csr_rd, last_instruction.csr_overwritten);
-            vm_core.register_file_.WriteGpr(last_instruction.rd, last_instruction.reg_overwritten);
+            vm_core.register_file_.WriteCsr(last_instruction.csr_rd, undo_record.csr_overwritten);
+            vm_core.register_file_.WriteGpr(last_instruction.rd, undo_record.reg_overwritten);
         }
         else if(last_instruction.reg_write_to_fpr){
-            vm_core.register_file_.WriteFpr(last_instruction.rd, last_instruction.reg_overwritten);
+            vm_core.register_file_.WriteFpr(last_instruction.rd, undo_record.reg_overwritten);
         }
         else{
-            vm_core.register_file_.WriteGpr(last_instruction.rd, last_instruction.reg_overwritten);
+            vm_core.register_file_.WriteGpr(last_instruction.rd, undo_record.reg_overwritten);
         }
     }
 
     // Changes in mem Stage:
     if(last_instruction.mem_write){
-        for(size_t i=0;i<last_instruction.mem_access_bytes;i++){
-            vm_core.memory_controller_.WriteByte(last_instruction.alu_out, last_instruction.mem_overwritten[i]);
-        }
+        vm_core.memory_controller_.WriteSized(last_instruction.alu_out, last_instruction.mem_access_bytes, undo_record.mem_overwritten);
     }
 
     vm_core.program_counter_ = last_instruction.pc;
+    vm_core.next_seq_ = last_instruction.seq; // the instruction is fetched again with the same seq
 
-    globals::vm_cout_file << "Program Counter: " << vm_core.program_counter_ << std::endl;
-    globals::vm_cout_file << "VM : Undo Complete!" << std::endl;
+    vm_core.Log() << "Program Counter: " << vm_core.program_counter_ << std::endl;
+    vm_core.Log() << "VM : Undo Complete!" << std::endl;
 
     // DumpRegisters(globals::register_file_dump_file_path, registers_);
     // DumpState(globals::vm_state_dump_file_path);
 }
+
+
+uint64_t SingleCycleExecutor::FastForwardSingleCycle(SingleCycleCore& vm_core, uint64_t num_instrs,
+                                                     std::vector<uint64_t>* retired_at){
+    uint64_t retired = vm_core.fast_forward_engine_.Run(vm_core.program_counter_, num_instrs, vm_core.program_size_,
+                                                        vm_core.register_file_, vm_core.memory_controller_,
+                                                        vm_core.stop_requested_, retired_at);
+
+    // the undo stack cannot step back over instructions it never saw
+    vm_core.undo_instruction_stack_.clear();
+    return retired;
+}
 } // namespace rv5s
@@ -7,7 +7,7 @@ using instruction_set::Instruction;
 using instruction_set::get_instr_encoding;
 
 void SingleCycleStages::Decode(SingleCycleCore& vm_core){
-	vm_core.decode_unit_.DecodeInstruction(vm_core.instr, vm_core.register_file_);
+	vm_core.decode_unit_.DecodeInstruction(vm_core.instr, vm_core.register_file_, vm_core.memory_controller_.GetPredecodeTable());
 
 	if (vm_core.instr.opcode == get_instr_encoding(Instruction::kecall).opcode && 
 		vm_core.instr.funct3 == get_instr_encoding(Instruction::kecall).funct3) {
@@ -17,7 +17,7 @@ void SingleCycleStages::Decode(SingleCycleCore& vm_core){
 }
 
 void SingleCycleStages::HandleSyscall(SingleCycleCore& vm_core){
-    globals::vm_cout_file << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
+    vm_core.Log() << "SYSCALLS ARE CURRENTLY UNDER DEVELOPMENT." << std::endl;
     return;
 }
 
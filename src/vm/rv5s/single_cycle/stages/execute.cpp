@@ -155,6 +155,10 @@ void SingleCycleStages::ExecuteDouble(SingleCycleCore& vm_core){
 
 	int32_t imm = vm_core.instr.immediate;
 
+	if (rm==0b111) {
+		rm = vm_core.register_file_.ReadCsr(0x002);
+	}
+
 	uint64_t reg1_value = vm_core.instr.frs1_value;
 	uint64_t reg2_value = vm_core.instr.frs2_value;
 	uint64_t reg3_value = vm_core.instr.frs3_value;
@@ -5,7 +5,8 @@ namespace rv5s {
 void SingleCycleStages::Fetch(SingleCycleCore& vm_core){
 	vm_core.instr = SingleCycleInstrContext();
 	vm_core.instr.pc = vm_core.program_counter_;
-  	vm_core.instr.instruction = vm_core.memory_controller_.ReadWord(vm_core.program_counter_);
+	vm_core.instr.seq = vm_core.next_seq_++;
+  	vm_core.instr.instruction = vm_core.memory_controller_.FetchWord(vm_core.program_counter_);
 	vm_core.AddToProgramCounter(4);
 }
 
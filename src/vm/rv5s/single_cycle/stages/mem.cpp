@@ -22,11 +22,7 @@ void SingleCycleStages::MemoryAccess(SingleCycleCore& vm_core){
 	if (vm_core.instr.mem_read) {
 		uint64_t& mem_out = vm_core.instr.mem_out;
 		uint64_t& address = vm_core.instr.alu_out;
-		mem_out = 0;
-
-		for(size_t i=0;i<vm_core.instr.mem_access_bytes;i++){
-			mem_out += vm_core.memory_controller_.ReadByte(address+i) << (i*8);
-		}
+		mem_out = vm_core.memory_controller_.ReadData(address, vm_core.instr.mem_access_bytes);
 		
 		if(vm_core.instr.sign_extend){
 			mem_out = sign_extend(mem_out, vm_core.instr.mem_access_bytes*8);
@@ -43,14 +39,10 @@ void SingleCycleStages::MemoryAccess(SingleCycleCore& vm_core){
 			vm_core.instr.frs2_value;
 					
 		if(vm_core.debug_mode_){
-			for(size_t i=0;i<vm_core.instr.mem_access_bytes;i++){
-				vm_core.instr.mem_overwritten.push_back(vm_core.memory_controller_.ReadByte(address+i));
-			}
+			vm_core.undo_records_[vm_core.instr.seq].mem_overwritten = vm_core.memory_controller_.ReadSized(address, vm_core.instr.mem_access_bytes);
 		}
 
-		for(size_t i=0;i<vm_core.instr.mem_access_bytes;i++){
-			vm_core.memory_controller_.WriteByte(address + i, 0xFF & (write_data >> (i*8)));
-		}
+		vm_core.memory_controller_.WriteData(address, vm_core.instr.mem_access_bytes, write_data);
 	}
 }
 
@@ -5,6 +5,7 @@ namespace rv5s{
 
 void SingleCycleStages::WriteBack(SingleCycleCore& vm_core){
 	vm_core.core_stats_.instrs_retired++;
+	vm_core.profile_.Retire(vm_core.instr.pc);
 	
 	if (vm_core.instr.opcode==0b1110011) { // CSR opcode
 		WriteBackCsr(vm_core);
@@ -12,9 +13,9 @@ void SingleCycleStages::WriteBack(SingleCycleCore& vm_core){
 	}
 
 	// fcsr update
-	if(vm_core.instr.csr_overwritten){
+	if(vm_core.instr.fcsr_update){
 		if(vm_core.debug_mode_){
-			vm_core.instr.csr_overwritten = vm_core.register_file_.ReadCsr(0x003);
+			vm_core.undo_records_[vm_core.instr.seq].fcsr_overwritten = vm_core.register_file_.ReadCsr(0x003);
 		}
 		vm_core.register_file_.WriteCsr(0x003, vm_core.instr.fcsr_status);
 	}
@@ -27,13 +28,13 @@ void SingleCycleStages::WriteBack(SingleCycleCore& vm_core){
 		
 	if(vm_core.instr.reg_write_to_fpr){
 		if(vm_core.debug_mode_){
-			vm_core.instr.reg_overwritten = vm_core.register_file_.ReadFpr(vm_core.instr.rd);
+			vm_core.undo_records_[vm_core.instr.seq].reg_overwritten = vm_core.register_file_.ReadFpr(vm_core.instr.rd);
 		}
 		vm_core.register_file_.WriteFpr(vm_core.instr.rd, write_data);
 	}
 	else{
 		if(vm_core.debug_mode_){
-			vm_core.instr.reg_overwritten = vm_core.register_file_.ReadGpr(vm_core.instr.rd);
+			vm_core.undo_records_[vm_core.instr.seq].reg_overwritten = vm_core.register_file_.ReadGpr(vm_core.instr.rd);
 		}
 		vm_core.register_file_.WriteGpr(vm_core.instr.rd, write_data);
 	}
@@ -53,9 +54,10 @@ void SingleCycleStages::WriteBackCsr(SingleCycleCore& vm_core){
 	uint8_t& csr_uimm_ = vm_core.instr.csr_uimm;
 
 	if(vm_core.debug_mode_){
-		vm_core.instr.is_csr_overwritten = true;
-		vm_core.instr.csr_overwritten = csr_old_value_;
-		vm_core.instr.reg_overwritten = vm_core.register_file_.ReadGpr(rd);
+		UndoRecord& undo_record = vm_core.undo_records_[vm_core.instr.seq];
+		undo_record.is_csr_overwritten = true;
+		undo_record.csr_overwritten = csr_old_value_;
+		undo_record.reg_overwritten = vm_core.register_file_.ReadGpr(rd);
 	}
 
 	switch (funct3) {
@@ -2,52 +2,81 @@
 
 namespace rv5s{
 
-SingleCycleVM::SingleCycleVM(){
+SingleCycleVM::SingleCycleVM(const vm_config::VmConfig& config){
+    vm_core_.config_ = config;
     LoadVM();
 }
 
 void SingleCycleVM::Reset(){
+    BumpGeneration();
     vm_core_.Reset();
     program_ = AssembledProgram{};
 }
 
 void SingleCycleVM::LoadVM(AssembledProgram program){
+    BumpGeneration();
     program_ = program;
     vm_core_.Load(program_);
 }
 
 void SingleCycleVM::LoadVM(){
+    BumpGeneration();
     vm_core_.Load();
 }
 
 void SingleCycleVM::Run(){
-    vm_core_.stop_requested_ = false;
+    BumpGeneration();
     vm_core_.debug_mode_ = false;
 
+    host_profile::RunTimer run_timer(vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired);
     SingleCycleExecutor::RunSingleCycle(vm_core_);
+    vm_core_.trace_.Flush();
+    run_timer.Stop(vm_core_.host_profile_, vm_core_.core_stats_.cycles, vm_core_.core_stats_.instrs_retired, vm_core_.Log());
 }
 
 void SingleCycleVM::DebugRun(){
-    vm_core_.stop_requested_ = false;
+    BumpGeneration();
     vm_core_.debug_mode_ = true;
 
-    SingleCycleExecutor::DebugRunSingleCycle(vm_core_);
+    SingleCycleExecutor::DebugRunSingleCycle(vm_core_, [this] { return AfterDebugStep(vm_core_.config_.getRunStepDelay()); });
+    vm_core_.trace_.Flush();
 }
 
 void SingleCycleVM::Step(){
-    vm_core_.stop_requested_ = false;
+    BumpGeneration();
     vm_core_.debug_mode_ = true;
 
     SingleCycleExecutor::StepSingleCycle(vm_core_, true);
 }
 
 void SingleCycleVM::Undo(){
-    vm_core_.stop_requested_ = false;
+    BumpGeneration();
     vm_core_.debug_mode_ = true;
 
     SingleCycleExecutor::UndoSingleCycle(vm_core_);
 }
 
+void SingleCycleVM::SetBreakpoints(const std::vector<uint64_t>& pcs){
+    vm_core_.breakpoints_ = pcs;
+}
+
+void SingleCycleVM::RequestStop(){
+    vm_core_.stop_requested_ = true;
+}
+
+void SingleCycleVM::ClearStop(){
+    vm_core_.ClearStop();
+}
+
+bool SingleCycleVM::ProgramEnded(){
+    return vm_core_.ProgramEnded();
+}
+
+uint64_t SingleCycleVM::FastForward(uint64_t num_instrs){
+    BumpGeneration();
+    return SingleCycleExecutor::FastForwardSingleCycle(vm_core_, num_instrs);
+}
+
 uint64_t SingleCycleVM::ReadMemDoubleWord(uint64_t address){
     return vm_core_.memory_controller_.ReadDoubleWord(address);
 }
@@ -63,17 +92,33 @@ std::vector<uint64_t> SingleCycleVM::GetInstructionPCs(){
     return {vm_core_.program_counter_};
 }
 
-VmBase::InstrView SingleCycleVM::GetInstructions(){
-    std::vector<std::unique_ptr<const InstrContext>> result;
-    result.push_back(std::make_unique<const SingleCycleInstrContext>(vm_core_.instr));
-
-    InstrView ret;
-    ret.pipeline = std::move(result);
-    return ret;
+void SingleCycleVM::FillPipelineSnapshot(PipelineSnapshot& snapshot){
+    snapshot.Push(PipelineSnapshot::Section::kPipeline, vm_core_.instr);
 }
 
 VmBase::Stats& SingleCycleVM::GetStats(){
     return vm_core_.core_stats_;
 }
 
+const pc_profile::PcProfile& SingleCycleVM::GetProfile(){
+    return vm_core_.profile_;
+}
+
+const host_profile::HostProfile& SingleCycleVM::GetHostProfile(){
+    return vm_core_.host_profile_;
+}
+
+std::pair<cache::CacheStats, cache::CacheStats> SingleCycleVM::GetCacheStats(){
+    return {vm_core_.memory_controller_.GetICacheStats(), vm_core_.memory_controller_.GetDCacheStats()};
+}
+
+void SingleCycleVM::DumpCache(){
+    vm_core_.memory_controller_.PrintCacheStatus(vm_core_.Log());
+    vm_core_.memory_controller_.DumpCache(vm_core_.Log());
+}
+
+void SingleCycleVM::SetLog(std::ostream& log){
+    vm_core_.SetLog(log);
+}
+
 } // namespace rv5s
\ No newline at end of file
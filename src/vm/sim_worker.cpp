@@ -0,0 +1,329 @@
+/**
+ * @file sim_worker.cpp
+ * @brief Contains the implementation of the SimWorker.
+ */
+
+#include "vm/sim_worker.h"
+#include "assembler/assembler.h"
+#include "config.h"
+#include "globals.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace sim_worker {
+
+SimWorker::~SimWorker() {
+    Shutdown();
+}
+
+void SimWorker::Start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    // the VM was built before the GUI read vm_state/config.ini
+    vm_.LoadVM();
+    Publish(false);
+    thread_ = std::thread(&SimWorker::ThreadMain, this);
+}
+
+void SimWorker::Shutdown() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    Stop();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        exit_requested_ = true;
+    }
+    queue_cv_.notify_all();
+    thread_.join();
+}
+
+void SimWorker::Post(const command_handler::Command& command) {
+    using command_handler::CommandType;
+
+    if (command.type==CommandType::STOP) {
+        Stop();
+        return;
+    }
+    if (command.type==CommandType::EXIT) {
+        Shutdown();
+        return;
+    }
+    if (command.type==CommandType::GET_MEMORY_POINT) {
+        try {
+            if (!command.args.empty()) {
+                memory_start_ = std::stoull(command.args[0], nullptr, 0);
+            }
+            if (command.args.size() > 1) {
+                memory_rows_ = std::stoull(command.args[1], nullptr, 0);
+            }
+        } catch (const std::exception&) {
+            globals::vm_cout_file << "get_mem_point: invalid address" << std::endl;
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.push_back(PendingCommand{command, stop_epoch_.load(), vm_config::config.getInstructionExecutionLimit(),
+                                        vm_config::config.getRunStepDelay()});
+    }
+    queue_cv_.notify_all();
+}
+
+void SimWorker::Post(command_handler::CommandType type, const std::vector<std::string>& args) {
+    Post(command_handler::Command(type, args));
+}
+
+void SimWorker::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.clear();
+        stop_epoch_++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(vm_mutex_);
+        vm_.RequestStop();
+    }
+    // wakes a debug run sleeping out its step delay
+    queue_cv_.notify_all();
+}
+
+bool SimWorker::Busy() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return running_command_ || !queue_.empty();
+}
+
+SimWorker::SnapshotView SimWorker::AcquireSnapshot() {
+    std::unique_lock<std::mutex> lock(snapshot_mutex_);
+    SimSnapshot& front = snapshots_[front_];
+    return SnapshotView(std::move(lock), front);
+}
+
+void SimWorker::ThreadMain() {
+    while (true) {
+        PendingCommand pending{command_handler::Command(command_handler::CommandType::INVALID, {}), 0};
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return exit_requested_ || !queue_.empty(); });
+            if (exit_requested_) {
+                return;
+            }
+            pending = std::move(queue_.front());
+            queue_.pop_front();
+            running_command_ = true;
+        }
+
+        // a guest fault must not take the thread (and the GUI) down, the VM stays where it faulted
+        try {
+            Execute(pending);
+        } catch (const std::exception& e) {
+            globals::vm_cout_file << "VM error: " << e.what() << std::endl;
+        }
+        Publish(false);
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            running_command_ = false;
+        }
+    }
+}
+
+bool SimWorker::Stopped(uint64_t stop_epoch) const {
+    return stop_epoch_.load()!=stop_epoch;
+}
+
+void SimWorker::Execute(const PendingCommand& pending) {
+    using command_handler::CommandType;
+    const command_handler::Command& command = pending.command;
+
+    // Cleared before the epoch check: a Stop() racing with this either cancels the command here or sets the flag
+    // after it was cleared, so the run still sees it.
+    vm_.ClearStop();
+    if (Stopped(pending.stop_epoch)) {
+        return;
+    }
+
+    switch (command.type) {
+        case CommandType::LOAD: {
+            if (command.args.empty()) {
+                globals::vm_cout_file << "load: no file given" << std::endl;
+                break;
+            }
+            loads_++;
+            try {
+                AssembledProgram program = assemble(command.args[0]);
+                {
+                    std::lock_guard<std::mutex> lock(vm_mutex_);
+                    vm_.LoadVM(program);
+                }
+                program_ = std::make_shared<AssembledProgram>(std::move(program));
+                load_failed_ = false;
+                globals::vm_cout_file << "Assembly successful!" << std::endl << std::endl;
+            } catch (const std::runtime_error& e) {
+                load_failed_ = true;
+                globals::vm_cout_file << "Assembly failed." << std::endl;
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+            break;
+        }
+        case CommandType::MODIFY_CONFIG: {
+            std::lock_guard<std::mutex> lock(vm_mutex_);
+            vm_.LoadVM();
+            break;
+        }
+        case CommandType::RUN: {
+            vm_.Run();
+            break;
+        }
+        case CommandType::DEBUG_RUN: {
+            DebugRun(pending);
+            break;
+        }
+        case CommandType::ADD_BREAKPOINT:
+        case CommandType::REMOVE_BREAKPOINT: {
+            uint64_t pc = 0;
+            try {
+                pc = std::stoull(command.args.at(0), nullptr, 0);
+            } catch (const std::exception&) {
+                globals::vm_cout_file << "breakpoint: invalid address" << std::endl;
+                break;
+            }
+            if (command.type==CommandType::ADD_BREAKPOINT) {
+                vm_.AddBreakpoint(pc);
+            } else {
+                vm_.RemoveBreakpoint(pc);
+            }
+            break;
+        }
+        case CommandType::STEP: {
+            vm_.Step();
+            break;
+        }
+        case CommandType::UNDO: {
+            vm_.Undo();
+            break;
+        }
+        case CommandType::RESET: {
+            vm_.Reset();
+            break;
+        }
+        case CommandType::DUMP_CACHE: {
+            vm_.DumpCache();
+            break;
+        }
+        case CommandType::DUMP_PROFILE: {
+            vm_.DumpProfile();
+            break;
+        }
+        case CommandType::GET_MEMORY_POINT: {
+            // the window was moved in Post(), the publish below picks it up
+            break;
+        }
+        default: {
+            globals::vm_cout_file << "Command not supported by the simulation worker." << std::endl;
+            break;
+        }
+    }
+}
+
+void SimWorker::DebugRun(const PendingCommand& pending) {
+    const uint64_t stop_epoch = pending.stop_epoch;
+
+    // the model steps and checks its breakpoints, the hook publishes and waits out the step delay. A Stop() sets the
+    // model's stop flag and wakes the wait
+    uint64_t steps = 0;
+    vm_.SetDebugStepHook([&] {
+        vm_.GetSimState().LIT_UP = true;
+        if (++steps >= pending.step_limit || Stopped(stop_epoch)) {
+            return false;
+        }
+        if (pending.step_delay_ms==0) {
+            PublishThrottled();
+            return true;
+        }
+
+        // every step is worth a frame when they are this far apart
+        Publish(true);
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        return !queue_cv_.wait_for(lock, std::chrono::milliseconds(pending.step_delay_ms),
+                                   [&] { return exit_requested_ || Stopped(stop_epoch); });
+    });
+
+    try {
+        vm_.DebugRun();
+    } catch (...) {
+        vm_.SetDebugStepHook({});
+        throw;
+    }
+    vm_.SetDebugStepHook({});
+}
+
+void SimWorker::PublishThrottled() {
+    if (std::chrono::steady_clock::now() - last_publish_ >= kPublishInterval) {
+        Publish(true);
+    }
+}
+
+void SimWorker::Publish(bool busy) {
+    // only this thread writes front_, and the GUI never looks at the back buffer
+    SimSnapshot& back = snapshots_[1 - front_];
+
+    back.busy = busy;
+    back.type = vm_.GetType();
+    back.pipelining_enabled = vm_.PipeliningEnabled();
+    back.forwarding_enabled = vm_.ForwardingEnabled();
+    back.hazard_enabled = vm_.HazardEnabled();
+    back.program_ended = vm_.ProgramEnded();
+
+    back.gpr = vm_.GetGprValues();
+    back.fpr = vm_.GetFprValues();
+    back.stats = vm_.GetStats();
+    back.cache_stats = vm_.GetCacheStats();
+    back.profile = vm_.GetProfile().Counters();
+
+    back.instruction_pcs = vm_.GetInstructionPCs();
+    const PipelineSnapshot& pipeline = vm_.GetPipelineSnapshot();
+    if (back.pipeline.Generation()!=pipeline.Generation()) {
+        back.pipeline = pipeline;
+    }
+
+    back.program = program_;
+    back.loads = loads_;
+    back.load_failed = load_failed_;
+
+    back.memory_start = memory_start_;
+    back.memory.resize(memory_rows_);
+    for (size_t i = 0; i < back.memory.size(); i++) {
+        // rows of the window past the end of memory show as 0
+        try {
+            back.memory[i] = vm_.ReadMemDoubleWord(back.memory_start + i*8);
+        } catch (const std::out_of_range&) {
+            back.memory[i] = 0;
+        }
+    }
+
+    SimState& sim_state = vm_.GetSimState();
+    back.sim_state = sim_state;
+    sim_state.LIT_UP = false;
+    sim_state.DATA_FORWARD = false;
+    sim_state.HAZARD_DETECTED = false;
+
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        const SimSnapshot& shown = snapshots_[front_];
+
+        // events the GUI has not drawn yet carry over
+        back.sim_state.LIT_UP |= shown.sim_state.LIT_UP;
+        back.sim_state.DATA_FORWARD |= shown.sim_state.DATA_FORWARD;
+        back.sim_state.HAZARD_DETECTED |= shown.sim_state.HAZARD_DETECTED;
+
+        back.version = shown.version + 1;
+        front_ = 1 - front_;
+    }
+    last_publish_ = std::chrono::steady_clock::now();
+}
+
+} // namespace sim_worker
@@ -0,0 +1,243 @@
+/**
+ * @file sweep.cpp
+ * @brief Contains the implementation of the configuration sweep.
+ */
+
+#include "vm/sweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+namespace sweep {
+
+namespace {
+
+bool IsOutOfOrder(const std::string& model) {
+    return model == "dual" || model == "triple";
+}
+
+void ApplyModel(vm_config::VmConfig& config, const std::string& model) {
+    config.dual_issue = model == "dual";
+    config.triple_issue = model == "triple";
+    config.pipelining_enabled = model.rfind("pipelined", 0) == 0;
+    config.hazard_detection_enabled = model == "pipelined-hazard" || model == "pipelined-forwarding";
+    config.data_forwarding_enabled = model == "pipelined-forwarding";
+
+    if (model != "single" && model != "pipelined" && !config.hazard_detection_enabled && !IsOutOfOrder(model)) {
+        throw std::invalid_argument("Unknown model: " + model);
+    }
+}
+
+void ApplyBranchPrediction(vm_config::VmConfig& config, const std::string& branch_prediction) {
+    config.branch_prediction_enabled = branch_prediction != "none";
+    config.branch_prediction_static = branch_prediction == "static";
+    if (branch_prediction != "none" && branch_prediction != "static") {
+        config.modifyConfig("BranchPrediction", "branch_prediction_type", branch_prediction);
+    }
+}
+
+// the name of the predictor base runs with, as a branch_predictions axis would give it
+std::string BranchPredictionName(const vm_config::VmConfig& base) {
+    if (!base.branch_prediction_enabled) {
+        return "none";
+    }
+    if (base.branch_prediction_static) {
+        return "static";
+    }
+    switch (base.branch_predictor_config.type) {
+        case branch_predictor::PredictorType::Static: return "static";
+        case branch_predictor::PredictorType::Bimodal: return "bimodal";
+        case branch_predictor::PredictorType::Gshare: return "gshare";
+        case branch_predictor::PredictorType::Tournament: return "tournament";
+    }
+    return "none";
+}
+
+// an output longer than this is taken for a program that went wrong
+constexpr uint64_t kMaxOutputBytes = uint64_t{1} << 28;
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t Fnv1a(uint64_t hash, uint64_t value, size_t num_bytes = 8) {
+    for (size_t i = 0; i < num_bytes; i++) {
+        hash = (hash ^ ((value >> (8*i)) & 0xff))*kFnvPrime;
+    }
+    return hash;
+}
+
+uint64_t RegisterChecksum(VM& vm) {
+    uint64_t hash = kFnvOffset;
+    for (uint64_t value : vm.GetGprValues()) {
+        hash = Fnv1a(hash, value);
+    }
+    for (uint64_t value : vm.GetFprValues()) {
+        hash = Fnv1a(hash, value);
+    }
+    return hash;
+}
+
+uint64_t OutputChecksum(VM& vm, uint64_t output) {
+    uint64_t address = vm.ReadMemDoubleWord(output);
+    uint64_t length = std::min(vm.ReadMemDoubleWord(output + 8), kMaxOutputBytes);
+    uint64_t hash = kFnvOffset;
+    for (uint64_t offset = 0; offset < length; offset += 8) {
+        hash = Fnv1a(hash, vm.ReadMemDoubleWord(address + offset), std::min<uint64_t>(8, length - offset));
+    }
+    return hash;
+}
+
+// the jobs run at the same time, each one gets a trace file of its own
+vm_config::VmConfig JobConfig(const ConfigPoint& point, size_t job) {
+    vm_config::VmConfig config = point.config;
+    if (config.trace_config.enabled) {
+        std::filesystem::path file = config.trace_config.File();
+        file.replace_filename(file.stem().string() + "_" + std::to_string(job) + file.extension().string());
+        config.trace_config.file = file;
+    }
+    return config;
+}
+
+JobResult RunJob(const Workload& workload, const ConfigPoint& point, size_t job) {
+    JobResult result;
+    // a stream without a buffer swallows everything, the jobs would only garble each other's messages
+    std::ostream null_log(nullptr);
+    try {
+        const vm_config::VmConfig config = JobConfig(point, job);
+        VM vm(config);
+        vm.SetLog(null_log);
+        vm.LoadVM(workload.program, config);
+        vm.Run();
+        result.stats = vm.GetStats();
+        result.cache_stats = vm.GetCacheStats();
+        result.ended = vm.ProgramEnded();
+        result.reg_checksum = RegisterChecksum(vm);
+        result.mem_checksum = workload.output != 0 ? OutputChecksum(vm, workload.output) : 0;
+        result.host_seconds = static_cast<double>(vm.GetHostProfile().RunNs()) / 1e9;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace
+
+
+std::vector<ConfigPoint> ConfigGrid::Expand(const vm_config::VmConfig& base) const {
+    std::vector<ConfigPoint> points;
+
+    // an axis that wasn't given is the single value of base, and isn't applied
+    const std::vector<std::string> base_branch_predictions = {BranchPredictionName(base)};
+    const std::vector<size_t> base_rs_sizes = {base.getReservationStationSize()};
+    const std::vector<size_t> base_rob_sizes = {base.getRobSize(0)};
+    const std::vector<size_t> base_cdb_widths = {base.getCdbWidth()};
+
+    for (const std::string& model : models) {
+        for (const std::string& branch_prediction :
+             branch_predictions.empty() ? base_branch_predictions : branch_predictions) {
+            ConfigPoint point;
+            point.model = model;
+            point.branch_prediction = branch_prediction;
+            point.config = base;
+            ApplyModel(point.config, model);
+            if (!branch_predictions.empty()) {
+                ApplyBranchPrediction(point.config, branch_prediction);
+            }
+
+            if (!IsOutOfOrder(model)) {
+                points.push_back(point);
+                continue;
+            }
+
+            for (size_t rs_size : reservation_station_sizes.empty() ? base_rs_sizes : reservation_station_sizes) {
+                for (size_t rob_size : rob_sizes.empty() ? base_rob_sizes : rob_sizes) {
+                    for (size_t cdb_width : cdb_widths.empty() ? base_cdb_widths : cdb_widths) {
+                        ConfigPoint window_point = point;
+                        window_point.reservation_station_size = rs_size;
+                        window_point.rob_size = rob_size;
+                        window_point.cdb_width = cdb_width;
+                        window_point.config.setReservationStationSize(rs_size);
+                        window_point.config.setRobSize(rob_size);
+                        window_point.config.setCdbWidth(cdb_width);
+                        points.push_back(window_point);
+                    }
+                }
+            }
+        }
+    }
+    return points;
+}
+
+
+std::vector<JobResult> Run(const std::vector<Workload>& workloads, const std::vector<ConfigPoint>& points,
+                           unsigned int num_threads) {
+    const size_t num_jobs = workloads.size()*points.size();
+    std::vector<JobResult> results(num_jobs);
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = static_cast<unsigned int>(std::min<size_t>(num_threads, num_jobs));
+
+    // jobs are handed out one at a time, their run times differ by orders of magnitude across a grid
+    std::atomic<size_t> next_job{0};
+    auto worker = [&]() {
+        for (size_t job = next_job++; job < num_jobs; job = next_job++) {
+            results[job] = RunJob(workloads[job/points.size()], points[job%points.size()], job);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (unsigned int i = 0; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+
+void WriteCsv(std::ostream& os, const std::vector<Workload>& workloads, const std::vector<ConfigPoint>& points,
+              const std::vector<JobResult>& results) {
+    os << "workload,model,branch_prediction,reservation_station_size,rob_size,cdb_width,"
+       << "cycles,instrs_retired,cpi,ipc,branch_instrs,branch_mispredicts,"
+       << "mispredicts_unpredicted,mispredicts_static,mispredicts_bimodal,mispredicts_gshare,mispredicts_btb,"
+       << "mispredicts_ras,slots_retiring,slots_frontend_bound,slots_bad_speculation,slots_backend_bound,"
+       << "icache_accesses,icache_misses,dcache_accesses,dcache_misses,error\n";
+
+    for (size_t job = 0; job < results.size(); job++) {
+        const Workload& workload = workloads[job/points.size()];
+        const ConfigPoint& point = points[job%points.size()];
+        const JobResult& result = results[job];
+        const VmBase::Stats& stats = result.stats;
+
+        double cpi = stats.instrs_retired ? static_cast<double>(stats.cycles) / stats.instrs_retired : 0.0;
+        double ipc = stats.cycles ? static_cast<double>(stats.instrs_retired) / stats.cycles : 0.0;
+
+        // errors are exception messages, keep them from breaking the row
+        std::string error = result.error;
+        std::replace(error.begin(), error.end(), ',', ';');
+        std::replace(error.begin(), error.end(), '\n', ' ');
+
+        os << workload.name << ',' << point.model << ',' << point.branch_prediction << ','
+           << point.reservation_station_size << ',' << point.rob_size << ',' << point.cdb_width << ','
+           << stats.cycles << ',' << stats.instrs_retired << ',' << cpi << ',' << ipc << ','
+           << stats.branch_instrs << ',' << stats.branch_mispredicts << ','
+           << stats.mispredicts.unpredicted << ',' << stats.mispredicts.static_rule << ','
+           << stats.mispredicts.bimodal << ',' << stats.mispredicts.gshare << ','
+           << stats.mispredicts.btb << ',' << stats.mispredicts.ras << ','
+           << stats.top_down.retiring << ',' << stats.top_down.frontend_bound << ','
+           << stats.top_down.bad_speculation << ',' << stats.top_down.backend_bound << ','
+           << result.cache_stats.first.accesses << ',' << result.cache_stats.first.misses << ','
+           << result.cache_stats.second.accesses << ',' << result.cache_stats.second.misses << ','
+           << error << '\n';
+    }
+}
+
+} // namespace sweep
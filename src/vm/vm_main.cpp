@@ -1,20 +1,18 @@
 #include "vm/vm_main.h"
 #include "vm/rv5s/pipelined/vm.h"
 #include "vm/rv5s/single_cycle/vm.h"
-#include "vm/triple_issue/vm.h"
-#include "vm/dual_issue/vm.h"
+#include "vm/ooo/vm.h"
 #include "vm_asm_mw.h"
-#include "sim_state.h"
+#include "globals.h"
 
-VM::VM(){
-    if(vm_config::config.pipelining_enabled){
-        vm_ = std::make_unique<rv5s::PipelinedVM>();
-        type_ = VM::Which::Pipelined;
-    }
-    else{
-        vm_ = std::make_unique<rv5s::SingleCycleVM>();
-        type_ = VM::Which::SingleCycle;
-    }
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+VM::VM() : VM(vm_config::config) {}
+
+VM::VM(const vm_config::VmConfig& config){
+    LoadVM(config);
 }
 
 
@@ -23,27 +21,37 @@ void VM::Reset(){
 }
 
 void VM::LoadVM(){
-    if(vm_config::config.getDualIssueStatus()){
+    LoadVM(vm_config::config);
+}
+
+void VM::LoadVM(const vm_config::VmConfig& config){
+    if(config.dual_issue){
         type_ = VM::Which::DualIssue;
-        vm_ = std::make_unique<dual_issue::DualIssueVM>();
+        vm_ = std::make_unique<ooo::OooVM>(ooo::OooCore::kDualIssue, config);
     }
-    else if(vm_config::config.getTripleIssueStatus()){
+    else if(config.triple_issue){
         type_ = VM::Which::TripleIssue;
-        vm_ = std::make_unique<triple_issue::TripleIssueVM>();
+        vm_ = std::make_unique<ooo::OooVM>(ooo::OooCore::kTripleIssue, config);
     }
     else{
-        if(vm_config::config.pipelining_enabled){
+        if(config.pipelining_enabled){
             type_ = VM::Which::Pipelined;
-            vm_ = std::make_unique<rv5s::PipelinedVM>();
+            vm_ = std::make_unique<rv5s::PipelinedVM>(config);
         }
         else{
             type_ = VM::Which::SingleCycle;
-            vm_ = std::make_unique<rv5s::SingleCycleVM>();
+            vm_ = std::make_unique<rv5s::SingleCycleVM>(config);
         }
     }
+    vm_->SetLog(*log_);
 }
+
 void VM::LoadVM(AssembledProgram program){
-    LoadVM();
+    LoadVM(std::move(program), vm_config::config);
+}
+
+void VM::LoadVM(AssembledProgram program, const vm_config::VmConfig& config){
+    LoadVM(config);
     program_ = program;
     vm_->LoadVM(program);
 }
@@ -52,11 +60,26 @@ void VM::Run(){
     vm_->Run();
 }
 void VM::DebugRun(){
+    // the models drop their breakpoints on load and reset
+    vm_->SetBreakpoints(breakpoints_);
     vm_->DebugRun();
 }
 
+void VM::SetDebugStepHook(VmBase::DebugStepHook hook){
+    vm_->SetDebugStepHook(std::move(hook));
+}
+
+void VM::AddBreakpoint(uint64_t pc){
+    if(std::find(breakpoints_.begin(), breakpoints_.end(), pc)==breakpoints_.end())
+        breakpoints_.push_back(pc);
+}
+
+void VM::RemoveBreakpoint(uint64_t pc){
+    breakpoints_.erase(std::remove(breakpoints_.begin(), breakpoints_.end(), pc), breakpoints_.end());
+}
+
 void VM::Step(){
-    SimState_.LIT_UP = true;
+    vm_->GetSimState().LIT_UP = true;
     vm_->Step();
 }
 
@@ -64,6 +87,22 @@ void VM::Undo(){
     vm_->Undo();
 }
 
+void VM::RequestStop(){
+    vm_->RequestStop();
+}
+
+void VM::ClearStop(){
+    vm_->ClearStop();
+}
+
+bool VM::ProgramEnded(){
+    return vm_->ProgramEnded();
+}
+
+uint64_t VM::FastForward(uint64_t num_instrs){
+    return vm_->FastForward(num_instrs);
+}
+
 uint64_t VM::ReadMemDoubleWord(uint64_t address){
     return vm_->ReadMemDoubleWord(address);
 }
@@ -80,8 +119,8 @@ std::vector<uint64_t> VM::GetInstructionPCs(){
     return vm_->GetInstructionPCs();
 }
 
-VmBase::InstrView VM::GetInstructions(){
-    return vm_->GetInstructions();
+const PipelineSnapshot& VM::GetPipelineSnapshot(){
+    return vm_->GetPipelineSnapshot();
 }
 
 bool VM::PipeliningEnabled(){
@@ -120,4 +159,40 @@ VM::Which VM::GetType(){
 
 VmBase::Stats& VM::GetStats(){
     return vm_->GetStats();
+}
+
+std::pair<cache::CacheStats, cache::CacheStats> VM::GetCacheStats(){
+    return vm_->GetCacheStats();
+}
+
+void VM::DumpCache(){
+    vm_->DumpCache();
+}
+
+const pc_profile::PcProfile& VM::GetProfile(){
+    return vm_->GetProfile();
+}
+
+const host_profile::HostProfile& VM::GetHostProfile(){
+    return vm_->GetHostProfile();
+}
+
+void VM::DumpProfile(){
+    std::ofstream file(globals::profile_dump_file_path);
+    if(!file.is_open()){
+        throw std::runtime_error("Unable to open profile dump file: " + globals::profile_dump_file_path.string());
+    }
+    pc_profile::DumpJson(file, vm_->GetProfile().Counters(), program_, vm_->GetStats().cycles);
+    file.close();
+
+    *log_ << "VM_PROFILE_DUMPED" << std::endl;
+}
+
+void VM::SetLog(std::ostream& log){
+    log_ = &log;
+    vm_->SetLog(log);
+}
+
+SimState& VM::GetSimState(){
+    return vm_->GetSimState();
 }
\ No newline at end of file
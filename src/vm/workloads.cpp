@@ -0,0 +1,119 @@
+/**
+ * @file workloads.cpp
+ * @brief Contains the implementation of the guest workload suite.
+ */
+
+#include "vm/workloads.h"
+#include "assembler/assembler.h"
+#include "globals.h"
+
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace workloads {
+
+namespace {
+
+// the first .dword of .data, the output pair follows it
+constexpr uint64_t kOutputOffset = 8;
+
+const std::regex kSizeLine(R"(^(size:\s*\.dword\s+)(\d+))", std::regex::multiline);
+
+std::vector<std::string> SplitRow(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+} // namespace
+
+
+Kernel LoadKernel(const std::filesystem::path& path, uint64_t size) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open kernel: " + path.string());
+    }
+    std::stringstream source;
+    source << file.rdbuf();
+    std::string text = source.str();
+
+    std::smatch match;
+    if (!std::regex_search(text, match, kSizeLine)) {
+        throw std::runtime_error("No size line in kernel: " + path.string());
+    }
+
+    Kernel kernel;
+    kernel.workload.name = path.stem().string();
+    kernel.size = std::stoull(match[2].str());
+
+    std::filesystem::path assembled = path;
+    if (size != 0 && size != kernel.size) {
+        kernel.size = size;
+        text = match.prefix().str() + match[1].str() + std::to_string(size) + match.suffix().str();
+        assembled = globals::vm_state_directory / (kernel.workload.name + "_" + std::to_string(size) + ".s");
+        std::ofstream copy(assembled);
+        if (!copy.is_open()) {
+            throw std::runtime_error("Unable to write kernel: " + assembled.string());
+        }
+        copy << text;
+    }
+
+    kernel.workload.program = assemble(assembled.string());
+    kernel.workload.output = vm_config::config.getDataSectionStart() + kOutputOffset;
+    return kernel;
+}
+
+
+Baselines ReadBaselines(std::istream& is) {
+    Baselines baselines;
+    std::string line;
+    std::getline(is, line); // header
+
+    for (size_t line_number = 2; std::getline(is, line); line_number++) {
+        if (line.empty()) {
+            continue;
+        }
+        std::vector<std::string> fields = SplitRow(line);
+        if (fields.size() != 10) {
+            throw std::runtime_error("Malformed baseline on line " + std::to_string(line_number) + ": " + line);
+        }
+        try {
+            Baseline baseline;
+            baseline.cycles = std::stoull(fields[4]);
+            baseline.instrs_retired = std::stoull(fields[5]);
+            baseline.reg_checksum = std::stoull(fields[8], nullptr, 16);
+            baseline.mem_checksum = std::stoull(fields[9], nullptr, 16);
+            baselines[{fields[0], std::stoull(fields[1]), fields[2], fields[3]}] = baseline;
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Malformed baseline on line " + std::to_string(line_number) + ": " + line);
+        }
+    }
+    return baselines;
+}
+
+
+void WriteBaselines(std::ostream& os, const Baselines& baselines) {
+    os << "kernel,size,model,config,cycles,instrs_retired,cpi,ipc,reg_checksum,mem_checksum\n";
+    for (const auto& [key, baseline] : baselines) {
+        const auto& [kernel, size, model, config] = key;
+        double cpi = baseline.instrs_retired ? static_cast<double>(baseline.cycles) / baseline.instrs_retired : 0.0;
+        double ipc = baseline.cycles ? static_cast<double>(baseline.instrs_retired) / baseline.cycles : 0.0;
+
+        std::ostringstream row;
+        row << kernel << ',' << size << ',' << model << ',' << config << ',' << baseline.cycles << ',' << baseline.instrs_retired << ','
+            << std::fixed << std::setprecision(4) << cpi << ',' << ipc << ','
+            << std::hex << std::setfill('0') << "0x" << std::setw(16) << baseline.reg_checksum << ','
+            << "0x" << std::setw(16) << baseline.mem_checksum << '\n';
+        os << row.str();
+    }
+}
+
+} // namespace workloads
@@ -0,0 +1,60 @@
+# CRC-32 (the zlib one) of n bytes from an LCG, bit by bit: a data dependent branch per bit.
+# Output: the CRC, then the bytes.
+
+.data
+size:   .dword 1024     # n, vm_workloads --size crc32=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the result and the bytes are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    la   s2, heap           # CRC
+    addi s3, s2, 8          # bytes
+    add  s4, s3, s1         # end of the bytes
+    addi t0, s1, 8
+    sd   s2, 8(s0)
+    sd   t0, 16(s0)
+
+    # s = (s*1103515245 + 12345) mod 2^31, the byte is bits 16..23
+    li   s5, 99
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    addi t1, s3, 0
+fill:
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    srli t2, s5, 16
+    sb   t2, 0(t1)
+    addi t1, t1, 1
+    bltu t1, s4, fill
+
+    li   s6, 1994146192     # the reflected polynomial 0xedb88320, shifts only go up to 31 here
+    slli s6, s6, 1
+    li   s7, 2147483647
+    slli s7, s7, 1
+    ori  s7, s7, 1          # 0xffffffff
+    addi a0, s7, 0
+    addi a1, s3, 0
+byte:
+    lbu  t1, 0(a1)
+    xor  a0, a0, t1
+    addi a2, x0, 8
+bit:
+    andi t1, a0, 1
+    srli a0, a0, 1
+    beq  t1, x0, next_bit
+    xor  a0, a0, s6
+next_bit:
+    addi a2, a2, -1
+    bne  a2, x0, bit
+    addi a1, a1, 1
+    bltu a1, s4, byte
+
+    xor  a0, a0, s7
+    sd   a0, 0(s2)
+
+done:
+    nop
@@ -0,0 +1,70 @@
+# Double precision matrix multiply: C = A * B, n x n matrices of doubles, integers in 0..9 from an LCG, so the
+# result is exact. A multiply and an add rather than fmadd.d, the models don't execute the fused ops yet.
+# Output: C, row major.
+
+.data
+size:   .dword 16       # n, vm_workloads --size dgemm=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the matrices are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    mul  t0, s1, s1
+    slli t0, t0, 3          # bytes per matrix
+    la   s2, heap           # A
+    add  s3, s2, t0         # B
+    add  s4, s3, t0         # C
+    sd   s4, 8(s0)
+    sd   t0, 16(s0)
+
+    # A and B in one go, s = (s*1103515245 + 12345) mod 2^31
+    li   s5, 3
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    li   t6, 10
+    addi t1, s2, 0
+fill:
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    remu t2, s5, t6
+    fcvt.d.l ft0, t2
+    fsd  ft0, 0(t1)
+    addi t1, t1, 8
+    bltu t1, s4, fill
+
+    slli s6, s1, 3          # row stride
+    addi a1, x0, 0          # i
+row:
+    addi a2, x0, 0          # j
+col:
+    mul  a5, a1, s6
+    add  a5, a5, s2         # &A[i][0]
+    slli a6, a2, 3
+    add  a6, a6, s3         # &B[0][j]
+    addi a3, x0, 0          # k
+    fcvt.d.l fa0, x0        # sum
+dot:
+    fld  ft0, 0(a5)
+    fld  ft1, 0(a6)
+    fmul.d  ft0, ft0, ft1
+    fadd.d  fa0, fa0, ft0
+    addi a5, a5, 8
+    add  a6, a6, s6
+    addi a3, a3, 1
+    blt  a3, s1, dot
+
+    mul  t1, a1, s1
+    add  t1, t1, a2
+    slli t1, t1, 3
+    add  t1, t1, s4
+    fsd  fa0, 0(t1)         # C[i][j]
+    addi a2, a2, 1
+    blt  a2, s1, col
+    addi a1, a1, 1
+    blt  a1, s1, row
+
+done:
+    nop
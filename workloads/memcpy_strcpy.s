@@ -0,0 +1,82 @@
+# memcpy and strcpy of an n byte string (n - 1 non zero bytes from an LCG and the terminator): the memcpy moves
+# double words with a byte tail, the strcpy goes byte by byte until the zero.
+# Output: the source, the memcpy copy and the strcpy copy, each in a slot of n rounded up past a multiple of 8.
+
+.data
+size:   .dword 4096     # n, vm_workloads --size memcpy_strcpy=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the three slots are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    addi s6, s1, 8
+    andi s6, s6, -8         # slot size
+    la   s2, heap           # source
+    add  s3, s2, s6         # memcpy copy
+    add  s4, s3, s6         # strcpy copy
+    add  t0, s6, s6
+    add  t0, t0, s6
+    sd   s2, 8(s0)
+    sd   t0, 16(s0)
+
+    # s = (s*1103515245 + 12345) mod 2^31, bytes 1..255
+    li   s5, 5
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    li   t6, 255
+    addi t1, s2, 0
+    add  t0, s2, s1
+    addi t0, t0, -1         # the terminator
+fill:
+    bgeu t1, t0, terminate
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    remu t2, s5, t6
+    addi t2, t2, 1
+    sb   t2, 0(t1)
+    addi t1, t1, 1
+    jal  x0, fill
+terminate:
+    sb   x0, 0(t1)
+
+    # memcpy(s3, s2, n)
+    addi a0, s3, 0
+    addi a1, s2, 0
+    srli a2, s1, 3
+    beq  a2, x0, copy_tail
+copy_words:
+    ld   t1, 0(a1)
+    sd   t1, 0(a0)
+    addi a0, a0, 8
+    addi a1, a1, 8
+    addi a2, a2, -1
+    bne  a2, x0, copy_words
+copy_tail:
+    andi a2, s1, 7
+    beq  a2, x0, strcpy
+copy_bytes:
+    lbu  t1, 0(a1)
+    sb   t1, 0(a0)
+    addi a0, a0, 1
+    addi a1, a1, 1
+    addi a2, a2, -1
+    bne  a2, x0, copy_bytes
+
+    # strcpy(s4, s2), a0 ends up the length
+strcpy:
+    addi a1, s2, 0
+    addi a2, s4, 0
+copy_char:
+    lbu  t1, 0(a1)
+    sb   t1, 0(a2)
+    addi a1, a1, 1
+    addi a2, a2, 1
+    bne  t1, x0, copy_char
+    sub  a0, a2, s4
+    addi a0, a0, -1
+
+done:
+    nop
@@ -0,0 +1,84 @@
+# Pointer chasing: n nodes 64 bytes apart linked into one random cycle (Sattolo's shuffle), walked 4n times. Each
+# load depends on the one before, so this is all load latency.
+# Output: the sum of the node numbers visited, the node the walk ended on, and the permutation.
+
+.data
+size:   .dword 2048     # n, vm_workloads --size pointer_chase=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the result, the permutation and the nodes are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    slli t0, s1, 3
+    la   s2, heap           # sum, last node
+    addi s3, s2, 16         # permutation
+    add  s4, s3, t0         # nodes
+    addi t1, t0, 16
+    sd   s2, 8(s0)
+    sd   t1, 16(s0)
+
+    addi t1, x0, 0
+    addi t2, s3, 0
+iota:
+    sd   t1, 0(t2)
+    addi t1, t1, 1
+    addi t2, t2, 8
+    blt  t1, s1, iota
+
+    # swap every element with one below it, s = (s*1103515245 + 12345) mod 2^31
+    li   s5, 2024
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    addi a1, s1, -1
+shuffle:
+    bge  x0, a1, link
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    remu a2, s5, a1
+    slli a3, a1, 3
+    add  a3, a3, s3
+    slli a4, a2, 3
+    add  a4, a4, s3
+    ld   a5, 0(a3)
+    ld   a6, 0(a4)
+    sd   a6, 0(a3)
+    sd   a5, 0(a4)
+    addi a1, a1, -1
+    jal  x0, shuffle
+
+    # node i: the address of node perm[i], then i
+link:
+    addi a1, x0, 0
+    addi a3, s3, 0
+    addi a4, s4, 0
+link_node:
+    ld   a5, 0(a3)
+    slli a5, a5, 6
+    add  a5, a5, s4
+    sd   a5, 0(a4)
+    sd   a1, 8(a4)
+    addi a1, a1, 1
+    addi a3, a3, 8
+    addi a4, a4, 64
+    blt  a1, s1, link_node
+
+    slli a1, s1, 2          # steps
+    addi a4, s4, 0
+    addi a6, x0, 0
+chase:
+    ld   t1, 8(a4)
+    add  a6, a6, t1
+    ld   a4, 0(a4)
+    addi a1, a1, -1
+    bne  a1, x0, chase
+
+    sd   a6, 0(s2)
+    sub  t1, a4, s4
+    srli t1, t1, 6
+    sd   t1, 8(s2)
+
+done:
+    nop
@@ -0,0 +1,78 @@
+# Recursive quicksort (Lomuto partition) of n 64 bit integers from an LCG, exercises calls, returns and the stack.
+# Output: the sorted array.
+
+.data
+size:   .dword 1024     # n, vm_workloads --size quicksort=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the array is carved from here up
+
+.text
+    li   sp, 2147418112     # registers start out zero, the stack goes below 0x7fff0000
+    la   s0, size
+    ld   s1, 0(s0)
+    slli t0, s1, 3
+    la   s2, heap
+    add  s3, s2, t0         # end of the array
+    sd   s2, 8(s0)
+    sd   t0, 16(s0)
+
+    # s = (s*1103515245 + 12345) mod 2^31
+    li   s5, 42
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    addi t1, s2, 0
+fill:
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    sd   s5, 0(t1)
+    addi t1, t1, 8
+    bltu t1, s3, fill
+
+    addi a0, s2, 0
+    addi a1, s3, -8
+    jal  ra, qsort
+    jal  x0, done
+
+# sorts the elements from a0 to a1, both inclusive
+qsort:
+    bgeu a0, a1, qsort_ret  # at most one element
+    addi sp, sp, -32
+    sd   ra, 0(sp)
+    sd   a1, 8(sp)
+
+    ld   t0, 0(a1)          # pivot
+    addi t1, a0, -8         # last element below the pivot
+    addi t2, a0, 0
+partition:
+    ld   t3, 0(t2)
+    bge  t3, t0, keep
+    addi t1, t1, 8
+    ld   t4, 0(t1)
+    sd   t3, 0(t1)
+    sd   t4, 0(t2)
+keep:
+    addi t2, t2, 8
+    bltu t2, a1, partition
+
+    addi t1, t1, 8
+    ld   t4, 0(t1)
+    sd   t0, 0(t1)
+    sd   t4, 0(a1)
+    sd   t1, 16(sp)
+
+    addi a1, t1, -8
+    jal  ra, qsort
+    ld   t1, 16(sp)
+    addi a0, t1, 8
+    ld   a1, 8(sp)
+    jal  ra, qsort
+
+    ld   ra, 0(sp)
+    addi sp, sp, 32
+qsort_ret:
+    ret
+
+done:
+    nop
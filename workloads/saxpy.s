@@ -0,0 +1,53 @@
+# Single precision SAXPY: y = 1.5 * x + y over n floats, x and y integers in 0..999 from an LCG, so the result is exact.
+# A multiply and an add rather than fmadd.s, the models don't execute the fused ops yet.
+# Output: y.
+
+.data
+size:   .dword 4096     # n, vm_workloads --size saxpy=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+alpha:  .float 1.5
+heap:   .dword 0        # x and y are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    slli t0, s1, 2          # bytes per vector
+    la   s2, heap           # x
+    add  s3, s2, t0         # y
+    add  s4, s3, t0         # end of y
+    sd   s3, 8(s0)
+    sd   t0, 16(s0)
+    la   t1, alpha
+    flw  fs0, 0(t1)
+
+    # x and y in one go, s = (s*1103515245 + 12345) mod 2^31
+    li   s5, 7
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    li   t6, 1000
+    addi t1, s2, 0
+fill:
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    remu t2, s5, t6
+    fcvt.s.w ft0, t2
+    fsw  ft0, 0(t1)
+    addi t1, t1, 4
+    bltu t1, s4, fill
+
+    addi a1, s2, 0
+    addi a2, s3, 0
+axpy:
+    flw  ft0, 0(a1)
+    flw  ft1, 0(a2)
+    fmul.s  ft0, fs0, ft0
+    fadd.s  ft1, ft0, ft1
+    fsw  ft1, 0(a2)
+    addi a1, a1, 4
+    addi a2, a2, 4
+    bltu a2, s4, axpy
+
+done:
+    nop
@@ -0,0 +1,102 @@
+# Tokenizer state machine over n characters from an LCG: letters a-f, digits 0-1, spaces and dots. Words start with
+# a letter and may go on with digits, numbers start with a digit, dots are tokens of their own. Both the generator
+# and the scanner are chains of data dependent branches.
+# Output: the counts of words, numbers and dots and the longest word or number, then the text.
+
+.data
+size:   .dword 8192     # n, vm_workloads --size state_machine=<n> overrides it
+out:    .dword 0, 0     # address and length in bytes of the output, set by the kernel
+heap:   .dword 0        # the result and the text are carved from here up
+
+.text
+    la   s0, size
+    ld   s1, 0(s0)
+    la   s2, heap           # words, numbers, dots, longest
+    addi s3, s2, 32         # text
+    add  s4, s3, s1         # end of the text
+    addi t0, s1, 32
+    sd   s2, 8(s0)
+    sd   t0, 16(s0)
+
+    # s = (s*1103515245 + 12345) mod 2^31, the class is s mod 10: 0-5 a letter, 6-7 a digit, 8 a space, 9 a dot
+    li   s5, 31337
+    li   t3, 1103515245
+    li   t4, 12345
+    li   t5, 2147483647
+    li   t6, 10
+    addi s6, x0, 6
+    addi s7, x0, 8
+    addi s8, x0, 9
+    addi t1, s3, 0
+fill:
+    mul  s5, s5, t3
+    add  s5, s5, t4
+    and  s5, s5, t5
+    remu t2, s5, t6
+    blt  t2, s6, letter_char
+    blt  t2, s7, digit_char
+    beq  t2, s8, dot_char
+    addi t2, x0, 32
+    jal  x0, put
+dot_char:
+    addi t2, x0, 46
+    jal  x0, put
+digit_char:
+    addi t2, t2, 42         # '0' - 6
+    jal  x0, put
+letter_char:
+    addi t2, t2, 97
+put:
+    sb   t2, 0(t1)
+    addi t1, t1, 1
+    bltu t1, s4, fill
+
+    # state a4: 0 between tokens, 1 in a word, 2 in a number. a7 the length of the token, a6 the longest
+    addi s6, x0, 97
+    addi s7, x0, 48
+    addi s8, x0, 32
+    addi s9, x0, 1
+    addi a1, s3, 0
+    addi a2, x0, 0
+    addi a3, x0, 0
+    addi a5, x0, 0
+    addi a4, x0, 0
+    addi a6, x0, 0
+    addi a7, x0, 0
+scan:
+    lbu  t1, 0(a1)
+    bgeu t1, s6, letter
+    bgeu t1, s7, digit
+    beq  t1, s8, space
+    addi a5, a5, 1
+    addi a4, x0, 0
+    jal  x0, next
+letter:
+    beq  a4, s9, grow
+    addi a2, a2, 1
+    addi a4, x0, 1
+    addi a7, x0, 0
+    jal  x0, grow
+digit:
+    bne  a4, x0, grow
+    addi a3, a3, 1
+    addi a4, x0, 2
+    addi a7, x0, 0
+grow:
+    addi a7, a7, 1
+    bge  a6, a7, next
+    addi a6, a7, 0
+    jal  x0, next
+space:
+    addi a4, x0, 0
+next:
+    addi a1, a1, 1
+    bltu a1, s4, scan
+
+    sd   a2, 0(s2)
+    sd   a3, 8(s2)
+    sd   a5, 16(s2)
+    sd   a6, 24(s2)
+
+done:
+    nop